@@ -34,17 +34,29 @@
 # The following variable is set
 #
 # AESNI_FOUND - TRUE if AES-NI is found and work correctly
+# VAES_FOUND - TRUE if VAES (AES-NI on 256- and 512-bit vectors) is found and
+# work correctly with the current compiler flags
 
-IF(DEFINED AESNI_FOUND)
-    RETURN()
-ENDIF(DEFINED AESNI_FOUND)
+INCLUDE(CheckCXXSourceRuns)
 
-FILE(READ ${CMAKE_CURRENT_LIST_DIR}/FindAESNI.cpp AESNI_TEST_SOURCE)
+IF(NOT DEFINED AESNI_FOUND)
+    FILE(READ ${CMAKE_CURRENT_LIST_DIR}/FindAESNI.cpp AESNI_TEST_SOURCE)
+    CHECK_CXX_SOURCE_RUNS("${AESNI_TEST_SOURCE}" AESNI_FOUND)
+    IF(AESNI_FOUND)
+        MESSAGE(STATUS "Found AES-NI support")
+    ELSE(AESNI_FOUND)
+        MESSAGE(STATUS "NOT Found AES-NI support")
+    ENDIF(AESNI_FOUND)
+ENDIF(NOT DEFINED AESNI_FOUND)
 
-INCLUDE(CheckCXXSourceRuns)
-CHECK_CXX_SOURCE_RUNS("${AESNI_TEST_SOURCE}" AESNI_FOUND)
-IF(AESNI_FOUND)
-    MESSAGE(STATUS "Found AES-NI support")
-ELSE(AESNI_FOUND)
-    MESSAGE(STATUS "NOT Found AES-NI support")
-ENDIF(AESNI_FOUND)
+IF(NOT DEFINED VAES_FOUND)
+    IF(AESNI_FOUND)
+        FILE(READ ${CMAKE_CURRENT_LIST_DIR}/FindVAES.cpp VAES_TEST_SOURCE)
+        CHECK_CXX_SOURCE_RUNS("${VAES_TEST_SOURCE}" VAES_FOUND)
+    ENDIF(AESNI_FOUND)
+    IF(VAES_FOUND)
+        MESSAGE(STATUS "Found VAES support")
+    ELSE(VAES_FOUND)
+        MESSAGE(STATUS "NOT Found VAES support")
+    ENDIF(VAES_FOUND)
+ENDIF(NOT DEFINED VAES_FOUND)
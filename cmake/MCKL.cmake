@@ -231,6 +231,16 @@ ELSE(AESNI_FOUND)
     SET(AESNI_FOUND FALSE CACHE BOOL "NOT Found AES-NI")
 ENDIF(AESNI_FOUND)
 
+# VAES
+IF(VAES_FOUND)
+    SET(FEATURES ${FEATURES} "VAES")
+    SET(MCKL_DEFINITIONS ${MCKL_DEFINITIONS} -DMCKL_HAS_VAES=1)
+ELSE(VAES_FOUND)
+    SET(MCKL_DEFINITIONS ${MCKL_DEFINITIONS} -DMCKL_HAS_VAES=0)
+    UNSET(VAES_FOUND CACHE)
+    SET(VAES_FOUND FALSE CACHE BOOL "NOT Found VAES")
+ENDIF(VAES_FOUND)
+
 # RDRAND
 INCLUDE(FindRDRAND)
 IF(RDRAND_FOUND)
@@ -0,0 +1,114 @@
+//============================================================================
+// MCKL/example/core/include/core_draw.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_DRAW_HPP
+#define MCKL_EXAMPLE_CORE_DRAW_HPP
+
+#include <mckl/core/weight.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+// Total variation distance between the weights and the empirical frequencies
+inline double weight_draw_tv(const mckl::Weight &weight,
+    const mckl::Vector<std::size_t> &idx, mckl::Vector<double> &freq)
+{
+    const std::size_t N = weight.size();
+    const double a = 1.0 / idx.size();
+    std::fill(freq.begin(), freq.end(), 0.0);
+    for (std::size_t i = 0; i != idx.size(); ++i)
+        freq[idx[i]] += a;
+    double tv = 0;
+    for (std::size_t i = 0; i != N; ++i)
+        tv += std::abs(freq[i] - weight.data()[i]);
+
+    return 0.5 * tv;
+}
+
+inline void weight_draw(std::size_t N, std::size_t M, int nwid, int twid)
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    normal(rng, N, v.data());
+    mckl::Weight weight(N);
+    weight.set_log(v.data());
+
+    mckl::Vector<std::size_t> idx(M);
+    mckl::Vector<double> freq(N);
+    mckl::StopWatch watch;
+
+    watch.start();
+    for (std::size_t i = 0; i != M; ++i)
+        idx[i] = weight.draw(rng);
+    watch.stop();
+    const double tscan = watch.nanoseconds() / M;
+    const double escan = weight_draw_tv(weight, idx, freq);
+
+    watch.reset();
+    watch.start();
+    weight.draw(rng, M, idx.data());
+    watch.stop();
+    const double talias = watch.nanoseconds() / M;
+    const double ealias = weight_draw_tv(weight, idx, freq);
+
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << tscan;
+    std::cout << std::setw(twid) << std::right << std::fixed << talias;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << tscan / talias;
+    std::cout << std::setw(twid) << std::right << std::fixed << escan;
+    std::cout << std::setw(twid) << std::right << std::fixed << ealias;
+    std::cout << std::endl;
+}
+
+inline void weight_draw(std::size_t N)
+{
+    const std::size_t M = 1000000;
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 5;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Scan (ns)";
+    std::cout << std::setw(twid) << std::right << "Alias (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "TV (Scan)";
+    std::cout << std::setw(twid) << std::right << "TV (Alias)";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    for (std::size_t n = 10; n <= N; n *= 10)
+        weight_draw(n, M, nwid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_DRAW_HPP
@@ -0,0 +1,193 @@
+//============================================================================
+// MCKL/example/core/include/core_monitor.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_MONITOR_HPP
+#define MCKL_EXAMPLE_CORE_MONITOR_HPP
+
+#include <mckl/core/monitor.hpp>
+#include <mckl/core/particle.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/smp.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+using CoreMonitorState = mckl::StateMatrix<mckl::RowMajor, 1, double>;
+
+template <typename Backend>
+class CoreMonitorEval
+    : public mckl::MonitorEvalSMP<CoreMonitorState, CoreMonitorEval<Backend>,
+          Backend>
+{
+    public:
+    void eval_each(std::size_t, std::size_t dim,
+        mckl::ParticleIndex<CoreMonitorState> idx, double *r)
+    {
+        const double x = idx(0);
+        for (std::size_t d = 0; d != dim; ++d)
+            r[d] = x * static_cast<double>(d + 1);
+    }
+}; // class CoreMonitorEval
+
+inline double core_monitor(std::size_t repeat,
+    mckl::Monitor<CoreMonitorState> &monitor,
+    mckl::Particle<CoreMonitorState> &particle)
+{
+    mckl::StopWatch watch;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        watch.start();
+        monitor(r, particle, mckl::MonitorMCMC);
+        watch.stop();
+    }
+
+    return watch.nanoseconds() / (repeat * particle.size());
+}
+
+template <typename Backend>
+inline bool core_monitor(std::size_t N, std::size_t dim, int nwid, int twid,
+    const std::string &name)
+{
+    const std::size_t repeat = std::max(static_cast<std::size_t>(1),
+        static_cast<std::size_t>(10000000) / (N * dim));
+
+    mckl::Particle<CoreMonitorState> particle(N);
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    normal(particle.rng(), N, particle.state().data());
+    normal(particle.rng(), N, v.data());
+    particle.weight().set_log(v.data());
+
+    // The reference writes the values of all particles to a buffer, which is
+    // then multiplied by the weights
+    CoreMonitorEval<Backend> eval;
+    mckl::Monitor<CoreMonitorState> ref(dim,
+        mckl::Monitor<CoreMonitorState>::eval_type(
+            [eval](std::size_t iter, std::size_t d,
+                mckl::Particle<CoreMonitorState> &p, double *r) mutable {
+                eval(iter, d, p, r);
+            }));
+    mckl::Monitor<CoreMonitorState> sum(dim, eval);
+    sum.stream(true);
+
+    // Without streaming, the default is the same buffer as the reference
+    mckl::Monitor<CoreMonitorState> buf(dim, eval);
+    buf(0, particle, mckl::MonitorMCMC);
+
+    const double tref = core_monitor(repeat, ref, particle);
+    const double tnew = core_monitor(repeat, sum, particle);
+
+    bool pass = !buf.stream();
+    for (std::size_t d = 0; d != dim; ++d)
+        pass = pass && buf.record(d) == ref.record(d);
+
+    double err = 0;
+    for (std::size_t d = 0; d != dim; ++d) {
+        err = std::max(err, std::abs(ref.record(d) - sum.record(d)) /
+                (1 + std::abs(ref.record(d))));
+    }
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(nwid) << std::right << N;
+    std::cout << std::setw(nwid) << std::right << dim;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref;
+    std::cout << std::setw(twid) << std::right << std::fixed << tnew;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref / tnew;
+    pass = pass && err < 1e-10;
+
+    std::cout << std::setw(twid) << std::right << std::scientific << err;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+template <typename Backend>
+inline bool core_monitor(std::size_t N, std::size_t D, int nwid, int twid,
+    const std::string &name, bool)
+{
+    bool pass = true;
+    for (std::size_t dim = 1; dim <= D; dim *= 10) {
+        for (std::size_t n = 1000; n <= N && n * dim <= N; n *= 10)
+            pass = core_monitor<Backend>(n, dim, nwid, twid, name) && pass;
+    }
+
+    return pass;
+}
+
+inline bool core_monitor(std::size_t N, std::size_t D)
+{
+    const int nwid = 10;
+    const int twid = 15;
+    const std::size_t lwid = nwid * 3 + twid * 5;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Backend";
+    std::cout << std::setw(nwid) << std::right << "N";
+    std::cout << std::setw(nwid) << std::right << "Dim";
+    std::cout << std::setw(twid) << std::right << "Ref (ns)";
+    std::cout << std::setw(twid) << std::right << "Sum (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Error";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    pass = core_monitor<mckl::BackendSEQ>(N, D, nwid, twid, "SEQ", true) &&
+        pass;
+    pass = core_monitor<mckl::BackendSTD>(N, D, nwid, twid, "STD", true) &&
+        pass;
+#if MCKL_HAS_OMP
+    pass = core_monitor<mckl::BackendOMP>(N, D, nwid, twid, "OMP", true) &&
+        pass;
+#endif
+#if MCKL_HAS_TBB
+    pass = core_monitor<mckl::BackendTBB>(N, D, nwid, twid, "TBB", true) &&
+        pass;
+#endif
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    // A Monitor may be constructed without an evaluation object
+    mckl::Monitor<CoreMonitorState> empty(1, nullptr);
+    const bool null = empty.empty();
+    empty.eval(CoreMonitorEval<mckl::BackendSEQ>());
+    const bool set = !empty.empty();
+    empty.eval(nullptr);
+    const bool reset = empty.empty();
+    const bool nptr = null && set && reset;
+    std::cout << std::setw(nwid) << std::left << "nullptr";
+    std::cout << std::setw(twid) << std::right
+              << (nptr ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass && nptr;
+}
+
+#endif // MCKL_EXAMPLE_CORE_MONITOR_HPP
@@ -0,0 +1,222 @@
+//============================================================================
+// MCKL/example/core/include/core_precision.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MCKL_EXAMPLE_CORE_PRECISION_HPP
+#define MCKL_EXAMPLE_CORE_PRECISION_HPP
+
+#include <mckl/core/monitor.hpp>
+#include <mckl/core/particle.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/resample/algorithm.hpp>
+#include <mckl/smp.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <typename RealType>
+using CorePrecisionBase = mckl::StateMatrix<mckl::RowMajor, 1, RealType>;
+
+// A state with weights of the same precision
+template <typename RealType>
+class CorePrecision : public CorePrecisionBase<RealType>
+{
+    public:
+    using weight_type = mckl::WeightSMP<mckl::BackendSEQ, RealType>;
+
+    explicit CorePrecision(std::size_t N) : CorePrecisionBase<RealType>(N) {}
+}; // class CorePrecision
+
+template <typename RealType>
+class CorePrecisionEval
+    : public mckl::MonitorEvalSMP<CorePrecision<RealType>,
+          CorePrecisionEval<RealType>, mckl::BackendSEQ>
+{
+    public:
+    void eval_each(std::size_t, std::size_t,
+        mckl::ParticleIndex<CorePrecision<RealType>> idx, double *r)
+    {
+        const double x = static_cast<double>(idx(0));
+        r[0] = x;
+        r[1] = x * x;
+    }
+}; // class CorePrecisionEval
+
+// A Monitor evaluation object that writes single precision values
+template <typename RealType>
+class CorePrecisionEvalFloat
+{
+    public:
+    void operator()(std::size_t, std::size_t,
+        mckl::Particle<CorePrecision<RealType>> &particle, float *r)
+    {
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        const RealType *x = particle.state().data();
+        for (std::size_t i = 0; i != N; ++i, r += 2) {
+            const float y = static_cast<float>(x[i]);
+            r[0] = y;
+            r[1] = y * y;
+        }
+    }
+}; // class CorePrecisionEvalFloat
+
+// One step of the pipeline, reweighting, monitoring and resampling. The
+// state and the weights are restored before each step, which is not timed
+template <typename RealType>
+inline double core_precision(std::size_t repeat,
+    mckl::Particle<CorePrecision<RealType>> &particle,
+    const mckl::Vector<double> &x, const mckl::Vector<double> &v)
+{
+    using T = CorePrecision<RealType>;
+
+    const std::size_t N = x.size();
+    mckl::Monitor<T> monitor(2, CorePrecisionEval<RealType>());
+    mckl::ResampleEval<T> resample((mckl::ResampleStratified()));
+    mckl::StopWatch watch;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        std::copy(x.begin(), x.end(), particle.state().data());
+        particle.weight().set_equal();
+        watch.start();
+        particle.weight().add_log(v.data());
+        monitor(r, particle, mckl::MonitorMCMC);
+        resample(r, particle);
+        watch.stop();
+    }
+
+    return watch.nanoseconds() / (repeat * N);
+}
+
+inline void core_precision(std::size_t N, int nwid, int twid)
+{
+    const std::size_t repeat = std::max(static_cast<std::size_t>(1),
+        static_cast<std::size_t>(10000000) / N);
+
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> v(N);
+    normal(rng, N, x.data());
+    normal(rng, N, v.data());
+    for (std::size_t i = 0; i != N; ++i)
+        v[i] *= 3 * x[i];
+
+    mckl::Particle<CorePrecision<double>> pd(N);
+    mckl::Particle<CorePrecision<float>> pf(N);
+    const double td = core_precision(repeat, pd, x, v);
+    const double tf = core_precision(repeat, pf, x, v);
+
+    // Accuracy of the single precision pipeline against the double precision
+    // one, starting from the same state and incremental weights
+    std::copy(x.begin(), x.end(), pd.state().data());
+    std::copy(x.begin(), x.end(), pf.state().data());
+    pd.weight().set_equal();
+    pf.weight().set_equal();
+    pd.weight().add_log(v.data());
+    pf.weight().add_log(v.data());
+
+    const double err_ess =
+        std::abs(pd.weight().ess() - pf.weight().ess()) / pd.weight().ess();
+
+    double err_w = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        const double wd = pd.weight().data()[i];
+        const double wf = static_cast<double>(pf.weight().data()[i]);
+        if (wd > 1e-30)
+            err_w = std::max(err_w, std::abs(wd - wf) / wd);
+    }
+
+    mckl::Monitor<CorePrecision<double>> md(2, CorePrecisionEval<double>());
+    mckl::Monitor<CorePrecision<float>> mf(2, CorePrecisionEval<float>());
+    md(0, pd, mckl::MonitorMCMC);
+    mf(0, pf, mckl::MonitorMCMC);
+    double err_m = 0;
+    for (std::size_t d = 0; d != 2; ++d) {
+        const double rd = md.record(d);
+        const double rf = mf.record(d);
+        err_m = std::max(err_m, std::abs(rd - rf) / (1 + std::abs(rd)));
+    }
+
+    // Single precision values of the double precision pipeline
+    mckl::Monitor<CorePrecision<double>> mv(
+        2, CorePrecisionEvalFloat<double>());
+    mv(0, pd, mckl::MonitorMCMC);
+    double err_v = 0;
+    for (std::size_t d = 0; d != 2; ++d) {
+        const double rd = md.record(d);
+        const double rv = mv.record(d);
+        err_v = std::max(err_v, std::abs(rd - rv) / (1 + std::abs(rd)));
+    }
+
+    // The fraction of particles whose copies are assigned differently
+    mckl::Vector<std::size_t> rd(N);
+    mckl::Vector<std::size_t> rf(N);
+    mckl::RNG rngd;
+    mckl::RNG rngf(rngd);
+    mckl::ResampleStratified()(N, N, rngd, pd.weight().data(), rd.data());
+    mckl::ResampleStratified()(N, N, rngf, pf.weight().data(), rf.data());
+    std::size_t diff = 0;
+    for (std::size_t i = 0; i != N; ++i)
+        diff += rd[i] > rf[i] ? rd[i] - rf[i] : rf[i] - rd[i];
+    const double err_r = static_cast<double>(diff) / (2 * N);
+
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << td;
+    std::cout << std::setw(twid) << std::right << std::fixed << tf;
+    std::cout << std::setw(twid) << std::right << std::fixed << td / tf;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_ess;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_w;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_m;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_v;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_r;
+    std::cout << std::endl;
+}
+
+inline void core_precision(std::size_t N)
+{
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 8;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Double (ns)";
+    std::cout << std::setw(twid) << std::right << "Float (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Error (ESS)";
+    std::cout << std::setw(twid) << std::right << "Error (W)";
+    std::cout << std::setw(twid) << std::right << "Error (Mon)";
+    std::cout << std::setw(twid) << std::right << "Error (Val)";
+    std::cout << std::setw(twid) << std::right << "Error (Rep)";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    for (std::size_t n = 1000; n <= N; n *= 10)
+        core_precision(n, nwid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_PRECISION_HPP
@@ -0,0 +1,157 @@
+//============================================================================
+// MCKL/example/core/include/core_select.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_SELECT_HPP
+#define MCKL_EXAMPLE_CORE_SELECT_HPP
+
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_real_distribution.hpp>
+#include <mckl/resample.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <mckl::MatrixLayout Layout>
+using CoreSelectState = mckl::StateMatrix<Layout, mckl::Dynamic, double>;
+
+// Resample the matrix from replication numbers
+class CoreSelectRef
+{
+    public:
+    template <mckl::MatrixLayout Layout>
+    void operator()(CoreSelectState<Layout> &state, std::size_t N,
+        const std::size_t *rep, mckl::Vector<std::size_t> &idx) const
+    {
+        idx.resize(N);
+        mckl::resample_trans_rep_index(N, N, rep, idx.data());
+        state.select(N, idx.data());
+    }
+}; // class CoreSelectRef
+
+template <typename Backend>
+class CoreSelectRep
+{
+    public:
+    template <mckl::MatrixLayout Layout>
+    void operator()(CoreSelectState<Layout> &state, std::size_t N,
+        const std::size_t *rep, mckl::Vector<std::size_t> &) const
+    {
+        state.template select_rep<Backend>(N, rep);
+    }
+}; // class CoreSelectRep
+
+template <mckl::MatrixLayout Layout, typename SelectType>
+inline double core_select(std::size_t repeat, std::size_t N, std::size_t dim,
+    const mckl::Vector<mckl::Vector<std::size_t>> &rep,
+    CoreSelectState<Layout> &result)
+{
+    SelectType select;
+    CoreSelectState<Layout> state(N, dim);
+    mckl::Vector<std::size_t> idx;
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t j = 0; j != dim; ++j)
+            state(i, j) = static_cast<double>(i * dim + j);
+
+    mckl::StopWatch watch;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        watch.start();
+        select(state, N, rep[r].data(), idx);
+        watch.stop();
+    }
+    result = std::move(state);
+
+    return watch.nanoseconds() / (repeat * N * dim);
+}
+
+template <mckl::MatrixLayout Layout>
+inline void core_select(
+    std::size_t N, std::size_t dim, std::size_t repeat, int nwid, int twid)
+{
+    mckl::RNG rng;
+    mckl::UniformRealDistribution<double> runif(0, 1);
+    mckl::ResampleMultinomial resample;
+    mckl::Vector<double> w(N);
+    mckl::Vector<mckl::Vector<std::size_t>> rep(repeat);
+    for (std::size_t r = 0; r != repeat; ++r) {
+        runif(rng, N, w.data());
+        const double s = std::accumulate(w.begin(), w.end(), 0.0);
+        mckl::mul(N, 1 / s, w.data(), w.data());
+        rep[r].resize(N);
+        resample(N, N, rng, w.data(), rep[r].data());
+    }
+
+    CoreSelectState<Layout> sref;
+    CoreSelectState<Layout> sseq;
+    CoreSelectState<Layout> sstd;
+    const double tref =
+        core_select<Layout, CoreSelectRef>(repeat, N, dim, rep, sref);
+    const double tseq = core_select<Layout, CoreSelectRep<mckl::BackendSEQ>>(
+        repeat, N, dim, rep, sseq);
+    const double tstd = core_select<Layout, CoreSelectRep<mckl::BackendSTD>>(
+        repeat, N, dim, rep, sstd);
+    const bool pass = sref == sseq && sref == sstd;
+
+    std::cout << std::setw(nwid) << std::left
+              << (Layout == mckl::RowMajor ? "RowMajor" : "ColMajor");
+    std::cout << std::setw(nwid) << std::left << dim;
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref;
+    std::cout << std::setw(twid) << std::right << std::fixed << tseq;
+    std::cout << std::setw(twid) << std::right << std::fixed << tstd;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+inline void core_select(std::size_t size)
+{
+    const int nwid = 10;
+    const int twid = 15;
+    const std::size_t lwid = nwid * 3 + twid * 4;
+    const std::size_t repeat = 10;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Layout";
+    std::cout << std::setw(nwid) << std::left << "Dim";
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Ref (ns)";
+    std::cout << std::setw(twid) << std::right << "SEQ (ns)";
+    std::cout << std::setw(twid) << std::right << "STD (ns)";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    for (std::size_t dim : {1, 4, 64, 1024})
+        core_select<mckl::RowMajor>(size / dim, dim, repeat, nwid, twid);
+    for (std::size_t dim : {1, 4, 64, 1024})
+        core_select<mckl::ColMajor>(size / dim, dim, repeat, nwid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_SELECT_HPP
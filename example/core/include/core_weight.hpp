@@ -0,0 +1,254 @@
+//============================================================================
+// MCKL/example/core/include/core_weight.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_WEIGHT_HPP
+#define MCKL_EXAMPLE_CORE_WEIGHT_HPP
+
+#include <mckl/core/weight.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/smp.hpp>
+#include <mckl/utility/checkpoint.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+// The implementation of Weight::add_log prior to the fused normalization,
+// which recomputes the logarithm weights and makes a separate pass for each
+// of log, add, max, exp, sum and sum of squares
+class WeightRef
+{
+    public:
+    WeightRef(std::size_t N) : ess_(static_cast<double>(N)), data_(N, 1.0 / N)
+    {
+    }
+
+    double ess() const { return ess_; }
+
+    const double *data() const { return data_.data(); }
+
+    void add_log(const double *first)
+    {
+        const std::size_t n = data_.size();
+        mckl::log(n, data_.data(), data_.data());
+        mckl::add(n, first, data_.data(), data_.data());
+
+        double *w = data_.data();
+        double accw = 0;
+        double essw = 0;
+        const double lmax = *std::max_element(w, w + n);
+        const std::size_t k = mckl::internal::BufferSize<double>::value;
+        const std::size_t m = n / k;
+        const std::size_t l = n % k;
+        for (std::size_t i = 0; i != m; ++i, w += k)
+            normalize(k, w, accw, essw, lmax);
+        normalize(l, w, accw, essw, lmax);
+        mckl::mul(n, 1 / accw, data_.data(), data_.data());
+        ess_ = accw * accw / essw;
+    }
+
+    private:
+    double ess_;
+    mckl::Vector<double> data_;
+
+    void normalize(
+        std::size_t n, double *w, double &accw, double &essw, double lmax)
+    {
+        mckl::sub(n, w, lmax, w);
+        mckl::exp(n, w, w);
+        accw = std::accumulate(w, w + n, accw);
+        essw += mckl::internal::cblas_ddot(
+            static_cast<MCKL_BLAS_INT>(n), w, 1, w, 1);
+    }
+}; // class WeightRef
+
+template <typename WeightType>
+inline double weight_add_log(std::size_t repeat, WeightType &weight,
+    const mckl::Vector<double> &v, const mckl::Vector<double> &u)
+{
+    mckl::StopWatch watch;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        watch.start();
+        weight.add_log(r % 2 == 0 ? v.data() : u.data());
+        watch.stop();
+    }
+
+    return watch.nanoseconds() / (repeat * v.size());
+}
+
+inline bool weight_add_log(std::size_t N, int nwid, int twid)
+{
+    const std::size_t repeat = std::max(static_cast<std::size_t>(1),
+        static_cast<std::size_t>(100000000) / N);
+
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    mckl::Vector<double> u(N);
+    normal(rng, N, v.data());
+    for (std::size_t i = 0; i != N; ++i)
+        u[i] = -v[i];
+
+    double tref = 0;
+    double tnew = 0;
+    double ess_ref = 0;
+    double ess_new = 0;
+    double err = 0;
+    {
+        WeightRef ref(N);
+        tref = weight_add_log(repeat, ref, v, u);
+        ess_ref = ref.ess();
+        mckl::Weight weight(N);
+        tnew = weight_add_log(repeat, weight, v, u);
+        ess_new = weight.ess();
+        for (std::size_t i = 0; i != N; ++i) {
+            err = std::max(err,
+                std::abs(ref.data()[i] - weight.data()[i]) / ref.data()[i]);
+        }
+    }
+
+    // The logarithm weights are retained instead of recomputed from the
+    // normalized weights, and the sums are accumulated in a different order.
+    // Thus the results only agree up to rounding errors
+    const double err_ess = std::abs(ess_ref - ess_new) / ess_ref;
+    const bool pass = err_ess < 1e-10 && err < 1e-10;
+
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref;
+    std::cout << std::setw(twid) << std::right << std::fixed << tnew;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref / tnew;
+    std::cout << std::setw(twid) << std::right << std::scientific << err_ess;
+    std::cout << std::setw(twid) << std::right << std::scientific << err;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+inline bool weight_add_log(std::size_t N)
+{
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 6;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Ref (ns)";
+    std::cout << std::setw(twid) << std::right << "Fused (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Error (ESS)";
+    std::cout << std::setw(twid) << std::right << "Error (W)";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    for (std::size_t n = 1000; n <= N; n *= 10)
+        pass = weight_add_log(n, nwid, twid) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+// The ESS and the weights shall be identical for all backends
+template <typename Backend>
+inline bool weight_backend(const mckl::Vector<double> &v,
+    const mckl::Vector<double> &u, const mckl::Weight &ref)
+{
+    const std::size_t N = v.size();
+    mckl::WeightSMP<Backend> weight(N);
+    weight.add_log(v.data());
+    weight.add_log(u.data());
+
+    return weight.ess() == ref.ess() &&
+        std::equal(ref.data(), ref.data() + N, weight.data());
+}
+
+inline bool weight_backend(std::size_t N)
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    mckl::Vector<double> u(N);
+    normal(rng, N, v.data());
+    normal(rng, N, u.data());
+
+    mckl::Weight ref(N);
+    ref.add_log(v.data());
+    ref.add_log(u.data());
+
+    bool pass = weight_backend<mckl::BackendSTD>(v, u, ref);
+#if MCKL_HAS_OMP
+    pass = weight_backend<mckl::BackendOMP>(v, u, ref) && pass;
+#endif
+#if MCKL_HAS_TBB
+    pass = weight_backend<mckl::BackendTBB>(v, u, ref) && pass;
+#endif
+
+    std::cout << std::setw(20) << std::left << "Backend";
+    std::cout << std::setw(15) << std::right << N;
+    std::cout << std::setw(15) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+// Restore a larger Weight object into a smaller one, and then add logarithm
+// weights, which shall use reduction buffers of the restored size
+inline bool weight_checkpoint(std::size_t N)
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    normal(rng, N, v.data());
+
+    mckl::WeightSMP<> ref(N);
+    ref.add_log(v.data());
+    {
+        mckl::CheckpointWriter writer("core_weight.ckpt");
+        ref.checkpoint_store(writer, "/Weight");
+    }
+
+    mckl::WeightSMP<> weight(1);
+    weight.add_log(v.data());
+    mckl::CheckpointReader reader("core_weight.ckpt");
+    bool pass = weight.checkpoint_load(reader, "/Weight");
+    ref.add_log(v.data());
+    weight.add_log(v.data());
+    pass = pass && weight.size() == N && weight.ess() == ref.ess() &&
+        std::equal(ref.data(), ref.data() + N, weight.data());
+
+    std::cout << std::setw(20) << std::left << "Checkpoint";
+    std::cout << std::setw(15) << std::right << N;
+    std::cout << std::setw(15) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_CORE_WEIGHT_HPP
@@ -0,0 +1,489 @@
+//============================================================================
+// MCKL/example/math/include/math_vmath.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_MATH_VMATH_HPP
+#define MCKL_EXAMPLE_MATH_VMATH_HPP
+
+#include <mckl/math.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+// Solve erf(x) = y by Newton iterations, for |y| <= 1 / 2
+inline long double math_vmath_erf_newton(long double y)
+{
+    const long double f = 1.12837916709551257389615890312154517L;
+    long double x = std::abs(y) < 0.01L ?
+        y / f :
+        static_cast<long double>(mckl::erfinv(static_cast<double>(y)));
+    for (int i = 0; i != 4; ++i)
+        x -= (std::erf(x) - y) / (f * std::exp(-x * x));
+
+    return x;
+}
+
+// Solve erfc(x) = q by Newton iterations, for q <= 1 / 2
+inline long double math_vmath_erfc_newton(long double q)
+{
+    const long double f = 1.12837916709551257389615890312154517L;
+    long double x = mckl::erfcinv(static_cast<double>(q));
+    for (int i = 0; i != 4; ++i)
+        x += (std::erfc(x) - q) / (f * std::exp(-x * x));
+
+    return x;
+}
+
+inline long double math_vmath_erfcinv(long double q)
+{
+    if (q <= 0.5L)
+        return math_vmath_erfc_newton(q);
+    if (q >= 1.5L)
+        return -math_vmath_erfc_newton(2 - q);
+    return math_vmath_erf_newton(1 - q);
+}
+
+inline long double math_vmath_erfinv(long double y)
+{
+    if (std::abs(y) <= 0.5L)
+        return math_vmath_erf_newton(y);
+    return std::copysign(math_vmath_erfc_newton(1 - std::abs(y)), y);
+}
+
+inline long double math_vmath_cdfnorminv(long double p)
+{
+    return -1.41421356237309504880168872420969808L *
+        math_vmath_erfcinv(2 * p);
+}
+
+template <typename T>
+inline long double math_vmath_ulp(T y, long double r)
+{
+    if (std::isnan(r))
+        return std::isnan(y) ? 0 : std::numeric_limits<long double>::max();
+    if (std::isinf(r))
+        return static_cast<long double>(y) == r ?
+            0 :
+            std::numeric_limits<long double>::max();
+
+    const long double a = std::abs(r);
+    const long double u = a < std::numeric_limits<T>::min() ?
+        static_cast<long double>(std::numeric_limits<T>::denorm_min()) :
+        std::ldexp(1.0L,
+            std::ilogb(static_cast<T>(a)) - std::numeric_limits<T>::digits +
+                1);
+
+    return std::abs(static_cast<long double>(y) - r) / u;
+}
+
+inline void math_vmath_print(const std::string &name, long double ulp,
+    long double bound, double t_vmath, double t_std)
+{
+    std::cout << std::setw(20) << std::left << name << std::setw(12)
+              << std::right << std::fixed << std::setprecision(3)
+              << static_cast<double>(ulp) << std::setw(12)
+              << static_cast<double>(bound) << std::setw(12) << t_vmath
+              << std::setw(12) << t_std << std::setw(12)
+              << t_std / t_vmath << std::endl;
+}
+
+template <typename T, typename RNGType, typename Gen, typename VFunc,
+    typename SFunc, typename RFunc>
+inline bool math_vmath_test(std::size_t n, std::size_t m,
+    const std::string &name, long double bound, RNGType &rng, Gen &&gen,
+    VFunc &&vfunc, SFunc &&sfunc, RFunc &&rfunc)
+{
+    mckl::Vector<T> x(n);
+    mckl::Vector<T> y(n);
+    mckl::Vector<T> z(n);
+    mckl::StopWatch watch_vmath;
+    mckl::StopWatch watch_std;
+    long double ulp = 0;
+    for (std::size_t k = 0; k != m; ++k) {
+        for (std::size_t i = 0; i != n; ++i)
+            x[i] = gen(rng);
+
+        watch_vmath.start();
+        vfunc(n, x.data(), y.data());
+        watch_vmath.stop();
+
+        watch_std.start();
+        for (std::size_t i = 0; i != n; ++i)
+            z[i] = sfunc(x[i]);
+        watch_std.stop();
+
+        for (std::size_t i = 0; i != n; ++i) {
+            ulp = std::max(ulp,
+                math_vmath_ulp(y[i], rfunc(static_cast<long double>(x[i]))));
+        }
+    }
+    math_vmath_print(name, ulp, bound, watch_vmath.milliseconds(),
+        watch_std.milliseconds());
+
+    return ulp <= bound;
+}
+
+template <typename T, typename RNGType>
+inline bool math_vmath_sincos(
+    std::size_t n, std::size_t m, long double bound, RNGType &rng)
+{
+    std::uniform_real_distribution<T> runif(-1e4, 1e4);
+    mckl::Vector<T> x(n);
+    mckl::Vector<T> y(n);
+    mckl::Vector<T> z(n);
+    mckl::StopWatch watch_vmath;
+    mckl::StopWatch watch_std;
+    long double ulp = 0;
+    for (std::size_t k = 0; k != m; ++k) {
+        for (std::size_t i = 0; i != n; ++i)
+            x[i] = runif(rng);
+
+        watch_vmath.start();
+        mckl::sincos(n, x.data(), y.data(), z.data());
+        watch_vmath.stop();
+
+        for (std::size_t i = 0; i != n; ++i) {
+            const long double r = static_cast<long double>(x[i]);
+            ulp = std::max(ulp, math_vmath_ulp(y[i], std::sin(r)));
+            ulp = std::max(ulp, math_vmath_ulp(z[i], std::cos(r)));
+        }
+
+        watch_std.start();
+        for (std::size_t i = 0; i != n; ++i) {
+            y[i] = std::sin(x[i]);
+            z[i] = std::cos(x[i]);
+        }
+        watch_std.stop();
+    }
+    math_vmath_print("sincos", ulp, bound, watch_vmath.milliseconds(),
+        watch_std.milliseconds());
+
+    return ulp <= bound;
+}
+
+template <typename T>
+inline bool math_vmath_same(T y, T r)
+{
+    if (std::isnan(r))
+        return std::isnan(y);
+
+    return y == r && std::signbit(y) == std::signbit(r);
+}
+
+// Each special value is placed in a vector among ordinary values, and the
+// length of the vector leaves a partial trailing SIMD vector. The results of
+// special values shall be exact, those of edge values and ordinary values
+// shall be within the error bound
+template <typename T, typename VFunc, typename RFunc>
+inline bool math_vmath_special(const std::string &name, long double bound,
+    T a, const mckl::Vector<std::pair<T, T>> &special,
+    const mckl::Vector<T> &edge, VFunc &&vfunc, RFunc &&rfunc)
+{
+    const std::size_t k = special.size() + edge.size();
+    const std::size_t n = k * 3 + 1;
+    mckl::Vector<T> x(n, a);
+    mckl::Vector<T> y(n);
+    for (std::size_t i = 0; i != special.size(); ++i)
+        x[i * 3 + 1] = special[i].first;
+    for (std::size_t i = 0; i != edge.size(); ++i)
+        x[(special.size() + i) * 3 + 1] = edge[i];
+    vfunc(n, x.data(), y.data());
+
+    bool exact = true;
+    long double ulp = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t j = i / 3;
+        if (i % 3 == 1 && j < special.size())
+            exact = exact && math_vmath_same(y[i], special[j].second);
+        else
+            ulp = std::max(ulp,
+                math_vmath_ulp(y[i], rfunc(static_cast<long double>(x[i]))));
+    }
+    const bool pass = exact && ulp <= bound;
+
+    std::cout << std::setw(20) << std::left << name << std::setw(12)
+              << std::right << special.size() << std::setw(12) << edge.size()
+              << std::setw(12) << std::fixed << std::setprecision(3)
+              << static_cast<double>(ulp) << std::setw(12)
+              << static_cast<double>(bound) << std::setw(12)
+              << (pass ? "Passed" : "Failed") << std::endl;
+
+    return pass;
+}
+
+template <typename T>
+inline bool math_vmath(std::size_t n, std::size_t m, const std::string &tname)
+{
+    using L = long double;
+
+    mckl::RNG rng;
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(60) << std::left << "Type name" << std::setw(20)
+              << std::right << tname << std::endl;
+    std::cout << std::setw(60) << std::left << "Built-in SIMD" << std::setw(20)
+              << std::right << (MCKL_USE_SIMD_VMATH ? "True" : "False")
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "MKL VML" << std::setw(20)
+              << std::right << (MCKL_USE_MKL_VML ? "True" : "False")
+              << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(20) << std::left << "Function" << std::setw(12)
+              << std::right << "ULP" << std::setw(12) << "Bound"
+              << std::setw(12) << "vMath (ms)" << std::setw(12) << "STD (ms)"
+              << std::setw(12) << "Speedup" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    // Error bounds documented by the built-in SIMD implementation. The float
+    // overloads evaluate the double precision kernels and round the results
+    const bool d = std::is_same<T, double>::value;
+    const bool f = MCKL_HAS_AVX512F || MCKL_HAS_FMA;
+    const L b_exp = d ? (f ? 1 : 1.5) : 0.51;
+    const L b_expm1 = d ? 1.5 : 0.51;
+    const L b_log = d ? 1 : 0.51;
+    const L b_log1p = d ? 1.5 : 0.51;
+    const L b_sqrt = d ? 0.5 : 0.51;
+    const L b_trig = d ? 1 : 0.51;
+    const L b_erf = d ? (f ? 2 : 3) : 0.51;
+    const L b_erfinv = d ? 2.5 : 0.51;
+    const L b_erfcinv = d ? (f ? 3 : 3.5) : 0.51;
+    const L b_cdfnorminv = d ? (f ? 3.5 : 4) : 0.51;
+
+    std::uniform_real_distribution<T> uexp(-700, 700);
+    std::uniform_real_distribution<T> uexpm1(-10, 10);
+    std::uniform_real_distribution<T> ulog(-700, 700);
+    std::uniform_real_distribution<T> ulog1p(-0.999, 10);
+    std::uniform_real_distribution<T> usqrt(0, 1e6);
+    std::uniform_real_distribution<T> utrig(-1e4, 1e4);
+    std::uniform_real_distribution<T> uerf(-7, 7);
+    std::uniform_real_distribution<T> uerfinv(-1, 1);
+    std::uniform_real_distribution<T> uerfcinv(0, 2);
+    std::uniform_real_distribution<T> ucdfnorminv(0, 1);
+
+    // Concentrate some of the inputs near the edges of the domains
+    auto tails = [](T u, T v) {
+        return std::abs(u) < static_cast<T>(0.5) ? u : v;
+    };
+    auto gexp = [&](mckl::RNG &r) { return uexp(r); };
+    auto gexpm1 = [&](mckl::RNG &r) {
+        T u = uexpm1(r);
+        return tails(u, u * static_cast<T>(1e-9));
+    };
+    auto glog = [&](mckl::RNG &r) {
+        return std::exp(d ? ulog(r) : ulog(r) / 8);
+    };
+    auto glog1p = [&](mckl::RNG &r) {
+        T u = ulog1p(r);
+        return tails(u, u * static_cast<T>(1e-9));
+    };
+    auto gsqrt = [&](mckl::RNG &r) { return usqrt(r); };
+    auto gtrig = [&](mckl::RNG &r) { return utrig(r); };
+    auto gerf = [&](mckl::RNG &r) { return uerf(r); };
+    auto gerfinv = [&](mckl::RNG &r) {
+        T u = uerfinv(r);
+        return tails(
+            u, std::copysign(1 - std::exp((d ? -25 : -12) * std::abs(u)), u));
+    };
+    auto gerfcinv = [&](mckl::RNG &r) {
+        T u = uerfcinv(r);
+        return u < 1 ? u * std::exp(-60 * (1 - u)) : u;
+    };
+    auto gcdfnorminv = [&](mckl::RNG &r) {
+        T u = ucdfnorminv(r);
+        return u < static_cast<T>(0.5) ? u * std::exp(-60 * u) : u;
+    };
+
+    bool passed = true;
+
+    passed &= math_vmath_test<T>(n, m, "exp", b_exp, rng, gexp,
+        [](std::size_t k, const T *a, T *y) { mckl::exp(k, a, y); },
+        [](T a) { return std::exp(a); }, [](L a) { return std::exp(a); });
+
+    passed &= math_vmath_test<T>(n, m, "expm1", b_expm1, rng, gexpm1,
+        [](std::size_t k, const T *a, T *y) { mckl::expm1(k, a, y); },
+        [](T a) { return std::expm1(a); }, [](L a) { return std::expm1(a); });
+
+    passed &= math_vmath_test<T>(n, m, "log", b_log, rng, glog,
+        [](std::size_t k, const T *a, T *y) { mckl::log(k, a, y); },
+        [](T a) { return std::log(a); }, [](L a) { return std::log(a); });
+
+    passed &= math_vmath_test<T>(n, m, "log1p", b_log1p, rng, glog1p,
+        [](std::size_t k, const T *a, T *y) { mckl::log1p(k, a, y); },
+        [](T a) { return std::log1p(a); }, [](L a) { return std::log1p(a); });
+
+    passed &= math_vmath_test<T>(n, m, "sqrt", b_sqrt, rng, gsqrt,
+        [](std::size_t k, const T *a, T *y) { mckl::sqrt(k, a, y); },
+        [](T a) { return std::sqrt(a); }, [](L a) { return std::sqrt(a); });
+
+    passed &= math_vmath_test<T>(n, m, "sin", b_trig, rng, gtrig,
+        [](std::size_t k, const T *a, T *y) { mckl::sin(k, a, y); },
+        [](T a) { return std::sin(a); }, [](L a) { return std::sin(a); });
+
+    passed &= math_vmath_test<T>(n, m, "cos", b_trig, rng, gtrig,
+        [](std::size_t k, const T *a, T *y) { mckl::cos(k, a, y); },
+        [](T a) { return std::cos(a); }, [](L a) { return std::cos(a); });
+
+    passed &= math_vmath_sincos<T>(n, m, b_trig, rng);
+
+    passed &= math_vmath_test<T>(n, m, "erf", b_erf, rng, gerf,
+        [](std::size_t k, const T *a, T *y) { mckl::erf(k, a, y); },
+        [](T a) { return std::erf(a); }, [](L a) { return std::erf(a); });
+
+    passed &= math_vmath_test<T>(n, m, "erfinv", b_erfinv, rng, gerfinv,
+        [](std::size_t k, const T *a, T *y) { mckl::erfinv(k, a, y); },
+        [](T a) { return static_cast<T>(mckl::erfinv(a)); },
+        [](L a) { return math_vmath_erfinv(a); });
+
+    passed &= math_vmath_test<T>(n, m, "erfcinv", b_erfcinv, rng, gerfcinv,
+        [](std::size_t k, const T *a, T *y) { mckl::erfcinv(k, a, y); },
+        [](T a) { return static_cast<T>(mckl::erfcinv(a)); },
+        [](L a) { return math_vmath_erfcinv(a); });
+
+    passed &= math_vmath_test<T>(n, m, "cdfnorminv", b_cdfnorminv, rng,
+        gcdfnorminv,
+        [](std::size_t k, const T *a, T *y) { mckl::cdfnorminv(k, a, y); },
+        [](T a) {
+            return static_cast<T>(
+                -mckl::const_sqrt_2<double>() * mckl::erfcinv(2.0 * a));
+        },
+        [](L a) { return math_vmath_cdfnorminv(a); });
+
+    std::cout << std::string(80, '-') << std::endl;
+    if (!MCKL_USE_SIMD_VMATH)
+        return true;
+
+    std::cout << std::setw(20) << std::left << "Function" << std::setw(12)
+              << std::right << "Special" << std::setw(12) << "Edge"
+              << std::setw(12) << "ULP" << std::setw(12) << "Bound"
+              << std::setw(12) << "Result" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const T inf = std::numeric_limits<T>::infinity();
+    const T dmin = std::numeric_limits<T>::denorm_min();
+    const T tmin = std::numeric_limits<T>::min();
+    const T tmax = std::numeric_limits<T>::max();
+    const T lmax = std::log(tmax);
+    const T lmin = std::log(tmin);
+
+    passed &= math_vmath_special<T>("exp", b_exp, 0.5,
+        {{0, 1}, {-0.0, 1}, {inf, inf}, {-inf, 0}, {nan, nan}, {tmax, inf},
+            {-tmax, 0}, {2 * lmax, inf}, {4 * lmin, 0}},
+        {dmin, -dmin, lmax * static_cast<T>(0.999), lmin},
+        [](std::size_t k, const T *a, T *y) { mckl::exp(k, a, y); },
+        [](L a) { return std::exp(a); });
+
+    passed &= math_vmath_special<T>("expm1", b_expm1, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {inf, inf}, {-inf, -1}, {nan, nan},
+            {tmax, inf}, {-tmax, -1}, {2 * lmax, inf}},
+        {dmin, -dmin, tmin, -tmin, lmax * static_cast<T>(0.999), lmin},
+        [](std::size_t k, const T *a, T *y) { mckl::expm1(k, a, y); },
+        [](L a) { return std::expm1(a); });
+
+    passed &= math_vmath_special<T>("log", b_log, 0.5,
+        {{1, 0}, {0, -inf}, {-0.0, -inf}, {inf, inf}, {-inf, nan},
+            {-1, nan}, {nan, nan}},
+        {dmin, tmin, tmax},
+        [](std::size_t k, const T *a, T *y) { mckl::log(k, a, y); },
+        [](L a) { return std::log(a); });
+
+    passed &= math_vmath_special<T>("log1p", b_log1p, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {-1, -inf}, {-2, nan}, {inf, inf},
+            {-inf, nan}, {nan, nan}},
+        {dmin, -dmin, tmin, -tmin, tmax},
+        [](std::size_t k, const T *a, T *y) { mckl::log1p(k, a, y); },
+        [](L a) { return std::log1p(a); });
+
+    passed &= math_vmath_special<T>("sqrt", b_sqrt, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {4, 2}, {inf, inf}, {-1, nan}, {-inf, nan},
+            {nan, nan}},
+        {dmin, tmin, tmax},
+        [](std::size_t k, const T *a, T *y) { mckl::sqrt(k, a, y); },
+        [](L a) { return std::sqrt(a); });
+
+    passed &= math_vmath_special<T>("sin", b_trig, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {inf, nan}, {-inf, nan}, {nan, nan}},
+        {dmin, -dmin, tmin, static_cast<T>(1e6)},
+        [](std::size_t k, const T *a, T *y) { mckl::sin(k, a, y); },
+        [](L a) { return std::sin(a); });
+
+    passed &= math_vmath_special<T>("cos", b_trig, 0.5,
+        {{0, 1}, {-0.0, 1}, {inf, nan}, {-inf, nan}, {nan, nan}},
+        {dmin, tmin, static_cast<T>(1e6)},
+        [](std::size_t k, const T *a, T *y) { mckl::cos(k, a, y); },
+        [](L a) { return std::cos(a); });
+
+    passed &= math_vmath_special<T>("sincos", b_trig, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {inf, nan}, {-inf, nan}, {nan, nan}},
+        {dmin, -dmin, tmin, static_cast<T>(1e6)},
+        [](std::size_t k, const T *a, T *y) {
+            mckl::Vector<T> z(k);
+            mckl::sincos(k, a, y, z.data());
+        },
+        [](L a) { return std::sin(a); });
+
+    passed &= math_vmath_special<T>("erf", b_erf, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {inf, 1}, {-inf, -1}, {nan, nan}, {10, 1},
+            {-10, -1}},
+        {dmin, -dmin, tmin, -tmin},
+        [](std::size_t k, const T *a, T *y) { mckl::erf(k, a, y); },
+        [](L a) { return std::erf(a); });
+
+    // Outside the domains, the inverse functions saturate to infinities, the
+    // same as the scalar functions
+    passed &= math_vmath_special<T>("erfinv", b_erfinv, 0.5,
+        {{0, 0}, {-0.0, -0.0}, {1, inf}, {-1, -inf}, {2, inf}, {-2, -inf},
+            {inf, inf}, {-inf, -inf}, {nan, nan}},
+        {dmin, -dmin, tmin, -tmin},
+        [](std::size_t k, const T *a, T *y) { mckl::erfinv(k, a, y); },
+        [](L a) { return math_vmath_erfinv(a); });
+
+    passed &= math_vmath_special<T>("erfcinv", b_erfcinv, 0.5,
+        {{1, 0}, {0, inf}, {2, -inf}, {-1, inf}, {3, -inf}, {inf, -inf},
+            {-inf, inf}, {nan, nan}},
+        {tmin, 2 - std::numeric_limits<T>::epsilon()},
+        [](std::size_t k, const T *a, T *y) { mckl::erfcinv(k, a, y); },
+        [](L a) { return math_vmath_erfcinv(a); });
+
+    passed &= math_vmath_special<T>("cdfnorminv", b_cdfnorminv, 0.25,
+        {{0, -inf}, {1, inf}, {-1, -inf}, {2, inf}, {inf, inf},
+            {-inf, -inf}, {nan, nan}},
+        {0.5, tmin, 1 - std::numeric_limits<T>::epsilon() / 2},
+        [](std::size_t k, const T *a, T *y) { mckl::cdfnorminv(k, a, y); },
+        [](L a) { return math_vmath_cdfnorminv(a); });
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    return passed;
+}
+
+#endif // MCKL_EXAMPLE_MATH_VMATH_HPP
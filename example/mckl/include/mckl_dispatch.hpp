@@ -0,0 +1,203 @@
+//============================================================================
+// MCKL/example/mckl/include/mckl_dispatch.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION); HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE);
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_MCKL_DISPATCH_HPP
+#define MCKL_EXAMPLE_MCKL_DISPATCH_HPP
+
+#include <mckl/mckl.h>
+#include <mckl/utility/cpu_features.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// The distribution kernels compiled for each instruction set by the library
+#define MCKL_EXAMPLE_DISPATCH_DECLARE(name, params)                           \
+    void name##_sse2 params;                                                  \
+    void name##_avx2 params;                                                  \
+    void name##_avx512f params;
+
+extern "C" {
+
+MCKL_EXAMPLE_DISPATCH_DECLARE(
+    mckl_rand_u01, (mckl_rng rng, size_t n, double *r))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_normal,
+    (mckl_rng rng, size_t n, double *r, double mean, double stddev))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_lognormal,
+    (mckl_rng rng, size_t n, double *r, double m, double s))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_cauchy,
+    (mckl_rng rng, size_t n, double *r, double a, double b))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_gamma,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_beta,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta))
+MCKL_EXAMPLE_DISPATCH_DECLARE(mckl_rand_stable,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta, double a,
+        double b))
+
+} // extern "C"
+
+#define MCKL_EXAMPLE_DISPATCH(name, ...)                                      \
+    mckl_dispatch(N, nwid, twid, #name "(" #__VA_ARGS__ ")",                  \
+        mckl_rand_##name, mckl_rand_##name##_sse2, mckl_rand_##name##_avx2,   \
+        mckl_rand_##name##_avx512f, __VA_ARGS__)
+
+template <typename Func, typename... Args>
+inline std::vector<double> mckl_dispatch_run(
+    std::size_t N, Func func, Args... args)
+{
+    std::vector<double> r(N);
+    mckl_rng rng = mckl_rng_new(101, MCKLRNG);
+    func(rng, N, r.data(), args...);
+    mckl_rng_delete(&rng);
+
+    return r;
+}
+
+inline bool mckl_dispatch_equal(
+    const std::vector<double> &r1, const std::vector<double> &r2)
+{
+    return r1.size() == r2.size() &&
+        std::memcmp(r1.data(), r2.data(), sizeof(double) * r1.size()) == 0;
+}
+
+inline void mckl_dispatch_print(bool supported, bool pass, int twid)
+{
+    std::cout << std::setw(twid) << std::right
+              << (supported ? (pass ? "Passed" : "Failed") : "N/A");
+}
+
+// The results of each instruction set, and those of the dispatched function,
+// shall be bitwise identical to those of SSE2
+template <typename Func, typename... Args>
+inline bool mckl_dispatch(std::size_t N, int nwid, int twid,
+    const std::string &name, Func dispatch, Func sse2, Func avx2, Func avx512f,
+    Args... args)
+{
+    const bool has_avx2 = mckl::cpu_has(mckl::CPUAVX2);
+    const bool has_avx512f = mckl::cpu_has(mckl::CPUAVX512F);
+
+    const std::vector<double> r = mckl_dispatch_run(N, sse2, args...);
+    const bool pass_dispatch =
+        mckl_dispatch_equal(r, mckl_dispatch_run(N, dispatch, args...));
+    const bool pass_avx2 = !has_avx2 ||
+        mckl_dispatch_equal(r, mckl_dispatch_run(N, avx2, args...));
+    const bool pass_avx512f = !has_avx512f ||
+        mckl_dispatch_equal(r, mckl_dispatch_run(N, avx512f, args...));
+
+    std::cout << std::setw(nwid) << std::left << name;
+    mckl_dispatch_print(has_avx2, pass_avx2, twid);
+    mckl_dispatch_print(has_avx512f, pass_avx512f, twid);
+    mckl_dispatch_print(true, pass_dispatch, twid);
+    std::cout << std::endl;
+
+    return pass_dispatch && pass_avx2 && pass_avx512f;
+}
+
+// The features reported by the library shall be those detected by the
+// header, and the selected instruction set the best one supported
+inline bool mckl_dispatch_cpu(int nwid, int twid)
+{
+    const int features = mckl_cpu_features();
+    const int dispatch = mckl_cpu_dispatch();
+
+    int expected = MCKLCPUSSE2;
+    if (mckl::cpu_has(mckl::CPUAVX2))
+        expected = MCKLCPUAVX2;
+    if (mckl::cpu_has(mckl::CPUAVX512F))
+        expected = MCKLCPUAVX512F;
+
+    const bool pass_features =
+        features == static_cast<int>(mckl::cpu_features());
+    const bool pass_dispatch = dispatch == expected;
+
+    std::string isa("None");
+    if (dispatch == MCKLCPUAVX512F)
+        isa = "AVX512F";
+    else if (dispatch == MCKLCPUAVX2)
+        isa = "AVX2";
+    else if (dispatch == MCKLCPUSSE2)
+        isa = "SSE2";
+
+    std::cout << std::setw(nwid) << std::left << "mckl_cpu_features";
+    std::cout << std::setw(twid) << std::right << features;
+    mckl_dispatch_print(true, pass_features, twid);
+    std::cout << std::endl;
+    std::cout << std::setw(nwid) << std::left << "mckl_cpu_dispatch";
+    std::cout << std::setw(twid) << std::right << isa;
+    mckl_dispatch_print(true, pass_dispatch, twid);
+    std::cout << std::endl;
+
+    return pass_features && pass_dispatch;
+}
+
+inline bool mckl_dispatch(std::size_t N)
+{
+    const int nwid = 30;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 3;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Function";
+    std::cout << std::setw(twid) << std::right << "AVX2";
+    std::cout << std::setw(twid) << std::right << "AVX512F";
+    std::cout << std::setw(twid) << std::right << "Dispatch";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    bool pass = true;
+    pass = mckl_dispatch(N, nwid, twid, "u01", mckl_rand_u01,
+               mckl_rand_u01_sse2, mckl_rand_u01_avx2, mckl_rand_u01_avx512f) &&
+        pass;
+    pass = MCKL_EXAMPLE_DISPATCH(normal, 0.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(normal, 1.5, 2.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(lognormal, 0.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(cauchy, 0.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(gamma, 0.5, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(gamma, 1.0, 2.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(gamma, 3.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(beta, 0.5, 0.5) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(beta, 1.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(beta, 0.5, 2.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(beta, 2.0, 3.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(stable, 0.5, -0.3, 0.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(stable, 1.0, 0.5, 0.0, 1.0) && pass;
+    pass = MCKL_EXAMPLE_DISPATCH(stable, 1.5, 0.5, 0.0, 1.0) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+    pass = mckl_dispatch_cpu(nwid, twid) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_MCKL_DISPATCH_HPP
@@ -128,6 +128,12 @@ std::string pf_rng_set_name<mckl::RNGSetVector<>>()
     return "RNGSetVector";
 }
 
+template <>
+std::string pf_rng_set_name<mckl::RNGSetCounter<>>()
+{
+    return "RNGSetCounter";
+}
+
 #if MCKL_HAS_TBB
 template <>
 std::string pf_rng_set_name<mckl::RNGSetTBB<>>()
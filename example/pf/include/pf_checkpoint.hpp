@@ -0,0 +1,166 @@
+//============================================================================
+// MCKL/example/pf/include/pf_checkpoint.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef MCKL_EXAMPLE_PF_CHECKPOINT_HPP
+#define MCKL_EXAMPLE_PF_CHECKPOINT_HPP
+
+#include "pf_cv.hpp"
+
+template <typename Backend, mckl::MatrixLayout Layout, typename RNGSetType>
+inline void pf_checkpoint_eval(
+    mckl::Sampler<PFCV<Layout, RNGSetType>> &sampler)
+{
+    using T = PFCV<Layout, RNGSetType>;
+
+    sampler.resample_method(mckl::Stratified, 0.5);
+    sampler.eval(PFCVInit<Backend, Layout, RNGSetType>(), mckl::SamplerInit);
+    sampler.eval(PFCVMove<Backend, Layout, RNGSetType>(), mckl::SamplerMove);
+    sampler.eval(PFCVWeight<Backend, Layout, RNGSetType>(),
+        mckl::SamplerInit | mckl::SamplerMove);
+    sampler.monitor("pos",
+        mckl::Monitor<T>(2, PFCVEval<Backend, Layout, RNGSetType>(), false,
+            mckl::MonitorMove));
+}
+
+template <typename Backend, mckl::MatrixLayout Layout, typename RNGSetType>
+inline void pf_checkpoint(std::size_t N, int nwid, int twid)
+{
+    using T = PFCV<Layout, RNGSetType>;
+
+    const std::string filename("pf_checkpoint.ckpt");
+
+    // The reference runs without interruption, except that a checkpoint is
+    // stored halfway
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> ref(N);
+    pf_checkpoint_eval<Backend, Layout, RNGSetType>(ref);
+    ref.initialize();
+    const std::size_t n = ref.particle().state().n();
+    const std::size_t m = n / 2;
+    ref.iterate(m - 1);
+
+    mckl::StopWatch watch_store;
+    watch_store.start();
+    bool pass = mckl::checkpoint_store(ref, filename);
+    watch_store.stop();
+
+    ref.iterate(n - m);
+    const auto sref = mckl::Seed::instance().get();
+
+    // The new sampler is constructed with different seeds, and resumes from
+    // the checkpoint
+    mckl::Sampler<T> sampler(N);
+    pf_checkpoint_eval<Backend, Layout, RNGSetType>(sampler);
+
+    mckl::StopWatch watch_load;
+    watch_load.start();
+    pass = pass && mckl::checkpoint_load(filename, sampler);
+    watch_load.stop();
+
+    sampler.iterate(n - m);
+    const auto snew = mckl::Seed::instance().get();
+
+    pass = pass && sref == snew;
+    pass = pass && ref.iter_num() == sampler.iter_num();
+    pass = pass && ref.iter_size() == sampler.iter_size();
+    pass = pass && ref.particle().state() == sampler.particle().state();
+    pass = pass &&
+        std::equal(ref.particle().weight().data(),
+            ref.particle().weight().data() + N,
+            sampler.particle().weight().data());
+    for (std::size_t i = 0; pass && i != ref.iter_size(); ++i) {
+        pass = pass && ref.size_history(i) == sampler.size_history(i);
+        pass = pass && ref.ess_history(i) == sampler.ess_history(i);
+        pass = pass &&
+            ref.resampled_history(i) == sampler.resampled_history(i);
+        for (std::size_t d = 0; d != 2; ++d) {
+            pass = pass &&
+                ref.monitor("pos").record(d, i) ==
+                    sampler.monitor("pos").record(d, i);
+        }
+    }
+
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    file.seekg(0, std::ios::end);
+    const double bytes = static_cast<double>(file.tellg());
+    file.close();
+    std::remove(filename.c_str());
+
+    std::cout << std::setw(nwid) << std::left << pf_layout_name<Layout>();
+    std::cout << std::setw(nwid) << std::left
+              << pf_rng_set_name<RNGSetType>();
+    std::cout << std::setw(nwid) << std::right << N;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << bytes / (1 << 20);
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_store.milliseconds();
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_load.milliseconds();
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+template <typename Backend>
+inline void pf_checkpoint(std::size_t N, int nwid, int twid)
+{
+    for (std::size_t n = 1000; n <= N; n *= 10) {
+        pf_checkpoint<Backend, mckl::RowMajor, mckl::RNGSetVector<>>(
+            n, nwid, twid);
+        pf_checkpoint<Backend, mckl::ColMajor, mckl::RNGSetVector<>>(
+            n, nwid, twid);
+        pf_checkpoint<Backend, mckl::RowMajor, mckl::RNGSetCounter<>>(
+            n, nwid, twid);
+        pf_checkpoint<Backend, mckl::ColMajor, mckl::RNGSetCounter<>>(
+            n, nwid, twid);
+    }
+}
+
+inline void pf_checkpoint(std::size_t N)
+{
+    const int nwid = 15;
+    const int twid = 15;
+    const std::size_t lwid = nwid * 3 + twid * 4;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "MatrixLayout";
+    std::cout << std::setw(nwid) << std::left << "RNGSet";
+    std::cout << std::setw(nwid) << std::right << "N";
+    std::cout << std::setw(twid) << std::right << "Size (MB)";
+    std::cout << std::setw(twid) << std::right << "Store (ms)";
+    std::cout << std::setw(twid) << std::right << "Load (ms)";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    pf_checkpoint<mckl::BackendSTD>(N, nwid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_PF_CHECKPOINT_HPP
@@ -332,6 +332,7 @@ template <typename Backend, mckl::ResampleScheme Scheme,
 inline void pf_cv_run(std::size_t N, int nwid, int twid)
 {
     pf_cv_run<Backend, Scheme, Layout, mckl::RNGSetVector<>>(N, nwid, twid);
+    pf_cv_run<Backend, Scheme, Layout, mckl::RNGSetCounter<>>(N, nwid, twid);
 #if MCKL_HAS_TBB
     pf_cv_run<Backend, Scheme, Layout, mckl::RNGSetTBB<>>(N, nwid, twid);
 #endif
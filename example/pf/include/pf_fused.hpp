@@ -0,0 +1,184 @@
+//============================================================================
+// MCKL/example/pf/include/pf_fused.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MCKL_EXAMPLE_PF_FUSED_HPP
+#define MCKL_EXAMPLE_PF_FUSED_HPP
+
+#include "pf_cv.hpp"
+
+// The same as PFCVMove, except that the random numbers of each particle are
+// always drawn from its own RNG, regardless of the layout. Therefore the
+// results do not depend on how the particles are partitioned
+template <typename Backend, mckl::MatrixLayout Layout, typename RNGSetType>
+class PFFusedMove
+    : public mckl::SamplerEvalSMP<PFCV<Layout, RNGSetType>,
+          PFFusedMove<Backend, Layout, RNGSetType>, Backend>
+{
+    public:
+    using T = PFCV<Layout, RNGSetType>;
+
+    void eval_each(std::size_t, mckl::ParticleIndex<T> idx)
+    {
+        const double sd_pos = std::sqrt(0.02);
+        const double sd_vel = std::sqrt(0.001);
+        const double delta = 0.1;
+        mckl::NormalDistribution<double> normal_pos(0, sd_pos);
+        mckl::NormalDistribution<double> normal_vel(0, sd_vel);
+
+        auto &rng = idx.rng();
+        idx.pos_x() += normal_pos(rng) + delta * idx.vel_x();
+        idx.pos_y() += normal_pos(rng) + delta * idx.vel_y();
+        idx.vel_x() += normal_vel(rng);
+        idx.vel_y() += normal_vel(rng);
+    }
+}; // class PFFusedMove
+
+template <typename Backend, mckl::MatrixLayout Layout>
+inline double pf_fused_run(
+    mckl::Sampler<PFCV<Layout, mckl::RNGSetVector<>>> &sampler, bool fused)
+{
+    using T = PFCV<Layout, mckl::RNGSetVector<>>;
+    using RNGSetType = mckl::RNGSetVector<>;
+
+    sampler.resample_method(mckl::Stratified, 0.5);
+    sampler.eval(PFCVInit<Backend, Layout, RNGSetType>(), mckl::SamplerInit);
+    sampler.eval(
+        PFFusedMove<Backend, Layout, RNGSetType>(), mckl::SamplerMove);
+    sampler.eval(PFCVWeight<Backend, Layout, RNGSetType>(),
+        mckl::SamplerInit | mckl::SamplerMove);
+    sampler.monitor("pos",
+        mckl::Monitor<T>(2, PFCVEval<Backend, Layout, RNGSetType>(), false,
+            mckl::MonitorMove));
+    sampler.monitor("post",
+        mckl::Monitor<T>(2, PFCVEval<Backend, Layout, RNGSetType>(), false,
+            mckl::MonitorResample));
+    sampler.template fused<Backend>(fused);
+    sampler.initialize();
+
+    const std::size_t n = sampler.particle().state().n();
+    sampler.reserve(n);
+    mckl::StopWatch watch;
+    for (std::size_t i = 1; i < n; ++i) {
+        watch.start();
+        sampler.iterate();
+        watch.stop();
+    }
+
+    return watch.nanoseconds() / ((n - 1) * sampler.size());
+}
+
+template <typename Backend, mckl::MatrixLayout Layout>
+inline bool pf_fused(std::size_t N, int nwid, int twid)
+{
+    using T = PFCV<Layout, mckl::RNGSetVector<>>;
+
+    // The reference applies the move, the weight and the monitor one after
+    // another, each in a pass over all particles. The results of the fused
+    // iterations shall only differ by rounding errors. The Monitor evaluated
+    // after resampling is not fused
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> ref(N);
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> fused(N);
+    const double tref = pf_fused_run<Backend, Layout>(ref, false);
+    const double tnew = pf_fused_run<Backend, Layout>(fused, true);
+
+    double err = 0;
+    for (std::size_t i = 0; i != ref.iter_size(); ++i) {
+        err = std::max(err, std::abs(ref.ess_history(i) -
+                                fused.ess_history(i)) /
+                (1 + ref.ess_history(i)));
+        for (std::size_t d = 0; d != 2; ++d) {
+            for (const char *name : {"pos", "post"}) {
+                const double r = ref.monitor(name).record(d, i);
+                const double f = fused.monitor(name).record(d, i);
+                err = std::max(err, std::abs(r - f) / (1 + std::abs(r)));
+            }
+        }
+    }
+
+    std::cout << std::setw(nwid) << std::left << pf_backend_name<Backend>();
+    std::cout << std::setw(nwid) << std::left << pf_layout_name<Layout>();
+    std::cout << std::setw(nwid) << std::right << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref;
+    std::cout << std::setw(twid) << std::right << std::fixed << tnew;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref / tnew;
+    std::cout << std::setw(twid) << std::right << std::scientific << err;
+    std::cout << std::setw(twid) << std::right
+              << (err < 1e-12 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return err < 1e-12;
+}
+
+template <typename Backend>
+inline bool pf_fused(std::size_t N, int nwid, int twid)
+{
+    bool pass = true;
+    for (std::size_t n = 1000; n <= N; n *= 10) {
+        pass = pf_fused<Backend, mckl::RowMajor>(n, nwid, twid) && pass;
+        pass = pf_fused<Backend, mckl::ColMajor>(n, nwid, twid) && pass;
+    }
+
+    return pass;
+}
+
+inline bool pf_fused(std::size_t N)
+{
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid * 3 + twid * 5;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Backend";
+    std::cout << std::setw(nwid) << std::left << "MatrixLayout";
+    std::cout << std::setw(nwid) << std::right << "N";
+    std::cout << std::setw(twid) << std::right << "Ref (ns)";
+    std::cout << std::setw(twid) << std::right << "Fused (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Error";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    pass = pf_fused<mckl::BackendSEQ>(N, nwid, twid) && pass;
+    pass = pf_fused<mckl::BackendSTD>(N, nwid, twid) && pass;
+#if MCKL_HAS_OMP
+    pass = pf_fused<mckl::BackendOMP>(N, nwid, twid) && pass;
+#endif
+#if MCKL_HAS_TBB
+    pass = pf_fused<mckl::BackendTBB>(N, nwid, twid) && pass;
+#endif
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_PF_FUSED_HPP
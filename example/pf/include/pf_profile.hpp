@@ -0,0 +1,167 @@
+//============================================================================
+// MCKL/example/pf/include/pf_profile.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef MCKL_EXAMPLE_PF_PROFILE_HPP
+#define MCKL_EXAMPLE_PF_PROFILE_HPP
+
+#include "pf_cv.hpp"
+
+template <typename Backend, mckl::MatrixLayout Layout>
+inline double pf_profile_run(
+    mckl::Sampler<PFCV<Layout, mckl::RNGSetVector<>>> &sampler, bool fused,
+    bool profile)
+{
+    using T = PFCV<Layout, mckl::RNGSetVector<>>;
+    using RNGSetType = mckl::RNGSetVector<>;
+
+    sampler.resample_method(mckl::Stratified, 0.5);
+    sampler.eval(PFCVInit<Backend, Layout, RNGSetType>(), mckl::SamplerInit);
+    sampler.eval(PFCVMove<Backend, Layout, RNGSetType>(), mckl::SamplerMove);
+    sampler.eval(PFCVWeight<Backend, Layout, RNGSetType>(),
+        mckl::SamplerInit | mckl::SamplerMove);
+    sampler.monitor("pos",
+        mckl::Monitor<T>(2, PFCVEval<Backend, Layout, RNGSetType>(), false,
+            mckl::MonitorMove));
+    sampler.template fused<Backend>(fused);
+    sampler.profile(profile);
+
+    const std::size_t n = sampler.particle().state().n();
+    sampler.reserve(n);
+    mckl::StopWatch watch;
+    watch.start();
+    sampler.initialize();
+    sampler.iterate(n - 1);
+    watch.stop();
+
+    return watch.milliseconds();
+}
+
+inline double pf_profile_sum(
+    const std::map<std::string, mckl::Vector<double>> &df,
+    const std::string &name)
+{
+    auto iter = df.find(name);
+    if (iter == df.end())
+        return mckl::const_nan<double>();
+
+    return std::accumulate(iter->second.begin(), iter->second.end(), 0.0);
+}
+
+template <typename Backend, mckl::MatrixLayout Layout>
+inline void pf_profile(std::size_t N, bool fused, int nwid, int twid)
+{
+    using T = PFCV<Layout, mckl::RNGSetVector<>>;
+
+    // Profiling shall not change the results, and the summary of a sampler
+    // not profiled shall have no additional columns
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> ref(N);
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> sampler(N);
+    const double toff = pf_profile_run<Backend, Layout>(ref, fused, false);
+    const double ton = pf_profile_run<Backend, Layout>(sampler, fused, true);
+
+    const std::map<std::string, mckl::Vector<double>> dref = ref.summary();
+    const std::map<std::string, mckl::Vector<double>> df = sampler.summary();
+
+    bool pass = dref.size() + 16 == df.size();
+    for (const auto &v : dref) {
+        auto iter = df.find(v.first);
+        pass = pass && iter != df.end() && iter->second == v.second;
+    }
+    for (const auto &v : df) {
+        if (v.first.compare(0, 5, "Time.") != 0 &&
+            v.first.compare(0, 7, "Cycles.") != 0) {
+            continue;
+        }
+        pass = pass && v.second.size() == sampler.iter_size();
+        for (std::size_t i = 0; i != v.second.size(); ++i) {
+            // Evaluation objects not run are not timed, including the move
+            // objects of a fused iteration
+            const bool eval0 = v.first.find(".Eval.0") != v.first.npos;
+            const bool eval1 = v.first.find(".Eval.1") != v.first.npos;
+            const bool eval2 = v.first.find(".Eval.2") != v.first.npos;
+            const bool nan = (eval0 && i != 0) || (eval1 && i == 0) ||
+                ((eval1 || eval2) && fused && i != 0);
+            pass = pass && (std::isnan(v.second[i]) == nan);
+        }
+    }
+
+    const double tmove = pf_profile_sum(df, "Time.Move");
+    const double tmonitor = pf_profile_sum(df, "Time.Monitor");
+    const double tresample = pf_profile_sum(df, "Time.Resample");
+
+    std::cout << std::setw(nwid) << std::left << pf_layout_name<Layout>();
+    std::cout << std::setw(nwid) << std::left << (fused ? "Fused" : "Normal");
+    std::cout << std::setw(nwid) << std::right << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << toff;
+    std::cout << std::setw(twid) << std::right << std::fixed << ton;
+    std::cout << std::setw(twid) << std::right << std::fixed << tmove;
+    std::cout << std::setw(twid) << std::right << std::fixed << tmonitor;
+    std::cout << std::setw(twid) << std::right << std::fixed << tresample;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+template <typename Backend>
+inline void pf_profile(std::size_t N, int nwid, int twid)
+{
+    for (std::size_t n = 1000; n <= N; n *= 10) {
+        pf_profile<Backend, mckl::RowMajor>(n, false, nwid, twid);
+        pf_profile<Backend, mckl::RowMajor>(n, true, nwid, twid);
+        pf_profile<Backend, mckl::ColMajor>(n, false, nwid, twid);
+        pf_profile<Backend, mckl::ColMajor>(n, true, nwid, twid);
+    }
+}
+
+inline void pf_profile(std::size_t N)
+{
+    const int nwid = 15;
+    const int twid = 15;
+    const std::size_t lwid = nwid * 3 + twid * 6;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "MatrixLayout";
+    std::cout << std::setw(nwid) << std::left << "Iteration";
+    std::cout << std::setw(nwid) << std::right << "N";
+    std::cout << std::setw(twid) << std::right << "Off (ms)";
+    std::cout << std::setw(twid) << std::right << "On (ms)";
+    std::cout << std::setw(twid) << std::right << "Move (ms)";
+    std::cout << std::setw(twid) << std::right << "Monitor (ms)";
+    std::cout << std::setw(twid) << std::right << "Resample (ms)";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    pf_profile<mckl::BackendSTD>(N, nwid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_PF_PROFILE_HPP
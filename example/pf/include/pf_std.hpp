@@ -0,0 +1,230 @@
+//============================================================================
+// MCKL/example/pf/include/pf_std.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_PF_STD_HPP
+#define MCKL_EXAMPLE_PF_STD_HPP
+
+#include "pf_cv.hpp"
+
+// The BackendSTD implementation prior to the persistent thread pool, which
+// launches one `std::async` task per hardware thread on each call
+class PFBackendAsync;
+
+template <>
+std::string pf_backend_name<PFBackendAsync>()
+{
+    return "BackendAsync";
+}
+
+namespace mckl
+{
+
+template <typename T, typename Derived>
+class SamplerEvalSMP<T, Derived, PFBackendAsync>
+    : public SamplerEvalBase<T, Derived>
+{
+    public:
+    void operator()(std::size_t iter, Particle<T> &particle)
+    {
+        run(iter, particle);
+    }
+
+    protected:
+    void run(std::size_t iter, Particle<T> &particle, std::size_t = 1)
+    {
+        using size_type = typename Particle<T>::size_type;
+
+        this->eval_first(iter, particle);
+        const size_type N = particle.size();
+        const size_type np = std::max(static_cast<size_type>(1),
+            static_cast<size_type>(std::thread::hardware_concurrency()));
+        Vector<std::future<void>> task_group;
+        size_type b = 0;
+        for (size_type id = 0; id != np; ++id) {
+            const size_type n = N / np + (id < N % np ? 1 : 0);
+            if (n == 0)
+                continue;
+            const size_type e = b + n;
+            task_group.push_back(std::async(
+                std::launch::async, [this, iter, &particle, b, e]() {
+                    this->eval_range(iter, particle.range(b, e));
+                }));
+            b = e;
+        }
+        for (auto &task : task_group)
+            task.wait();
+        this->eval_last(iter, particle);
+    }
+}; // class SamplerEvalSMP
+
+template <typename T, typename Derived>
+class MonitorEvalSMP<T, Derived, PFBackendAsync>
+    : public MonitorEvalBase<T, Derived>
+{
+    public:
+    void operator()(
+        std::size_t iter, std::size_t dim, Particle<T> &particle, double *r)
+    {
+        run(iter, dim, particle, r);
+    }
+
+    protected:
+    void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
+        double *r, std::size_t = 1)
+    {
+        using size_type = typename Particle<T>::size_type;
+
+        this->eval_first(iter, particle);
+        const size_type N = particle.size();
+        const size_type np = std::max(static_cast<size_type>(1),
+            static_cast<size_type>(std::thread::hardware_concurrency()));
+        Vector<std::future<void>> task_group;
+        size_type b = 0;
+        for (size_type id = 0; id != np; ++id) {
+            const size_type n = N / np + (id < N % np ? 1 : 0);
+            if (n == 0)
+                continue;
+            const size_type e = b + n;
+            task_group.push_back(std::async(
+                std::launch::async, [this, iter, dim, &particle, r, b, e]() {
+                    this->eval_range(iter, dim, particle.range(b, e),
+                        r + static_cast<std::size_t>(b) * dim);
+                }));
+            b = e;
+        }
+        for (auto &task : task_group)
+            task.wait();
+        this->eval_last(iter, particle);
+    }
+}; // class MonitorEvalSMP
+
+} // namespace mckl
+
+template <typename Backend, mckl::MatrixLayout Layout>
+inline double pf_std_run(std::size_t N, std::size_t repeat)
+{
+    using RNGSetType = mckl::RNGSetVector<>;
+    using T = PFCV<Layout, RNGSetType>;
+
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<T> sampler(N);
+    sampler.resample_method(mckl::Stratified, 0.5);
+    sampler.eval(PFCVInit<Backend, Layout, RNGSetType>(), mckl::SamplerInit);
+    sampler.eval(PFCVMove<Backend, Layout, RNGSetType>(), mckl::SamplerMove);
+    sampler.eval(PFCVWeight<Backend, Layout, RNGSetType>(),
+        mckl::SamplerInit | mckl::SamplerMove);
+    sampler.monitor(
+        "pos", mckl::Monitor<T>(2, PFCVEval<Backend, Layout, RNGSetType>()));
+
+    const std::size_t n = sampler.particle().state().n();
+    mckl::StopWatch watch;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        sampler.clear();
+        sampler.initialize();
+        watch.start();
+        sampler.iterate(n - 1);
+        watch.stop();
+    }
+
+    return watch.milliseconds() / (repeat * (n - 1));
+}
+
+template <mckl::MatrixLayout Layout>
+inline void pf_std_run(std::size_t N, std::size_t repeat, int nwid, int twid)
+{
+    const double tasync = pf_std_run<PFBackendAsync, Layout>(N, repeat);
+    const double tpool = pf_std_run<mckl::BackendSTD, Layout>(N, repeat);
+
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::left << pf_layout_name<Layout>();
+    std::cout << std::setw(twid) << std::right << std::fixed << tasync;
+    std::cout << std::setw(twid) << std::right << std::fixed << tpool;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << tasync / tpool;
+    std::cout << std::endl;
+}
+
+// Nested loops, called from chunks of an outer loop on any thread, shall be
+// executed serially and cover each index exactly once
+inline bool pf_std_nested()
+{
+    const std::size_t M = 64;
+    const std::size_t N = 1000;
+    mckl::Vector<std::size_t> count(M * N, 0);
+    mckl::internal::BackendFor<mckl::BackendSTD>::run(
+        M, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i != e; ++i) {
+                mckl::internal::BackendFor<mckl::BackendSTD>::run(
+                    N, 1, [&](std::size_t c, std::size_t d) {
+                        for (std::size_t j = c; j != d; ++j)
+                            ++count[i * N + j];
+                    });
+            }
+        });
+
+    return std::all_of(
+        count.begin(), count.end(), [](std::size_t c) { return c == 1; });
+}
+
+inline bool pf_std(std::size_t N, std::size_t repeat)
+{
+    const int nwid = 10;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 4;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << "Threads: "
+              << mckl::internal::BackendSTDPool::instance().size()
+              << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::left << "MatrixLayout";
+    std::cout << std::setw(twid) << std::right << "Async (ms)";
+    std::cout << std::setw(twid) << std::right << "Pool (ms)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    for (std::size_t n = 100; n <= N; n *= 10) {
+        pf_std_run<mckl::RowMajor>(n, repeat, nwid, twid);
+        pf_std_run<mckl::ColMajor>(n, repeat, nwid, twid);
+    }
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    const bool pass = pf_std_nested();
+    std::cout << std::setw(nwid) << std::left << "Nested";
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_PF_STD_HPP
@@ -49,6 +49,9 @@
         N, M, nwid, twid, distname);                                          \
     random_distribution_test_##test<mckl::ExponentialDistribution<RealType>>( \
         N, M, nwid, twid, distname);                                          \
+    random_distribution_test_##test<                                          \
+        mckl::ExponentialZigguratDistribution<RealType>>(                     \
+        N, M, nwid, twid, distname);                                          \
     random_distribution_test_##test<                                          \
         mckl::ExtremeValueDistribution<RealType>>(                            \
         N, M, nwid, twid, distname);                                          \
@@ -66,6 +69,9 @@
         N, M, nwid, twid, distname);                                          \
     random_distribution_test_##test<mckl::NormalDistribution<RealType>>(      \
         N, M, nwid, twid, distname);                                          \
+    random_distribution_test_##test<                                          \
+        mckl::NormalZigguratDistribution<RealType>>(                          \
+        N, M, nwid, twid, distname);                                          \
     random_distribution_test_##test<mckl::ParetoDistribution<RealType>>(      \
         N, M, nwid, twid, distname);                                          \
     random_distribution_test_##test<mckl::RayleighDistribution<RealType>>(    \
@@ -396,7 +402,9 @@ class RandomDistributionTrait<mckl::GammaDistribution<RealType>>
         this->add_param(params, 0.7, 1);
         this->add_param(params, 0.9, 1);
         this->add_param(params, 1.5, 1);
+        this->add_param(params, 2.5, 1);
         this->add_param(params, 15, 1);
+        this->add_param(params, 100, 1);
 
         return params;
     }
@@ -472,6 +480,39 @@ class RandomDistributionTrait<mckl::ExponentialDistribution<RealType>>
     }
 };
 
+template <typename RealType>
+class RandomDistributionTrait<mckl::ExponentialZigguratDistribution<RealType>>
+    : public RandomDistributionTraitBase<RealType, 1>
+{
+    public:
+    using dist_type = mckl::ExponentialZigguratDistribution<RealType>;
+    using std_type = std::exponential_distribution<RealType>;
+
+    std::string distname() const { return "ExponentialZiggurat"; }
+
+    mckl::Vector<RealType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_quantile(n,
+            [&](double p) {
+                return -static_cast<RealType>(std::log(1 - p)) / dist.lambda();
+            },
+            dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &) const
+    {
+        return this->probability_quantile(n);
+    }
+
+    mckl::Vector<std::array<RealType, 1>> params() const
+    {
+        mckl::Vector<std::array<RealType, 1>> params;
+        this->add_param(params, 1);
+
+        return params;
+    }
+};
+
 template <typename RealType>
 class RandomDistributionTrait<mckl::ExtremeValueDistribution<RealType>>
     : public RandomDistributionTraitBase<RealType, 2>
@@ -722,6 +763,41 @@ class RandomDistributionTrait<mckl::NormalDistribution<RealType>>
     }
 };
 
+template <typename RealType>
+class RandomDistributionTrait<mckl::NormalZigguratDistribution<RealType>>
+    : public RandomDistributionTraitBase<RealType, 2>
+{
+    public:
+    using dist_type = mckl::NormalZigguratDistribution<RealType>;
+    using std_type = std::normal_distribution<RealType>;
+
+    std::string distname() const { return "NormalZiggurat"; }
+
+    mckl::Vector<RealType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_quantile(n,
+            [&](double p) {
+                double q =
+                    mckl::const_sqrt_2<double>() * mckl::erfinv(2 * p - 1);
+                return dist.mean() + dist.stddev() * static_cast<RealType>(q);
+            },
+            dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &) const
+    {
+        return this->probability_quantile(n);
+    }
+
+    mckl::Vector<std::array<RealType, 2>> params() const
+    {
+        mckl::Vector<std::array<RealType, 2>> params;
+        this->add_param(params, 0, 1);
+
+        return params;
+    }
+};
+
 template <typename RealType>
 class RandomDistributionTrait<mckl::ParetoDistribution<RealType>>
     : public RandomDistributionTraitBase<RealType, 2>
@@ -1346,7 +1422,146 @@ inline void random_distribution_pval_int(std::size_t N, std::size_t M,
     MCKL_DEFINE_EXAMPLE_RANDOM_DISTRIBUTION_TEST_INT(pval);
 }
 
-inline void random_distribution(
+inline double random_distribution_discrete_chi2(
+    const mckl::Vector<double> &weights, const mckl::Vector<int> &r)
+{
+    const std::size_t k = weights.size();
+    const double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    mckl::Vector<std::size_t> count(k, 0);
+    for (auto i : r) {
+        if (i < 0 || static_cast<std::size_t>(i) >= k)
+            return 1;
+        ++count[static_cast<std::size_t>(i)];
+    }
+
+    // Categories of zero weight shall never be drawn
+    double s = 0;
+    std::size_t df = 0;
+    for (std::size_t i = 0; i != k; ++i) {
+        if (weights[i] > 0) {
+            const double e = r.size() * weights[i] / sum;
+            const double c = static_cast<double>(count[i]);
+            s += (c - e) * (c - e) / e;
+            ++df;
+        } else if (count[i] != 0) {
+            return 1;
+        }
+    }
+
+    return mckl::gammap(0.5 * (df - 1), 0.5 * s);
+}
+
+template <typename DistType>
+inline bool random_distribution_discrete(std::size_t N,
+    const mckl::Vector<double> &weights, int nwid, int twid,
+    const std::string &name)
+{
+    mckl::RNG rng;
+    DistType dist(weights.begin(), weights.end());
+    mckl::Vector<int> r(N);
+
+    for (std::size_t i = 0; i != N; ++i)
+        r[i] = dist(rng);
+    const double single = random_distribution_discrete_chi2(weights, r);
+
+    mckl::rand(rng, dist, N, r.data());
+    const double batch = random_distribution_discrete_chi2(weights, r);
+
+    // A distribution set through param() draws the same samples
+    DistType other;
+    other.param(dist.param());
+    bool param = other == dist && other.param() == dist.param();
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    for (std::size_t i = 0; i != 100; ++i)
+        param = param && dist(rng1) == other(rng2);
+
+    // Reading weights of zero sum fails and leaves the distribution as is
+    std::stringstream ss;
+    ss << mckl::Vector<double>(weights.size(), 0.0);
+    ss >> other;
+    const bool zero = !ss && other == dist;
+
+    const bool pass = single < 1 - 1e-4 && batch < 1 - 1e-4 && param && zero;
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(twid) << std::right << std::fixed << single;
+    std::cout << std::setw(twid) << std::right << std::fixed << batch;
+    std::cout << std::setw(twid) << std::right
+              << (param ? "Passed" : "Failed");
+    std::cout << std::setw(twid) << std::right
+              << (zero ? "Passed" : "Failed");
+    std::cout << std::setw(twid) << std::right
+              << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+template <typename DistType>
+inline bool random_distribution_discrete(std::size_t N, int nwid, int twid,
+    const std::string &distname)
+{
+    mckl::Vector<double> uniform(10, 1.0);
+    mckl::Vector<double> skewed(20);
+    for (std::size_t i = 0; i != skewed.size(); ++i)
+        skewed[i] = static_cast<double>((i + 1) * (i + 1));
+    mckl::Vector<double> sparse{0, 1, 0, 2, 0, 3, 0, 0, 4};
+
+    bool pass = true;
+    pass = random_distribution_discrete<DistType>(
+               N, uniform, nwid, twid, distname + "(Uniform)") &&
+        pass;
+    pass = random_distribution_discrete<DistType>(
+               N, skewed, nwid, twid, distname + "(Skewed)") &&
+        pass;
+    pass = random_distribution_discrete<DistType>(
+               N, sparse, nwid, twid, distname + "(Sparse)") &&
+        pass;
+
+    return pass;
+}
+
+inline bool random_distribution_discrete(std::size_t N, std::size_t M,
+    int nwid, int twid, const mckl::Vector<std::string> &distname)
+{
+    const bool discrete = distname.empty() ||
+        std::find(distname.begin(), distname.end(), "Discrete") !=
+            distname.end();
+    const bool alias = distname.empty() ||
+        std::find(distname.begin(), distname.end(), "DiscreteAlias") !=
+            distname.end();
+    if (!discrete && !alias)
+        return true;
+
+    const std::size_t lwid = static_cast<std::size_t>(nwid + twid * 5);
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Distribution";
+    std::cout << std::setw(twid) << std::right << "Single";
+    std::cout << std::setw(twid) << std::right << "Batch";
+    std::cout << std::setw(twid) << std::right << "Param";
+    std::cout << std::setw(twid) << std::right << "Zero sum";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    if (discrete) {
+        pass = random_distribution_discrete<mckl::DiscreteDistribution<int>>(
+                   N * M, nwid, twid, "Discrete") &&
+            pass;
+    }
+    if (alias) {
+        pass = random_distribution_discrete<
+                   mckl::DiscreteAliasDistribution<int>>(
+                   N * M, nwid, twid, "DiscreteAlias") &&
+            pass;
+    }
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+inline bool random_distribution(
     std::size_t N, std::size_t M, int argc, char **argv)
 {
     mckl::Vector<std::string> distname;
@@ -1363,6 +1578,8 @@ inline void random_distribution(
     random_distribution_pval_real<double>(N, M, nwid, twid, distname);
     random_distribution_pval_int<int>(N, M, nwid, twid, distname);
     random_distribution_pval_int<unsigned>(N, M, nwid, twid, distname);
+
+    return random_distribution_discrete(N, M, nwid, twid, distname);
 }
 
 #endif // MCKL_EXAMPLE_RANDOM_DISTRIBUTION_HPP
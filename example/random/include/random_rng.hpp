@@ -170,25 +170,34 @@ inline void random_rng(std::size_t N, std::size_t M, int nwid, int swid,
 
     RNGType rng1;
     RNGType rng2;
+    RNGType rng3;
+    RNGType rng4;
 
     mckl::Vector<std::uint64_t> r1;
     mckl::Vector<std::uint64_t> r2;
+    mckl::Vector<typename RNGType::result_type> r3;
     r1.reserve(N);
     r2.reserve(N);
+    r3.reserve(N);
 
     double g1 = 0;
     double g2 = 0;
+    double g3 = 0;
     double c1 = std::numeric_limits<double>::max();
     double c2 = std::numeric_limits<double>::max();
+    double c3 = std::numeric_limits<double>::max();
     for (std::size_t k = 0; k != 10; ++k) {
         std::size_t num = 0;
         mckl::StopWatch watch1;
         mckl::StopWatch watch2;
+        mckl::StopWatch watch3;
+        std::size_t num3 = 0;
         for (std::size_t i = 0; i != M; ++i) {
             std::size_t K = rsize(rng);
             num += K;
             r1.resize(K);
             r2.resize(K);
+            r3.resize(K);
 
             watch1.start();
             for (std::size_t j = 0; j != K; ++j)
@@ -200,6 +209,15 @@ inline void random_rng(std::size_t N, std::size_t M, int nwid, int swid,
             watch2.stop();
             pass = pass && (r1 == r2 || rng != rng);
 
+            watch3.start();
+            mckl::rand(rng3, K, r3.data());
+            watch3.stop();
+            num3 += K;
+            bool bulk = true;
+            for (std::size_t j = 0; j != K; ++j)
+                bulk = rng4() == r3[j] && bulk;
+            pass = pass && (bulk || rng != rng);
+
             rng1.discard(static_cast<unsigned>(K));
             typename RNGType::result_type next = rng1();
             for (std::size_t j = 0; j != K; ++j)
@@ -217,10 +235,14 @@ inline void random_rng(std::size_t N, std::size_t M, int nwid, int swid,
             pass = pass && (r1 == r2 || rng != rng);
         }
         double bytes = static_cast<double>(sizeof(std::uint64_t) * num);
+        double bytes3 = static_cast<double>(
+            sizeof(typename RNGType::result_type) * num3);
         g1 = std::max(g1, bytes / watch1.nanoseconds());
         g2 = std::max(g2, bytes / watch2.nanoseconds());
         c1 = std::min(c1, watch1.cycles() / bytes);
         c2 = std::min(c2, watch2.cycles() / bytes);
+        g3 = std::max(g3, bytes3 / watch3.nanoseconds());
+        c3 = std::min(c3, watch3.cycles() / bytes3);
     }
 
     std::cout << std::setw(nwid) << std::left << name;
@@ -228,12 +250,141 @@ inline void random_rng(std::size_t N, std::size_t M, int nwid, int swid,
     std::cout << std::setw(swid) << std::right << alignof(RNGType);
     std::cout << std::setw(twid) << std::right << g1;
     std::cout << std::setw(twid) << std::right << g2;
+    std::cout << std::setw(twid) << std::right << g3;
+    std::cout << std::setw(twid) << std::right << c1;
+    std::cout << std::setw(twid) << std::right << c2;
+    std::cout << std::setw(twid) << std::right << c3;
+    std::cout << std::setw(twid) << std::right << random_pass(pass);
+    std::cout << std::endl;
+}
+
+#if MCKL_HAS_AESNI && MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F)
+
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+#endif
+
+// Encrypt `n * B` blocks with 128-bit AES-NI instructions, the same as
+// AESNIGenerator does without VAES
+template <std::size_t B, std::size_t Rp1>
+inline void random_rng_aesni(std::array<std::uint64_t, 2> &ctr, std::size_t n,
+    void *buffer, const std::array<__m128i, Rp1> &rk)
+{
+    std::array<std::array<std::uint64_t, 2>, B> ctr_block;
+    std::array<__m128i, B> s;
+    __m128i *r = static_cast<__m128i *>(buffer);
+    for (std::size_t i = 0; i != n; ++i, r += B) {
+        mckl::increment(ctr, ctr_block);
+        for (std::size_t j = 0; j != B; ++j) {
+            s[j] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(ctr_block[j].data()));
+        }
+        for (std::size_t j = 0; j != B; ++j)
+            s[j] = _mm_xor_si128(s[j], rk.front());
+        for (std::size_t k = 1; k < Rp1 - 1; ++k)
+            for (std::size_t j = 0; j != B; ++j)
+                s[j] = _mm_aesenc_si128(s[j], rk[k]);
+        for (std::size_t j = 0; j != B; ++j)
+            s[j] = _mm_aesenclast_si128(s[j], rk.back());
+        for (std::size_t j = 0; j != B; ++j)
+            _mm_storeu_si128(r + j, s[j]);
+    }
+}
+
+template <typename KeySeqType, std::size_t Rounds>
+inline void random_rng_vaes(std::size_t N, std::size_t M, int nwid, int twid,
+    const std::string &name)
+{
+    const std::size_t B = MCKL_AESNI_BLOCKS;
+    const std::size_t V = mckl::internal::AESNIVAESBlocks;
+    const std::size_t L = B * V;
+    const std::size_t n = std::max(L, N / L * L);
+
+    KeySeqType seq;
+    seq.reset(typename KeySeqType::key_type());
+    std::array<__m128i, Rounds + 1> tmp;
+    const std::array<__m128i, Rounds + 1> &rk = seq(tmp);
+
+    mckl::Vector<std::array<std::uint64_t, 2>> r1(n);
+    mckl::Vector<std::array<std::uint64_t, 2>> r2(n);
+    bool pass = true;
+    double g1 = 0;
+    double g2 = 0;
+    double c1 = std::numeric_limits<double>::max();
+    double c2 = std::numeric_limits<double>::max();
+    for (std::size_t k = 0; k != 10; ++k) {
+        std::array<std::uint64_t, 2> ctr1 = {{0, 0}};
+        std::array<std::uint64_t, 2> ctr2 = {{0, 0}};
+        mckl::StopWatch watch1;
+        mckl::StopWatch watch2;
+        for (std::size_t i = 0; i != M; ++i) {
+            watch1.start();
+            random_rng_aesni<B>(ctr1, n / B, r1.data(), rk);
+            watch1.stop();
+
+            watch2.start();
+            mckl::internal::AESNIGeneratorVAES<Rounds + 1, V>::eval(
+                ctr2, n / V, r2.data(), rk);
+            watch2.stop();
+            pass = pass && r1 == r2 && ctr1 == ctr2;
+        }
+        const double bytes = static_cast<double>(sizeof(__m128i) * n * M);
+        g1 = std::max(g1, bytes / watch1.nanoseconds());
+        g2 = std::max(g2, bytes / watch2.nanoseconds());
+        c1 = std::min(c1, watch1.cycles() / bytes);
+        c2 = std::min(c2, watch2.cycles() / bytes);
+    }
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(twid) << std::right << g1;
+    std::cout << std::setw(twid) << std::right << g2;
     std::cout << std::setw(twid) << std::right << c1;
     std::cout << std::setw(twid) << std::right << c2;
+    std::cout << std::setw(twid) << std::right << c1 / c2;
     std::cout << std::setw(twid) << std::right << random_pass(pass);
     std::cout << std::endl;
 }
 
+// Throughput of the VAES implementation of AESNIGenerator against 128-bit
+// AES-NI instructions, with the same round keys and counters
+inline void random_rng_vaes(std::size_t N, std::size_t M)
+{
+    const int nwid = 20;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 6;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Generator";
+    std::cout << std::setw(twid) << std::right << "GB/s (AES-NI)";
+    std::cout << std::setw(twid) << std::right << "GB/s (VAES)";
+    std::cout << std::setw(twid) << std::right << "cpB (AES-NI)";
+    std::cout << std::setw(twid) << std::right << "cpB (VAES)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Deterministics";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    random_rng_vaes<mckl::AES128KeySeq<MCKL_AES128_ROUNDS>,
+        MCKL_AES128_ROUNDS>(N, M, nwid, twid, "AES128");
+    random_rng_vaes<mckl::AES192KeySeq<MCKL_AES192_ROUNDS>,
+        MCKL_AES192_ROUNDS>(N, M, nwid, twid, "AES192");
+    random_rng_vaes<mckl::AES256KeySeq<MCKL_AES256_ROUNDS>,
+        MCKL_AES256_ROUNDS>(N, M, nwid, twid, "AES256");
+    random_rng_vaes<mckl::ARSKeySeq<>, MCKL_ARS_ROUNDS>(
+        N, M, nwid, twid, "ARS");
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#endif // MCKL_HAS_AESNI && MCKL_HAS_VAES && (MCKL_HAS_AVX2 || ...)
+
 inline void random_rng(std::size_t N, std::size_t M, int argc, char **argv)
 {
     mckl::Vector<std::string> rngname;
@@ -243,7 +394,7 @@ inline void random_rng(std::size_t N, std::size_t M, int argc, char **argv)
     const int nwid = 20;
     const int swid = 8;
     const int twid = 15;
-    const std::size_t lwid = nwid + swid * 2 + twid * 5;
+    const std::size_t lwid = nwid + swid * 2 + twid * 7;
 
     std::cout << std::string(lwid, '=') << std::endl;
     std::cout << std::setw(nwid) << std::left << "RNGType";
@@ -251,8 +402,10 @@ inline void random_rng(std::size_t N, std::size_t M, int argc, char **argv)
     std::cout << std::setw(swid) << std::right << "Align";
     std::cout << std::setw(twid) << std::right << "GB/s (Loop)";
     std::cout << std::setw(twid) << std::right << "GB/s (Batch)";
+    std::cout << std::setw(twid) << std::right << "GB/s (Bulk)";
     std::cout << std::setw(twid) << std::right << "cpB (Loop)";
     std::cout << std::setw(twid) << std::right << "cpB (Batch)";
+    std::cout << std::setw(twid) << std::right << "cpB (Bulk)";
     std::cout << std::setw(twid) << std::right << "Deterministics";
     std::cout << std::endl;
 
@@ -277,6 +430,10 @@ inline void random_rng(std::size_t N, std::size_t M, int argc, char **argv)
 #include <mckl/random/internal/rng_define_macro_mkl.hpp>
 
     std::cout << std::string(lwid, '-') << std::endl;
+
+#if MCKL_HAS_AESNI && MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F)
+    random_rng_vaes(N, M);
+#endif
 }
 
 #endif // MCKL_EXAMPLE_RANDOM_RNG_HPP
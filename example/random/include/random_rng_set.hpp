@@ -0,0 +1,242 @@
+//============================================================================
+// MCKL/example/random/include/random_rng_set.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION); HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE);
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+
+#ifndef MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
+#define MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
+
+#include <mckl/random/rng_set.hpp>
+#include <mckl/smp.hpp>
+#include "random_common.hpp"
+
+// Process blocks of `grainsize` particles with `T` threads, each taking every
+// `T`-th block
+template <std::size_t T>
+class RandomRNGSetThreads
+{
+    public:
+    template <typename WorkType>
+    static void run(std::size_t N, std::size_t grainsize, WorkType &&work)
+    {
+        const std::size_t g = std::max(grainsize, static_cast<std::size_t>(1));
+        mckl::Vector<std::thread> threads;
+        for (std::size_t t = 0; t != T; ++t) {
+            threads.emplace_back([&, t]() {
+                for (std::size_t b = t * g; b < N; b += T * g)
+                    work(b, std::min(b + g, N));
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+}; // class RandomRNGSetThreads
+
+template <typename Backend>
+class RandomRNGSetFor : public mckl::internal::BackendFor<Backend>
+{
+}; // class RandomRNGSetFor
+
+template <std::size_t T>
+class RandomRNGSetFor<RandomRNGSetThreads<T>> : public RandomRNGSetThreads<T>
+{
+}; // class RandomRNGSetFor
+
+// Draw from two sets over two single pass steps and one step of two passes.
+// Each particle is accessed once before and once after all others within its
+// block, and each result is stored by its step, pass, particle and call
+template <typename RNGType, typename Backend>
+inline void random_rng_set_run(std::size_t N, std::size_t grainsize,
+    mckl::Vector<typename RNGType::result_type> &r1,
+    mckl::Vector<typename RNGType::result_type> &r2,
+    mckl::Vector<typename RNGType::result_type> &r3)
+{
+    mckl::Seed::instance().set(101);
+    mckl::RNGSetCounter<RNGType> set1(N);
+    mckl::RNGSetCounter<RNGType> set2(N);
+    mckl::RNGSetCounter<RNGType> set3(set1);
+    r1.resize(N * 8);
+    r2.resize(N * 2);
+    r3.resize(N * 8);
+
+    for (std::size_t k = 0; k != 2; ++k) {
+        set1.step();
+        set2.step();
+        RandomRNGSetFor<Backend>::run(
+            N, grainsize, [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i != e; ++i) {
+                    r1[(k * N + i) * 2] = set1[i]();
+                    r2[k * N + i] = set2[i]();
+                }
+                for (std::size_t i = b; i != e; ++i)
+                    r1[(k * N + i) * 2 + 1] = set1[i]();
+            });
+    }
+
+    set1.step(2);
+    RandomRNGSetFor<Backend>::run(
+        N, grainsize, [&](std::size_t b, std::size_t e) {
+            for (std::size_t p = 0; p != 2; ++p) {
+                set1.pass(p);
+                const std::size_t k = 2 + p;
+                for (std::size_t i = b; i != e; ++i)
+                    r1[(k * N + i) * 2] = set1[i]();
+                for (std::size_t i = b; i != e; ++i)
+                    r1[(k * N + i) * 2 + 1] = set1[i]();
+            }
+        });
+
+    // The same streams without passes
+    for (std::size_t k = 0; k != 4; ++k) {
+        set3.step();
+        RandomRNGSetFor<Backend>::run(
+            N, grainsize, [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i != e; ++i)
+                    r3[(k * N + i) * 2] = set3[i]();
+                for (std::size_t i = b; i != e; ++i)
+                    r3[(k * N + i) * 2 + 1] = set3[i]();
+            });
+    }
+}
+
+template <typename RNGType, typename Backend>
+inline bool random_rng_set(std::size_t N, int nwid, int swid, int twid,
+    const std::string &name,
+    const mckl::Vector<typename RNGType::result_type> &r1,
+    const mckl::Vector<typename RNGType::result_type> &r2)
+{
+    using result_type = typename RNGType::result_type;
+
+    bool pass = true;
+    for (std::size_t grainsize : {std::size_t(1), std::size_t(7),
+             std::size_t(64), N}) {
+        mckl::Vector<result_type> s1;
+        mckl::Vector<result_type> s2;
+        mckl::Vector<result_type> s3;
+        random_rng_set_run<RNGType, Backend>(N, grainsize, s1, s2, s3);
+        const bool same = s1 == r1 && s2 == r2;
+        const bool passes = s3 == s1;
+        pass = pass && same && passes;
+
+        std::cout << std::setw(nwid) << std::left << name;
+        std::cout << std::setw(swid) << std::right << grainsize;
+        std::cout << std::setw(twid) << std::right << random_pass(same);
+        std::cout << std::setw(twid) << std::right << random_pass(passes);
+        std::cout << std::endl;
+    }
+
+    return pass;
+}
+
+template <typename RNGType>
+inline bool random_rng_set(std::size_t N, int nwid, int swid, int twid)
+{
+    using result_type = typename RNGType::result_type;
+
+    // The reference is a single block processed sequentially
+    mckl::Vector<result_type> r1;
+    mckl::Vector<result_type> r2;
+    mckl::Vector<result_type> r3;
+    random_rng_set_run<RNGType, mckl::BackendSEQ>(N, N, r1, r2, r3);
+
+    // A revisited particle, the streams of consecutive steps and passes and
+    // those of different sets shall all be distinct
+    bool distinct = true;
+    for (std::size_t i = 0; i != N; ++i) {
+        for (std::size_t k = 0; k != 4; ++k) {
+            const std::size_t j = (k * N + i) * 2;
+            distinct = distinct && r1[j] != r1[j + 1];
+            if (k != 0)
+                distinct = distinct && r1[j] != r1[j - N * 2];
+        }
+        for (std::size_t k = 0; k != 2; ++k)
+            distinct = distinct && r1[(k * N + i) * 2] != r2[k * N + i];
+    }
+
+    std::cout << std::setw(nwid) << std::left << "Distinct";
+    std::cout << std::setw(swid) << std::right << N;
+    std::cout << std::setw(twid) << std::right << random_pass(distinct);
+    std::cout << std::setw(twid) << std::right << "";
+    std::cout << std::endl;
+
+    bool pass = distinct;
+    pass = random_rng_set<RNGType, mckl::BackendSEQ>(
+               N, nwid, swid, twid, "SEQ", r1, r2) &&
+        pass;
+    pass = random_rng_set<RNGType, mckl::BackendSTD>(
+               N, nwid, swid, twid, "STD", r1, r2) &&
+        pass;
+#if MCKL_HAS_OMP
+    pass = random_rng_set<RNGType, mckl::BackendOMP>(
+               N, nwid, swid, twid, "OMP", r1, r2) &&
+        pass;
+#endif
+#if MCKL_HAS_TBB
+    pass = random_rng_set<RNGType, mckl::BackendTBB>(
+               N, nwid, swid, twid, "TBB", r1, r2) &&
+        pass;
+#endif
+    pass = random_rng_set<RNGType, RandomRNGSetThreads<1>>(
+               N, nwid, swid, twid, "Threads 1", r1, r2) &&
+        pass;
+    pass = random_rng_set<RNGType, RandomRNGSetThreads<2>>(
+               N, nwid, swid, twid, "Threads 2", r1, r2) &&
+        pass;
+    pass = random_rng_set<RNGType, RandomRNGSetThreads<4>>(
+               N, nwid, swid, twid, "Threads 4", r1, r2) &&
+        pass;
+
+    return pass;
+}
+
+inline bool random_rng_set(std::size_t N)
+{
+    const int nwid = 20;
+    const int swid = 10;
+    const int twid = 15;
+    const std::size_t lwid = nwid + swid + twid * 2;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Backend";
+    std::cout << std::setw(swid) << std::right << "Grain";
+    std::cout << std::setw(twid) << std::right << "Deterministic";
+    std::cout << std::setw(twid) << std::right << "Passes";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    bool pass = random_rng_set<mckl::RNG>(N, nwid, swid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+    pass = random_rng_set<mckl::Philox2x32>(N, nwid, swid, twid) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
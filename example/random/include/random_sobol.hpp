@@ -0,0 +1,237 @@
+//============================================================================
+// MCKL/example/random/include/random_sobol.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_SOBOL_HPP
+#define MCKL_EXAMPLE_RANDOM_SOBOL_HPP
+
+#include <mckl/random/rng.hpp>
+#include <mckl/random/sobol.hpp>
+#include <mckl/resample/u01_sequence.hpp>
+#include "random_common.hpp"
+
+// Batch generation, discard and index shall agree with successive calls
+template <typename UIntType>
+inline bool random_sobol_skip(std::size_t N, std::size_t dim, bool scramble)
+{
+    mckl::SobolEngine<UIntType> eng1(dim);
+    mckl::SobolEngine<UIntType> eng2(dim);
+    if (scramble) {
+        eng1.seed(101);
+        eng2.seed(101);
+    }
+    mckl::SobolEngine<UIntType> eng3(eng1);
+    mckl::SobolEngine<UIntType> eng4(eng1);
+
+    const std::size_t n = N * dim;
+    mckl::Vector<UIntType> r1(n + 1);
+    mckl::Vector<UIntType> r2(n + 1);
+    eng1(1, r1.data());
+    eng1(n / 2, r1.data() + 1);
+    eng1(n - n / 2, r1.data() + 1 + n / 2);
+    for (std::size_t i = 0; i != n + 1; ++i)
+        r2[i] = eng2();
+    bool pass = r1 == r2 && eng1 == eng2;
+
+    eng3.discard(static_cast<UIntType>(n / 3));
+    pass = pass && eng3() == r2[n / 3];
+
+    eng4.index(static_cast<UIntType>(N / 2));
+    pass = pass && eng4() == r2[N / 2 * dim];
+
+    return pass;
+}
+
+// Each block of 2^m points starting at index k 2^m has exactly one point
+// within each interval [i / 2^m, (i + 1) / 2^m) in each dimension
+template <typename UIntType>
+inline bool random_sobol_net(std::size_t N, std::size_t dim, bool scramble)
+{
+    static constexpr int W = std::numeric_limits<UIntType>::digits;
+
+    int m = 0;
+    while ((static_cast<std::size_t>(2) << m) <= N)
+        ++m;
+    const std::size_t M = static_cast<std::size_t>(1) << m;
+
+    mckl::RNG rng;
+    mckl::SobolEngine<UIntType> eng(dim);
+    mckl::Vector<UIntType> r(M * dim);
+    mckl::Vector<std::size_t> count(M);
+    bool pass = true;
+    for (std::size_t k = 0; k != 4; ++k) {
+        if (scramble)
+            eng.scramble(rng);
+        eng.index(static_cast<UIntType>(k * k * M));
+        eng(M * dim, r.data());
+        for (std::size_t d = 0; d != dim; ++d) {
+            std::fill(count.begin(), count.end(), 0);
+            for (std::size_t i = 0; i != M; ++i)
+                ++count[static_cast<std::size_t>(r[i * dim + d] >> (W - m))];
+            for (std::size_t i = 0; i != M; ++i)
+                pass = pass && count[i] == 1;
+        }
+    }
+
+    return pass;
+}
+
+// The variance of the randomized quasi Monte Carlo estimates of the integral
+// of prod_j (1 + (|4 u_j - 2| - 1) / j^2) over the unit cube, relative to
+// the Monte Carlo
+template <typename UIntType>
+inline double random_sobol_variance(std::size_t N, std::size_t dim)
+{
+    const std::size_t R = 20;
+
+    mckl::RNG rng;
+    mckl::U01Distribution<double> u01;
+    mckl::Vector<double> r(N * dim);
+    double vqmc = 0;
+    double vmc = 0;
+    for (std::size_t k = 0; k != R; ++k) {
+        mckl::SobolEngine<UIntType> eng(dim);
+        eng.scramble(rng);
+        for (std::size_t l = 0; l != 2; ++l) {
+            if (l == 0)
+                mckl::rand(eng, u01, N * dim, r.data());
+            else
+                mckl::rand(rng, u01, N * dim, r.data());
+            double e = 0;
+            for (std::size_t i = 0; i != N; ++i) {
+                double p = 1;
+                for (std::size_t d = 0; d != dim; ++d) {
+                    const double j = static_cast<double>(d + 1);
+                    p *= 1 + (std::abs(4 * r[i * dim + d] - 2) - 1) / (j * j);
+                }
+                e += p;
+            }
+            e = e / N - 1;
+            (l == 0 ? vqmc : vmc) += e * e;
+        }
+    }
+
+    return vqmc / vmc;
+}
+
+template <typename UIntType>
+inline void random_sobol(std::size_t N, std::size_t dim, int nwid, int swid,
+    int twid, const std::string &name)
+{
+    bool skip = random_sobol_skip<UIntType>(N, dim, false) &&
+        random_sobol_skip<UIntType>(N, dim, true);
+    bool net = random_sobol_net<UIntType>(N, dim, false) &&
+        random_sobol_net<UIntType>(N, dim, true);
+    double ratio = random_sobol_variance<UIntType>(N, dim);
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(swid) << std::right << dim;
+    std::cout << std::setw(twid) << std::right << random_pass(skip);
+    std::cout << std::setw(twid) << std::right << random_pass(net);
+    std::cout << std::setw(twid) << std::right << std::scientific
+              << std::setprecision(2) << ratio;
+    std::cout << std::setw(twid) << std::right << random_pass(ratio < 0.5);
+    std::cout << std::endl;
+}
+
+// The sequence of U01SequenceSobol shall be sorted and stratified, and the
+// const overloads with local storage shall generate the same sequence
+template <typename RealType>
+inline bool random_sobol_u01_sequence(std::size_t N)
+{
+    mckl::RNG rng;
+    mckl::U01SequenceSobol u01seq;
+    const mckl::U01SequenceSobol &cseq = u01seq;
+    mckl::Vector<RealType> r(N);
+    mckl::Vector<RealType> s(N);
+    bool pass = true;
+    for (std::size_t n = 1; n <= N; n = n * 3 + 1) {
+        std::size_t M = 1;
+        while (M < n)
+            M *= 2;
+        for (std::size_t k = 0; k != 2; ++k) {
+            if (k == 0) {
+                mckl::RNG rng2(rng);
+                u01seq(rng, n, r.data());
+                cseq(rng2, n, s.data());
+            } else {
+                RealType u = static_cast<RealType>(0.3);
+                u01seq(n, &u, r.data());
+                cseq(n, &u, s.data());
+            }
+            pass = pass && std::equal(r.begin(), r.begin() + n, s.begin());
+            pass = pass && std::is_sorted(r.begin(), r.begin() + n);
+            for (std::size_t i = 0; i != n; ++i) {
+                pass = pass && r[i] >= 0 && r[i] < 1;
+                if (i != 0) {
+                    pass = pass &&
+                        static_cast<std::size_t>(r[i] * M) >
+                            static_cast<std::size_t>(r[i - 1] * M);
+                }
+            }
+        }
+    }
+
+    return pass;
+}
+
+inline void random_sobol(std::size_t N, std::size_t M, int, char **)
+{
+    const int nwid = 20;
+    const int swid = 8;
+    const int twid = 15;
+    const std::size_t lwid = nwid + swid + twid * 4;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Engine";
+    std::cout << std::setw(swid) << std::right << "Dim";
+    std::cout << std::setw(twid) << std::right << "Skip";
+    std::cout << std::setw(twid) << std::right << "Net";
+    std::cout << std::setw(twid) << std::right << "Var (QMC/MC)";
+    std::cout << std::setw(twid) << std::right << "Variance";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    for (std::size_t dim : {static_cast<std::size_t>(1), M, M * 4}) {
+        dim = std::min(dim, mckl::Sobol32::max_dim());
+        random_sobol<std::uint32_t>(N, dim, nwid, swid, twid, "Sobol32");
+        random_sobol<std::uint64_t>(N, dim, nwid, swid, twid, "Sobol64");
+    }
+    std::cout << std::string(lwid, '-') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "U01SequenceSobol";
+    std::cout << std::setw(swid) << std::right << 1;
+    std::cout << std::setw(twid) << std::right
+              << random_pass(random_sobol_u01_sequence<float>(N) &&
+                     random_sobol_u01_sequence<double>(N) &&
+                     random_sobol_u01_sequence<long double>(N));
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_SOBOL_HPP
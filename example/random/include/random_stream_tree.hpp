@@ -0,0 +1,203 @@
+//============================================================================
+// MCKL/example/random/include/random_stream_tree.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_STREAM_TREE_HPP
+#define MCKL_EXAMPLE_RANDOM_STREAM_TREE_HPP
+
+#include <mckl/random/rng.hpp>
+#include <mckl/random/seed.hpp>
+#include <mckl/random/stream_tree.hpp>
+#include "random_common.hpp"
+
+template <typename RNGType>
+inline bool random_stream_tree_leaf(const mckl::StreamTree<RNGType> &leaf,
+    std::size_t N, mckl::Vector<typename RNGType::ctr_type> &blocks)
+{
+    using result_type = typename RNGType::result_type;
+    using ctr_type = typename RNGType::ctr_type;
+
+    const std::size_t M =
+        RNGType::generator_type::size() / sizeof(result_type);
+    const std::size_t B = RNGType::generator_type::size() / sizeof(ctr_type);
+
+    // The engine of the leaf shall produce exactly the blocks of the
+    // counters following the first one owned by the leaf. A buffer of a
+    // multi-block generator uses B consecutive counters
+    RNGType rng = leaf.engine();
+    RNGType ref(leaf.key());
+    mckl::Vector<result_type> r1(M);
+    mckl::Vector<result_type> r2(M);
+    ctr_type ctr = leaf.ctr();
+    bool pass = true;
+    for (std::size_t i = 0; i != N; ++i) {
+        ref.ctr(ctr);
+        rng(M, r1.data());
+        ref(M, r2.data());
+        pass = pass && r1 == r2;
+        for (std::size_t j = 0; j != B; ++j) {
+            blocks.push_back(ctr);
+            mckl::increment(ctr);
+        }
+    }
+
+    return pass;
+}
+
+template <typename RNGType>
+class RandomStreamTreeEnable : public std::true_type
+{
+}; // class RandomStreamTreeEnable
+
+#if MCKL_HAS_RDRAND
+template <typename UIntType>
+class RandomStreamTreeEnable<mckl::RDRANDEngine<UIntType>>
+    : public std::false_type
+{
+}; // class RandomStreamTreeEnable
+#endif
+
+template <typename RNGType>
+inline bool random_stream_tree(std::size_t, std::size_t, int, int, int,
+    const std::string &, std::false_type)
+{
+    return true;
+}
+
+template <typename RNGType>
+inline bool random_stream_tree(std::size_t N, std::size_t M, int nwid,
+    int swid, int twid, const std::string &name, std::true_type)
+{
+    using key_type = typename RNGType::key_type;
+    using ctr_type = typename RNGType::ctr_type;
+
+    // Three levels, such as processes, samplers and particles
+    const unsigned b1 = 3;
+    const unsigned b2 = 2;
+    const unsigned b3 = 3;
+
+    RNGType rng;
+    key_type key;
+    std::uniform_int_distribution<unsigned> rbyte(0, 255);
+    unsigned char *k = reinterpret_cast<unsigned char *>(key.data());
+    for (std::size_t i = 0; i != sizeof(key_type); ++i)
+        k[i] = static_cast<unsigned char>(rbyte(rng));
+
+    mckl::StreamTree<RNGType> root(key);
+    mckl::Vector<ctr_type> blocks;
+    bool engine = true;
+    std::size_t leaves = 0;
+    for (std::uintmax_t i = 0; i != (1U << b1); ++i) {
+        auto n1 = root.child(i, b1);
+        for (std::uintmax_t j = 0; j != (1U << b2); ++j) {
+            auto n2 = n1.child(j, b2);
+            for (std::uintmax_t l = 0; l != (1U << b3); ++l) {
+                auto n3 = n2.child(l, b3);
+                engine = random_stream_tree_leaf(n3, N, blocks) && engine;
+                ++leaves;
+            }
+        }
+    }
+    std::sort(blocks.begin(), blocks.end());
+    bool disjoint =
+        std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end();
+
+    // Concurrent seeding with the children of a node shall use each child
+    // exactly once
+    mckl::StreamSeed<RNGType> seed(root.child(1, b1), b2 + b3);
+    mckl::Vector<mckl::Vector<std::uintmax_t>> index(M);
+    mckl::Vector<std::thread> threads;
+    const std::size_t K = (1U << (b2 + b3)) / M;
+    for (std::size_t i = 0; i != M; ++i) {
+        threads.emplace_back([&, i]() {
+            for (std::size_t j = 0; j != K; ++j)
+                index[i].push_back(seed.get());
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    mckl::Vector<std::uintmax_t> all;
+    for (auto &v : index)
+        all.insert(all.end(), v.begin(), v.end());
+    std::sort(all.begin(), all.end());
+    bool threaded = true;
+    for (std::size_t i = 0; i != all.size(); ++i)
+        threaded = threaded && all[i] == i;
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(swid) << std::right << leaves;
+    std::cout << std::setw(swid) << std::right << root.max_bits();
+    std::cout << std::setw(twid) << std::right << random_pass(engine);
+    std::cout << std::setw(twid) << std::right << random_pass(disjoint);
+    std::cout << std::setw(twid) << std::right << random_pass(threaded);
+    std::cout << std::endl;
+
+    return engine && disjoint && threaded;
+}
+
+inline bool random_stream_tree(std::size_t N, std::size_t M, int, char **)
+{
+    const int nwid = 20;
+    const int swid = 8;
+    const int twid = 15;
+    const std::size_t lwid = nwid + swid * 2 + twid * 3;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "RNGType";
+    std::cout << std::setw(swid) << std::right << "Leaves";
+    std::cout << std::setw(swid) << std::right << "Bits";
+    std::cout << std::setw(twid) << std::right << "Engine";
+    std::cout << std::setw(twid) << std::right << "Disjoint";
+    std::cout << std::setw(twid) << std::right << "Threads";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    bool passed = true;
+
+#ifdef MCKL_RNG_DEFINE_MACRO
+#undef MCKL_RNG_DEFINE_MACRO
+#endif
+
+#ifdef MCKL_RNG_DEFINE_MACRO_NA
+#undef MCKL_RNG_DEFINE_MACRO_NA
+#endif
+
+#define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
+    passed &= random_stream_tree<RNGType>(N, M, nwid, swid, twid, #Name,     \
+        RandomStreamTreeEnable<RNGType>());
+
+#include <mckl/random/internal/rng_define_macro.hpp>
+
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return passed;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_STREAM_TREE_HPP
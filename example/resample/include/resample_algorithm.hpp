@@ -0,0 +1,392 @@
+//============================================================================
+// MCKL/example/resample/include/resample_algorithm.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RESAMPLE_ALGORITHM_HPP
+#define MCKL_EXAMPLE_RESAMPLE_ALGORITHM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+// Aligned memory which counts the number of allocations
+class ResampleAlgorithmMemory
+{
+    public:
+    static std::size_t &count()
+    {
+        static std::size_t c = 0;
+
+        return c;
+    }
+
+    static void *aligned_malloc(std::size_t n, std::size_t alignment) noexcept
+    {
+        ++count();
+
+        const std::size_t bytes = (n > 0 ? n : 1) + alignment + sizeof(void *);
+        void *orig_ptr = std::malloc(bytes);
+        if (orig_ptr == nullptr)
+            return nullptr;
+
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(orig_ptr);
+        std::uintptr_t offset =
+            alignment - (address + sizeof(void *)) % alignment;
+        void *ptr =
+            reinterpret_cast<void *>(address + offset + sizeof(void *));
+        void **orig = reinterpret_cast<void **>(address + offset);
+        *orig = orig_ptr;
+
+        return ptr;
+    }
+
+    static void aligned_free(void *ptr) noexcept
+    {
+        if (ptr != nullptr) {
+            std::free(*reinterpret_cast<void **>(
+                reinterpret_cast<std::uintptr_t>(ptr) - sizeof(void *)));
+        }
+    }
+}; // class ResampleAlgorithmMemory
+
+#define MCKL_ALIGNED_MEMORY_TYPE ::ResampleAlgorithmMemory
+
+#include <mckl/core/particle.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/resample.hpp>
+#include <mckl/utility/stop_watch.hpp>
+#include <thread>
+
+using ResampleAlgorithmState = mckl::StateMatrix<mckl::RowMajor, 4, double>;
+
+// The implementation of ResampleAlgorithm prior to the reusable workspace,
+// which allocates temporary storage on each call
+template <typename U01SeqType, bool Residual>
+class ResampleAlgorithmRef
+{
+    public:
+    template <typename RNGType, typename InputIter, typename OutputIter>
+    void operator()(std::size_t N, std::size_t M, RNGType &rng,
+        InputIter weight, OutputIter replication) const
+    {
+        eval(N, M, rng, weight, replication,
+            std::integral_constant<bool, Residual>());
+    }
+
+    private:
+    U01SeqType u01seq_;
+
+    template <typename RNGType, typename InputIter, typename OutputIter>
+    void eval(std::size_t N, std::size_t M, RNGType &rng, InputIter weight,
+        OutputIter replication, std::false_type) const
+    {
+        using real_type = typename std::iterator_traits<InputIter>::value_type;
+
+        mckl::Vector<real_type> u01(M);
+        u01seq_(rng, M, u01.data());
+        mckl::resample_trans_u01_rep(N, M, weight, u01.data(), replication);
+    }
+
+    template <typename RNGType, typename InputIter, typename OutputIter>
+    void eval(std::size_t N, std::size_t M, RNGType &rng, InputIter weight,
+        OutputIter replication, std::true_type) const
+    {
+        using real_type = typename std::iterator_traits<InputIter>::value_type;
+        using rep_type = typename std::iterator_traits<OutputIter>::value_type;
+
+        mckl::Vector<real_type> resid(N);
+        mckl::Vector<rep_type> integ(N);
+        std::size_t R = mckl::resample_trans_residual(
+            N, M, weight, resid.data(), integ.data());
+
+        mckl::Vector<real_type> u01(R);
+        u01seq_(rng, R, u01.data());
+        mckl::resample_trans_u01_rep(
+            N, R, resid.data(), u01.data(), replication);
+        for (std::size_t i = 0; i != N; ++i, ++replication)
+            *replication += integ[i];
+    }
+}; // class ResampleAlgorithmRef
+
+// The implementation of ResampleEval prior to the reusable workspace
+template <typename T>
+class ResampleEvalRef
+{
+    public:
+    using eval_type = typename mckl::ResampleEval<T>::eval_type;
+
+    explicit ResampleEvalRef(const eval_type &eval) : eval_(eval) {}
+
+    void operator()(std::size_t, mckl::Particle<T> &particle) const
+    {
+        using size_type = typename mckl::Particle<T>::size_type;
+
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        mckl::Vector<size_type> rep(N);
+        mckl::Vector<size_type> idx(N);
+        eval_(N, N, particle.rng(), particle.weight().data(), rep.data());
+        mckl::resample_trans_rep_index(N, N, rep.data(), idx.data());
+        particle.state().select(N, idx.data());
+        particle.weight().set_equal();
+    }
+
+    private:
+    eval_type eval_;
+}; // class ResampleEvalRef
+
+// A state without `select_rep`, which is resampled through parent indices
+class ResampleAlgorithmIndexState
+{
+    public:
+    using size_type = std::size_t;
+
+    explicit ResampleAlgorithmIndexState(size_type N) : data_(N)
+    {
+        for (size_type i = 0; i != N; ++i)
+            data_[i] = i;
+    }
+
+    template <typename IntType>
+    void select(IntType N, const size_type *index)
+    {
+        mckl::Vector<size_type> data(static_cast<size_type>(N));
+        for (size_type i = 0; i != data.size(); ++i)
+            data[i] = data_[index[i]];
+        data_ = std::move(data);
+    }
+
+    const mckl::Vector<size_type> &data() const { return data_; }
+
+    private:
+    mckl::Vector<size_type> data_;
+}; // class ResampleAlgorithmIndexState
+
+// ResampleEval shall resample the state, either with `select_rep` or through
+// parent indices, to the same samples as the implementation using `select`
+template <typename U01SeqType, bool Residual>
+inline bool resample_algorithm_eval(std::size_t N, const mckl::Vector<double> &v)
+{
+    using matrix_type = ResampleAlgorithmState;
+    using index_type = ResampleAlgorithmIndexState;
+
+    mckl::Particle<matrix_type> matrix1(N);
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t j = 0; j != matrix1.state().dim(); ++j)
+            matrix1.state()(i, j) = static_cast<double>(i * 4 + j);
+    matrix1.weight().set_log(v.data());
+    mckl::Particle<matrix_type> matrix2(matrix1);
+    ResampleEvalRef<matrix_type>{ResampleAlgorithmRef<U01SeqType, Residual>()}(
+        0, matrix1);
+    mckl::ResampleEval<matrix_type>{
+        mckl::ResampleAlgorithm<U01SeqType, Residual>()}(0, matrix2);
+
+    mckl::Particle<index_type> index1(N);
+    index1.weight().set_log(v.data());
+    mckl::Particle<index_type> index2(index1);
+    ResampleEvalRef<index_type>{ResampleAlgorithmRef<U01SeqType, Residual>()}(
+        0, index1);
+    mckl::ResampleEval<index_type>{
+        mckl::ResampleAlgorithm<U01SeqType, Residual>()}(0, index2);
+
+    return std::equal(matrix1.state().data(),
+               matrix1.state().data() + N * matrix1.state().dim(),
+               matrix2.state().data()) &&
+        index1.state().data() == index2.state().data();
+}
+
+template <typename EvalType>
+inline double resample_algorithm(std::size_t repeat, EvalType &eval,
+    mckl::Particle<ResampleAlgorithmState> &particle,
+    const mckl::Vector<double> &v, std::size_t &alloc)
+{
+    // One call before measurement such that any workspace has been allocated
+    particle.weight().set_log(v.data());
+    eval(0, particle);
+
+    mckl::StopWatch watch;
+    std::size_t count = 0;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        particle.weight().set_log(v.data());
+        const std::size_t c = ResampleAlgorithmMemory::count();
+        watch.start();
+        eval(0, particle);
+        watch.stop();
+        count += ResampleAlgorithmMemory::count() - c;
+    }
+    alloc = count / repeat;
+
+    return watch.nanoseconds() / (repeat * particle.size());
+}
+
+// The replication numbers of the default ResampleAlgorithm shall be
+// bit-identical to those of the implementation prior to the reusable
+// workspace and the blocked transformations
+template <typename U01SeqType, bool Residual>
+inline bool resample_algorithm_check(
+    std::size_t N, std::size_t M, const mckl::Vector<double> &v)
+{
+    mckl::Vector<double> w(v.size());
+    mckl::exp(v.size(), v.data(), w.data());
+    const double s = std::accumulate(w.begin(), w.end(), 0.0);
+    mckl::mul(w.size(), 1 / s, w.data(), w.data());
+
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    mckl::Vector<std::size_t> rep1(N);
+    mckl::Vector<std::size_t> rep2(N);
+    ResampleAlgorithmRef<U01SeqType, Residual> ref;
+    mckl::ResampleAlgorithm<U01SeqType, Residual> alg;
+    bool pass = true;
+    for (std::size_t r = 0; r != 10; ++r) {
+        ref(N, M, rng1, w.data(), rep1.data());
+        alg(N, M, rng2, w.data(), rep2.data());
+        pass = pass && rep1 == rep2;
+    }
+
+    return pass;
+}
+
+// The const overloads of the same object shall be callable concurrently,
+// with and without a workspace of each thread, and produce the same results
+// as sequential calls of the non-const overload
+template <typename U01SeqType, bool Residual>
+inline bool resample_algorithm_threads(
+    std::size_t N, std::size_t M, const mckl::Vector<double> &v)
+{
+    const std::size_t T = 4;
+    const std::size_t R = 10;
+
+    mckl::Vector<double> w(v.size());
+    mckl::exp(v.size(), v.data(), w.data());
+    const double s = std::accumulate(w.begin(), w.end(), 0.0);
+    mckl::mul(w.size(), 1 / s, w.data(), w.data());
+
+    mckl::ResampleAlgorithm<U01SeqType, Residual> alg;
+    mckl::Vector<mckl::Vector<std::size_t>> ref(T * R);
+    for (std::size_t t = 0; t != T; ++t) {
+        mckl::RNG rng(t + 1);
+        for (std::size_t r = 0; r != R; ++r) {
+            ref[t * R + r].resize(N);
+            alg(N, M, rng, w.data(), ref[t * R + r].data());
+        }
+    }
+
+    const mckl::ResampleAlgorithm<U01SeqType, Residual> &calg = alg;
+    mckl::Vector<mckl::Vector<std::size_t>> rep(T * R);
+    mckl::Vector<std::thread> threads;
+    for (std::size_t t = 0; t != T; ++t) {
+        threads.emplace_back([&, t]() {
+            mckl::RNG rng(t + 1);
+            mckl::ResampleWorkspace workspace;
+            for (std::size_t r = 0; r != R; ++r) {
+                rep[t * R + r].resize(N);
+                if (r % 2 == 0)
+                    calg(N, M, rng, w.data(), rep[t * R + r].data());
+                else
+                    calg(N, M, rng, w.data(), rep[t * R + r].data(),
+                        workspace);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    return rep == ref;
+}
+
+template <typename U01SeqType, bool Residual>
+inline bool resample_algorithm(std::size_t N, int nwid, int twid)
+{
+    const std::size_t repeat = std::max(static_cast<std::size_t>(10),
+        static_cast<std::size_t>(10000000) / N);
+
+    mckl::Particle<ResampleAlgorithmState> particle(N);
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::Vector<double> v(N);
+    normal(particle.rng(), N, v.data());
+
+    ResampleEvalRef<ResampleAlgorithmState> ref{
+        ResampleAlgorithmRef<U01SeqType, Residual>()};
+    mckl::ResampleEval<ResampleAlgorithmState> eval{
+        mckl::ResampleAlgorithm<U01SeqType, Residual>()};
+
+    std::size_t aref = 0;
+    std::size_t anew = 0;
+    const double tref = resample_algorithm(repeat, ref, particle, v, aref);
+    const double tnew = resample_algorithm(repeat, eval, particle, v, anew);
+
+    bool pass = true;
+    pass = pass && resample_algorithm_check<U01SeqType, Residual>(N, N, v);
+    pass = pass && resample_algorithm_check<U01SeqType, Residual>(N, N / 3, v);
+    pass = pass && resample_algorithm_check<U01SeqType, Residual>(N, N * 2, v);
+    pass = pass && resample_algorithm_threads<U01SeqType, Residual>(N, N, v);
+    pass = pass && resample_algorithm_eval<U01SeqType, Residual>(N, v);
+
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref;
+    std::cout << std::setw(twid) << std::right << std::fixed << tnew;
+    std::cout << std::setw(twid) << std::right << std::fixed << tref / tnew;
+    std::cout << std::setw(twid) << std::right << aref;
+    std::cout << std::setw(twid) << std::right << anew;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+template <typename U01SeqType, bool Residual>
+inline bool resample_algorithm(std::size_t N, const std::string &name)
+{
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 6;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << name << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Ref (ns)";
+    std::cout << std::setw(twid) << std::right << "New (ns)";
+    std::cout << std::setw(twid) << std::right << "Speedup";
+    std::cout << std::setw(twid) << std::right << "Alloc (Ref)";
+    std::cout << std::setw(twid) << std::right << "Alloc (New)";
+    std::cout << std::setw(twid) << std::right << "Identical";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    for (std::size_t n = 10000; n <= N; n *= 10)
+        pass = resample_algorithm<U01SeqType, Residual>(n, nwid, twid) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_RESAMPLE_ALGORITHM_HPP
@@ -0,0 +1,158 @@
+//============================================================================
+// MCKL/example/resample/include/resample_genealogy.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RESAMPLE_GENEALOGY_HPP
+#define MCKL_EXAMPLE_RESAMPLE_GENEALOGY_HPP
+
+#include "resample_test.hpp"
+
+template <typename ResampleIndexType>
+inline void resample_genealogy_push(ResampleIndexType &resample_index,
+    const mckl::Vector<mckl::Vector<std::size_t>> &index, std::size_t interval,
+    mckl::StopWatch &watch)
+{
+    watch.start();
+    for (std::size_t d = 0; d != index.size(); ++d) {
+        if (d % interval == 0)
+            resample_index.push_back(index[d].size(), index[d].begin());
+        else
+            resample_index.push_back(index[d].size());
+    }
+    watch.stop();
+}
+
+template <typename ResampleIndexType>
+inline mckl::Vector<int> resample_genealogy_read(
+    const ResampleIndexType &resample_index, mckl::MatrixLayout layout,
+    mckl::StopWatch &watch)
+{
+    watch.start();
+    mckl::Vector<int> idxmat(resample_index.index_matrix(layout));
+    watch.stop();
+
+    return idxmat;
+}
+
+template <typename ResampleIndexType>
+inline mckl::Vector<int> resample_genealogy_index(
+    const ResampleIndexType &resample_index, mckl::StopWatch &watch)
+{
+    const std::size_t N = resample_index.size();
+    const std::size_t T = resample_index.iter_size();
+    mckl::Vector<int> idx(N);
+    watch.start();
+    for (std::size_t i = 0; i != N; ++i)
+        idx[i] = resample_index.index(i, T - 1, T / 2);
+    watch.stop();
+
+    return idx;
+}
+
+inline void resample_genealogy_test(
+    std::size_t N, std::size_t dim, std::size_t interval)
+{
+    mckl::RNG rng;
+    auto size = resample_size(rng, N, dim, true);
+    auto weight = resample_weight(rng, size);
+    auto index = resample_index(rng, size, weight);
+
+    mckl::ResampleIndex<int> ref;
+    mckl::ResampleGenealogy<int> gen;
+    mckl::StopWatch watch1;
+    mckl::StopWatch watch2;
+
+    bool passed = true;
+    resample_genealogy_push(ref, index, interval, watch1);
+    resample_genealogy_push(gen, index, interval, watch2);
+    const double p1 = watch1.milliseconds();
+    const double p2 = watch2.milliseconds();
+
+    watch1.reset();
+    watch2.reset();
+    passed = passed &&
+        resample_genealogy_read(ref, mckl::RowMajor, watch1) ==
+            resample_genealogy_read(gen, mckl::RowMajor, watch2);
+    const double r1 = watch1.milliseconds();
+    const double r2 = watch2.milliseconds();
+
+    watch1.reset();
+    watch2.reset();
+    passed = passed &&
+        resample_genealogy_read(ref, mckl::ColMajor, watch1) ==
+            resample_genealogy_read(gen, mckl::ColMajor, watch2);
+    const double c1 = watch1.milliseconds();
+    const double c2 = watch2.milliseconds();
+
+    watch1.reset();
+    watch2.reset();
+    passed = passed &&
+        resample_genealogy_index(ref, watch1) ==
+            resample_genealogy_index(gen, watch2);
+    const double i1 = watch1.milliseconds();
+    const double i2 = watch2.milliseconds();
+
+    const double mb = 1.0 / (1024 * 1024);
+    const double m1 = mb * sizeof(int) * N * dim;
+    const double m2 = mb * ((3 * sizeof(std::size_t) + 2 * sizeof(int)) *
+                                   gen.node_size() +
+                               sizeof(int) * gen.trunk_size());
+
+    auto print = [](const std::string &name, double v1, double v2) {
+        std::cout << std::setw(35) << std::left << name << std::setw(15)
+                  << std::right << v1 << std::setw(15) << v2 << std::setw(15)
+                  << v1 / v2 << std::endl;
+    };
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(65) << std::left << "Resampling interval"
+              << std::setw(15) << std::right << interval << std::endl;
+    std::cout << std::setw(65) << std::left << "Number of nodes"
+              << std::setw(15) << std::right << gen.node_size() << std::endl;
+    std::cout << std::setw(65) << std::left << "Common ancestry length"
+              << std::setw(15) << std::right << gen.trunk_size() << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(35) << std::left << "Measurement" << std::setw(15)
+              << std::right << "Index" << std::setw(15) << "Genealogy"
+              << std::setw(15) << "Ratio" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    print("Memory (MB)", m1, m2);
+    print("Time (ms) push_back", p1, p2);
+    print("Time (ms) index_matrix RowMajor", r1, r2);
+    print("Time (ms) index_matrix ColMajor", c1, c2);
+    print("Time (ms) index", i1, i2);
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(65) << std::left << "Test result" << std::setw(15)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RESAMPLE_GENEALOGY_HPP
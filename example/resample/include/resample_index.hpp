@@ -33,6 +33,7 @@
 #define MCKL_EXAMPLE_RESAMPLE_INDEX_HPP
 
 #include "resample_test.hpp"
+#include <mckl/smp.hpp>
 
 template <mckl::MatrixLayout Layout>
 inline ResampleState<Layout> resample_index_fixed(
@@ -191,4 +192,96 @@ inline void resample_index_test(std::size_t N, std::size_t dim, bool fixed)
     std::cout << std::string(80, '-') << std::endl;
 }
 
+template <mckl::MatrixLayout Layout>
+inline mckl::Vector<int> resample_index_read_ref(
+    const mckl::Vector<mckl::Vector<std::size_t>> &index)
+{
+    const std::size_t R = index.size();
+    const std::size_t N = index.back().size();
+    mckl::Vector<int> idxmat(N * R);
+
+    if (Layout == mckl::RowMajor) {
+        int *back = idxmat.data() + R - 1;
+        for (std::size_t i = 0; i != N; ++i)
+            back[i * R] = static_cast<int>(index[R - 1][i]);
+        for (std::size_t r = 1; r != R; ++r) {
+            const int *last = back--;
+            const std::size_t *idx = index[R - 1 - r].data();
+            for (std::size_t i = 0; i != N; ++i)
+                back[i * R] = static_cast<int>(
+                    idx[static_cast<std::size_t>(last[i * R])]);
+        }
+    }
+
+    if (Layout == mckl::ColMajor) {
+        int *back = idxmat.data() + N * (R - 1);
+        for (std::size_t i = 0; i != N; ++i)
+            back[i] = static_cast<int>(index[R - 1][i]);
+        for (std::size_t r = 1; r != R; ++r) {
+            const int *last = back;
+            back -= N;
+            const std::size_t *idx = index[R - 1 - r].data();
+            for (std::size_t i = 0; i != N; ++i)
+                back[i] = static_cast<int>(
+                    idx[static_cast<std::size_t>(last[i])]);
+        }
+    }
+
+    return idxmat;
+}
+
+template <mckl::MatrixLayout Layout>
+inline void resample_index_read(std::size_t N, std::size_t dim)
+{
+    mckl::RNG rng;
+    auto size = resample_size(rng, N, dim, true);
+    auto weight = resample_weight(rng, size);
+    auto index = resample_index(rng, size, weight);
+
+    mckl::ResampleIndex<int> resample_index;
+    for (std::size_t d = 0; d != dim; ++d)
+        resample_index.push_back(index[d].size(), index[d].begin());
+
+    mckl::StopWatch watch1;
+    mckl::StopWatch watch2;
+    mckl::StopWatch watch3;
+
+    watch1.start();
+    auto m1 = resample_index_read_ref<Layout>(index);
+    watch1.stop();
+
+    watch2.start();
+    auto m2 = resample_index.index_matrix<mckl::BackendSEQ>(Layout);
+    watch2.stop();
+
+    watch3.start();
+    auto m3 = resample_index.index_matrix<mckl::BackendSMP>(Layout);
+    watch3.stop();
+
+    bool passed = m1 == m2 && m1 == m3;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::setw(20) << std::left
+              << (Layout == mckl::RowMajor ? "RowMajor" : "ColMajor")
+              << std::setw(15) << std::right << watch1.milliseconds()
+              << std::setw(15) << watch2.milliseconds() << std::setw(15)
+              << watch3.milliseconds() << std::setw(15)
+              << watch1.milliseconds() / watch3.milliseconds();
+    std::cout << std::setw(15) << std::right << (passed ? "Passed" : "Failed")
+              << std::endl;
+}
+
+inline void resample_index_read(std::size_t N, std::size_t dim)
+{
+    std::cout << std::string(95, '=') << std::endl;
+    std::cout << std::setw(20) << std::left << "Layout" << std::setw(15)
+              << std::right << "Ref (ms)" << std::setw(15) << "SEQ (ms)"
+              << std::setw(15) << "SMP (ms)" << std::setw(15) << "Speedup"
+              << std::setw(15) << "Test" << std::endl;
+    std::cout << std::string(95, '-') << std::endl;
+    resample_index_read<mckl::RowMajor>(N, dim);
+    resample_index_read<mckl::ColMajor>(N, dim);
+    std::cout << std::string(95, '-') << std::endl;
+}
+
 #endif // MCKL_EXAMPLE_RESAMPLE_INDEX_HPP
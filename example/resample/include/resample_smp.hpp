@@ -0,0 +1,183 @@
+//============================================================================
+// MCKL/example/resample/include/resample_smp.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RESAMPLE_SMP_HPP
+#define MCKL_EXAMPLE_RESAMPLE_SMP_HPP
+
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_real_distribution.hpp>
+#include <mckl/resample.hpp>
+#include <mckl/smp.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <typename Backend>
+inline void resample_smp(std::size_t N, const mckl::Vector<double> &w,
+    const mckl::Vector<double> &u, mckl::Vector<std::size_t> &rep,
+    mckl::Vector<std::size_t> &idx, mckl::StopWatch &watch_rep,
+    mckl::StopWatch &watch_idx)
+{
+    watch_rep.start();
+    mckl::resample_trans_u01_rep<Backend>(
+        N, N, w.data(), u.data(), rep.data());
+    watch_rep.stop();
+
+    watch_idx.start();
+    mckl::resample_trans_rep_index<Backend>(N, N, rep.data(), idx.data());
+    watch_idx.stop();
+}
+
+// Check that a backend is bit-identical to the sequential transforms
+template <typename Backend>
+inline bool resample_smp_check(std::size_t N, const mckl::Vector<double> &w,
+    const mckl::Vector<double> &u, const mckl::Vector<std::size_t> &rep1,
+    const mckl::Vector<std::size_t> &idx1)
+{
+    mckl::Vector<std::size_t> rep(N);
+    mckl::Vector<std::size_t> idx(N);
+    mckl::resample_trans_u01_rep<Backend>(
+        N, N, w.data(), u.data(), rep.data());
+    mckl::resample_trans_rep_index<Backend>(N, N, rep.data(), idx.data());
+    if (rep != rep1 || idx != idx1)
+        return false;
+
+    mckl::Vector<double> resid1(N);
+    mckl::Vector<double> resid(N);
+    mckl::Vector<std::size_t> integ1(N);
+    mckl::Vector<std::size_t> integ(N);
+    const std::size_t R1 = mckl::resample_trans_residual(
+        N, N, w.data(), resid1.data(), integ1.data());
+    const std::size_t R = mckl::resample_trans_residual<Backend>(
+        N, N, w.data(), resid.data(), integ.data());
+
+    return R == R1 && resid == resid1 && integ == integ1;
+}
+
+inline bool resample_smp(std::size_t N, int nwid, int twid)
+{
+    const std::size_t repeat = std::max(static_cast<std::size_t>(3),
+        static_cast<std::size_t>(10000000) / N);
+
+    mckl::RNG rng;
+    mckl::UniformRealDistribution<double> runif(0, 1);
+    mckl::Vector<double> w(N);
+    mckl::Vector<double> u(N);
+    mckl::Vector<std::size_t> rep1(N);
+    mckl::Vector<std::size_t> rep2(N);
+    mckl::Vector<std::size_t> rep3(N);
+    mckl::Vector<std::size_t> idx1(N);
+    mckl::Vector<std::size_t> idx2(N);
+    mckl::Vector<std::size_t> idx3(N);
+    mckl::StopWatch watch_rep1;
+    mckl::StopWatch watch_rep2;
+    mckl::StopWatch watch_rep3;
+    mckl::StopWatch watch_idx1;
+    mckl::StopWatch watch_idx2;
+    mckl::StopWatch watch_idx3;
+    bool pass = true;
+    for (std::size_t r = 0; r != repeat; ++r) {
+        runif(rng, N, w.data());
+        mckl::exp(N, w.data(), w.data());
+        const double s = std::accumulate(w.begin(), w.end(), 0.0);
+        mckl::mul(N, 1 / s, w.data(), w.data());
+        mckl::u01_rand_sorted(rng, N, u.data());
+
+        watch_rep1.start();
+        mckl::resample_trans_u01_rep(N, N, w.data(), u.data(), rep1.data());
+        watch_rep1.stop();
+        watch_idx1.start();
+        mckl::resample_trans_rep_index(N, N, rep1.data(), idx1.data());
+        watch_idx1.stop();
+
+        resample_smp<mckl::BackendSEQ>(
+            N, w, u, rep2, idx2, watch_rep2, watch_idx2);
+        resample_smp<mckl::BackendSTD>(
+            N, w, u, rep3, idx3, watch_rep3, watch_idx3);
+
+        // All backends are bit-identical to the sequential overloads
+        pass = pass && rep1 == rep2 && idx1 == idx2;
+        pass = pass && rep1 == rep3 && idx1 == idx3;
+        pass = pass &&
+            resample_smp_check<mckl::BackendSEQ>(N, w, u, rep1, idx1);
+        pass = pass &&
+            resample_smp_check<mckl::BackendSTD>(N, w, u, rep1, idx1);
+#if MCKL_HAS_OMP
+        pass = pass &&
+            resample_smp_check<mckl::BackendOMP>(N, w, u, rep1, idx1);
+#endif
+#if MCKL_HAS_TBB
+        pass = pass &&
+            resample_smp_check<mckl::BackendTBB>(N, w, u, rep1, idx1);
+#endif
+    }
+
+    const double n = static_cast<double>(repeat * N);
+    std::cout << std::setw(nwid) << std::left << N;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_rep1.nanoseconds() / n;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_rep2.nanoseconds() / n;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_rep3.nanoseconds() / n;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_idx1.nanoseconds() / n;
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << watch_idx3.nanoseconds() / n;
+    std::cout << std::setw(twid) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return pass;
+}
+
+inline bool resample_smp(std::size_t N)
+{
+    const int nwid = 12;
+    const int twid = 15;
+    const std::size_t lwid = nwid + twid * 6;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "N";
+    std::cout << std::setw(twid) << std::right << "Rep (ns)";
+    std::cout << std::setw(twid) << std::right << "Rep SEQ (ns)";
+    std::cout << std::setw(twid) << std::right << "Rep STD (ns)";
+    std::cout << std::setw(twid) << std::right << "Idx (ns)";
+    std::cout << std::setw(twid) << std::right << "Idx STD (ns)";
+    std::cout << std::setw(twid) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    bool pass = true;
+    for (std::size_t n = 10000; n <= N; n *= 10)
+        pass = resample_smp(n, nwid, twid) && pass;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_RESAMPLE_SMP_HPP
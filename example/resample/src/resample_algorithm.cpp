@@ -0,0 +1,57 @@
+//============================================================================
+// MCKL/example/resample/src/resample_algorithm.cpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#include "resample_algorithm.hpp"
+
+int main(int argc, char **argv)
+{
+    std::size_t N = 10000000;
+    if (argc > 1)
+        N = static_cast<std::size_t>(std::atof(argv[1]));
+
+    bool pass = true;
+    pass &= resample_algorithm<mckl::U01SequenceSorted, false>(
+        N, "Multinomial");
+    pass &= resample_algorithm<mckl::U01SequenceStratified, false>(
+        N, "Stratified");
+    pass &= resample_algorithm<mckl::U01SequenceSystematic, false>(
+        N, "Systematic");
+    pass &= resample_algorithm<mckl::U01SequenceSobol, false>(N, "Sobol");
+    pass &= resample_algorithm<mckl::U01SequenceSorted, true>(N, "Residual");
+    pass &= resample_algorithm<mckl::U01SequenceStratified, true>(
+        N, "ResidualStratified");
+    pass &= resample_algorithm<mckl::U01SequenceSystematic, true>(
+        N, "ResidualSystematic");
+    pass &= resample_algorithm<mckl::U01SequenceSobol, true>(
+        N, "ResidualSobol");
+
+    return pass ? 0 : 1;
+}
@@ -45,6 +45,7 @@ int main(int argc, char **argv)
     resample_index_test<mckl::RowMajor, mckl::ColMajor>(N, dim, true);
     resample_index_test<mckl::ColMajor, mckl::RowMajor>(N, dim, true);
     resample_index_test<mckl::ColMajor, mckl::ColMajor>(N, dim, true);
+    resample_index_read(N, dim);
     resample_index_test<mckl::RowMajor, mckl::RowMajor>(N, dim, false);
     resample_index_test<mckl::RowMajor, mckl::ColMajor>(N, dim, false);
     resample_index_test<mckl::ColMajor, mckl::RowMajor>(N, dim, false);
@@ -0,0 +1,259 @@
+//============================================================================
+// MCKL/example/utility/include/utility_hdf5_stream.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_UTILITY_HDF5_STREAM_HPP
+#define MCKL_EXAMPLE_UTILITY_HDF5_STREAM_HPP
+
+#include <mckl/core.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/utility/hdf5_stream.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+using UtilityHDF5StreamState = mckl::StateMatrix<mckl::RowMajor, 4, double>;
+
+inline void utility_hdf5_stream_init(std::size_t,
+    mckl::Particle<UtilityHDF5StreamState> &particle)
+{
+    mckl::NormalDistribution<double> normal(0, 1);
+    normal(particle.rng(), particle.size() * particle.state().dim(),
+        particle.state().data());
+    particle.weight().set_equal();
+}
+
+inline void utility_hdf5_stream_move(std::size_t,
+    mckl::Particle<UtilityHDF5StreamState> &particle)
+{
+    const std::size_t N = particle.size();
+    const std::size_t dim = particle.state().dim();
+    mckl::Vector<double> z(N * dim);
+    mckl::Vector<double> w(N);
+    mckl::NormalDistribution<double> normal(0, 0.1);
+    normal(particle.rng(), N * dim, z.data());
+    double *x = particle.state().data();
+    for (std::size_t i = 0; i != N; ++i) {
+        w[i] = 0;
+        for (std::size_t d = 0; d != dim; ++d, ++x) {
+            *x += z[i * dim + d];
+            w[i] -= 0.5 * (*x) * (*x);
+        }
+    }
+    particle.weight().add_log(w.data());
+}
+
+inline void utility_hdf5_stream_eval(std::size_t, std::size_t dim,
+    mckl::Particle<UtilityHDF5StreamState> &particle, double *r)
+{
+    std::copy_n(particle.state().data(), particle.size() * dim, r);
+}
+
+inline bool utility_hdf5_stream_check(const std::string &filename,
+    const mckl::Sampler<UtilityHDF5StreamState> &sampler)
+{
+    const std::size_t T = sampler.iter_size();
+    const std::size_t N = sampler.size();
+    const auto &monitor = sampler.monitor("pos");
+    const std::size_t dim = monitor.dim();
+
+    mckl::Vector<double> ess(T);
+    mckl::Vector<double> weight(T * N);
+    mckl::Vector<double> state(T * N * dim);
+    mckl::Vector<double> record(T * dim);
+    if (mckl::hdf5load_size(filename, "smc/ESS") != ess.size())
+        return false;
+    if (mckl::hdf5load_size(filename, "smc/Weight") != weight.size())
+        return false;
+    if (mckl::hdf5load_size(filename, "smc/State") != state.size())
+        return false;
+    if (mckl::hdf5load_size(filename, "smc/pos/Record") != record.size())
+        return false;
+    mckl::hdf5load(filename, "smc/ESS", ess.data());
+    mckl::hdf5load(filename, "smc/Weight", weight.data());
+    mckl::hdf5load(filename, "smc/State", state.data());
+    mckl::hdf5load(filename, "smc/pos/Record", record.data());
+
+    for (std::size_t i = 0; i != T; ++i) {
+        if (!mckl::internal::is_equal(ess[i], sampler.ess_history(i)))
+            return false;
+        for (std::size_t d = 0; d != dim; ++d)
+            if (!mckl::internal::is_equal(
+                    record[i * dim + d], monitor.record(d, i)))
+                return false;
+    }
+
+    const double *w = weight.data() + (T - 1) * N;
+    const double *s = state.data() + (T - 1) * N * dim;
+    if (!std::equal(w, w + N, sampler.particle().weight().data()))
+        return false;
+    if (!std::equal(s, s + N * dim, sampler.particle().state().data()))
+        return false;
+
+    return true;
+}
+
+// Append the current weights once more to the existing file
+inline bool utility_hdf5_stream_append(const std::string &filename,
+    const mckl::Sampler<UtilityHDF5StreamState> &sampler, bool async)
+{
+    const std::size_t T = sampler.iter_size();
+    const std::size_t N = sampler.size();
+    const auto &weight = sampler.particle().weight();
+    {
+        mckl::HDF5Stream stream(filename, true, 0, 0, async);
+        if (!stream.good())
+            return false;
+        stream.append("smc/Weight", N, weight.data());
+        if (!stream.flush())
+            return false;
+
+        // A dataset cannot be created in place of the existing group. The
+        // error is reported by close, and the row is not counted
+        stream.append("smc", 1.0);
+        if (stream.close() || stream.error().empty() || stream.size("smc"))
+            return false;
+        if (stream.size("smc/Weight") != 1)
+            return false;
+    }
+
+    mckl::Vector<double> w((T + 1) * N);
+    if (mckl::hdf5load_size(filename, "smc/Weight") != w.size())
+        return false;
+    mckl::hdf5load(filename, "smc/Weight", w.data());
+
+    return std::equal(w.data() + T * N, w.data() + (T + 1) * N,
+        w.data() + (T - 1) * N);
+}
+
+inline void utility_hdf5_stream_config(
+    mckl::Sampler<UtilityHDF5StreamState> &sampler)
+{
+    using T = UtilityHDF5StreamState;
+
+    sampler.resample_method(mckl::Stratified, 0.5);
+    sampler.eval(utility_hdf5_stream_init, mckl::SamplerInit);
+    sampler.eval(utility_hdf5_stream_move, mckl::SamplerMove);
+    sampler.monitor("pos", mckl::Monitor<T>(4, utility_hdf5_stream_eval));
+}
+
+// Run a sampler and append its weights, ESS, monitor records and state
+// after each iteration. Returns the time of each iteration in microseconds
+inline double utility_hdf5_stream_run(std::size_t N, std::size_t n,
+    mckl::HDF5Stream *stream, mckl::StopWatch &watch)
+{
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<UtilityHDF5StreamState> sampler(N);
+    utility_hdf5_stream_config(sampler);
+    sampler.reserve(n);
+
+    watch.start();
+    for (std::size_t i = 0; i != n; ++i) {
+        if (i == 0)
+            sampler.initialize();
+        else
+            sampler.iterate();
+        if (stream != nullptr) {
+            stream->append("smc", sampler);
+            stream->append("smc/pos", sampler.monitor("pos"));
+            stream->append("smc/State", sampler.particle().state());
+        }
+    }
+    watch.stop();
+
+    return watch.microseconds() / n;
+}
+
+inline bool utility_hdf5_stream(std::size_t N, std::size_t n,
+    const std::string &mode, bool async, int compression)
+{
+    const std::string filename("hdf5_stream.h5");
+
+    mckl::StopWatch watch_none;
+    mckl::StopWatch watch_run;
+    mckl::StopWatch watch_close;
+    const double tnone = utility_hdf5_stream_run(N, n, nullptr, watch_none);
+
+    double trun = 0;
+    bool closed = false;
+    {
+        mckl::HDF5Stream stream(filename, false, compression, 0, async);
+        trun = utility_hdf5_stream_run(N, n, &stream, watch_run);
+        watch_close.start();
+        closed = stream.close();
+        watch_close.stop();
+    }
+
+    // Rerun the sampler without streaming to check the file
+    mckl::Seed::instance().set(101);
+    mckl::Sampler<UtilityHDF5StreamState> sampler(N);
+    utility_hdf5_stream_config(sampler);
+    sampler.initialize();
+    sampler.iterate(n - 1);
+    bool passed = closed && utility_hdf5_stream_check(filename, sampler);
+    passed = passed && utility_hdf5_stream_append(filename, sampler, async);
+
+    std::cout << std::setw(20) << std::left << mode;
+    std::cout << std::setw(15) << std::right << compression;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(15) << std::right << tnone;
+    std::cout << std::setw(15) << std::right << trun;
+    std::cout << std::setw(15) << std::right << trun - tnone;
+    std::cout << std::setw(15) << std::right << watch_close.milliseconds();
+    std::cout << std::setw(15) << std::right << (passed ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    return passed;
+}
+
+inline bool utility_hdf5_stream(std::size_t N, std::size_t n)
+{
+    mckl::StopWatch watch;
+    utility_hdf5_stream_run(N, n, nullptr, watch);
+
+    std::cout << std::string(110, '=') << std::endl;
+    std::cout << std::setw(20) << std::left << "Mode";
+    std::cout << std::setw(15) << std::right << "Compression";
+    std::cout << std::setw(15) << std::right << "None (us)";
+    std::cout << std::setw(15) << std::right << "Stream (us)";
+    std::cout << std::setw(15) << std::right << "Overhead (us)";
+    std::cout << std::setw(15) << std::right << "Close (ms)";
+    std::cout << std::setw(15) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(110, '-') << std::endl;
+    bool pass = true;
+    pass &= utility_hdf5_stream(N, n, "Synchronous", false, 0);
+    pass &= utility_hdf5_stream(N, n, "Asynchronous", true, 0);
+    pass &= utility_hdf5_stream(N, n, "Synchronous", false, 1);
+    pass &= utility_hdf5_stream(N, n, "Asynchronous", true, 1);
+    std::cout << std::string(110, '-') << std::endl;
+
+    return pass;
+}
+
+#endif // MCKL_EXAMPLE_UTILITY_HDF5_STREAM_HPP
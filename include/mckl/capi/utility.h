@@ -69,6 +69,23 @@ void mckl_covariance_compute(mckl_covariance covariance,
 
 /// @} C_API_Utility_Covariance
 
+/// \addtogroup C_API_Utility_CPUFeatures
+/// @{
+
+/// \brief `mckl::cpu_features`
+///
+/// \return A bitwise combination of `MCKLCPUFeature` values
+int mckl_cpu_features(void);
+
+/// \brief The instruction set used by the `mckl_rand` family of functions
+///
+/// \return `MCKLCPUAVX512F`, `MCKLCPUAVX2` or `MCKLCPUSSE2` if the library
+/// was built with runtime dispatch, and the corresponding code path was
+/// selected when the library was loaded, otherwise zero
+int mckl_cpu_dispatch(void);
+
+/// @} C_API_Utility_CPUFeatures
+
 /// \addtogroup C_API_Utility_HDF5
 /// @{
 
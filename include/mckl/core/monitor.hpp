@@ -33,6 +33,7 @@
 #define MCKL_CORE_MONITOR_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/smp/backend_base.hpp>
 
 namespace mckl
 {
@@ -45,26 +46,266 @@ enum MonitorStage {
     MonitorMCMC      ///< Monitor evaluated after MCMC moves
 };                   // enum MonitorStage
 
+namespace internal
+{
+
+template <typename T>
+using MonitorEvalType =
+    std::function<void(std::size_t, std::size_t, Particle<T> &, double *)>;
+
+template <typename T>
+using MonitorEvalFloatType =
+    std::function<void(std::size_t, std::size_t, Particle<T> &, float *)>;
+
+template <typename T, typename EvalType>
+inline auto monitor_eval(const EvalType &eval, int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<double *>()),
+        MonitorEvalType<T>())
+{
+    return eval;
+}
+
+template <typename T, typename EvalType>
+inline MonitorEvalType<T> monitor_eval(const EvalType &, long)
+{
+    return nullptr;
+}
+
+/// \brief `eval` if it writes `double` values, otherwise an empty function
+template <typename T, typename EvalType>
+inline MonitorEvalType<T> monitor_eval(const EvalType &eval)
+{
+    return monitor_eval<T, typename std::decay<EvalType>::type>(eval, 0);
+}
+
+template <typename T, typename EvalType>
+inline auto monitor_eval_float(const EvalType &, int, int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<double *>()),
+        MonitorEvalFloatType<T>())
+{
+    return nullptr;
+}
+
+template <typename T, typename EvalType>
+inline auto monitor_eval_float(const EvalType &eval, long, int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<float *>()),
+        MonitorEvalFloatType<T>())
+{
+    return eval;
+}
+
+template <typename T, typename EvalType>
+inline MonitorEvalFloatType<T> monitor_eval_float(const EvalType &, long, long)
+{
+    return nullptr;
+}
+
+/// \brief `eval` if it writes `float` values but not `double` values,
+/// otherwise an empty function
+template <typename T, typename EvalType>
+inline MonitorEvalFloatType<T> monitor_eval_float(const EvalType &eval)
+{
+    return monitor_eval_float<T, typename std::decay<EvalType>::type>(
+        eval, 0, 0);
+}
+
+template <typename T, typename EvalType>
+inline auto monitor_callable(int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<double *>()),
+        std::true_type());
+
+template <typename T, typename EvalType>
+inline auto monitor_callable(long)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<float *>()),
+        std::true_type());
+
+template <typename T, typename EvalType>
+inline std::false_type monitor_callable(...);
+
+/// \brief Whether `EvalType` writes either `double` or `float` values
+template <typename T, typename EvalType>
+using MonitorEvalCallable = decltype(
+    monitor_callable<T, typename std::decay<EvalType>::type>(0));
+
+/// \brief Weighted sums computed by the evaluation object stored in a
+/// `MonitorEvalType<T>`
+template <typename T>
+using MonitorEvalSum = void (*)(
+    MonitorEvalType<T> &, std::size_t, std::size_t, Particle<T> &, double *);
+
+template <typename T, typename EvalType>
+class MonitorEvalSumImpl
+{
+    public:
+    static void sum(MonitorEvalType<T> &eval, std::size_t iter,
+        std::size_t dim, Particle<T> &particle, double *r)
+    {
+        eval.template target<EvalType>()->sum(iter, dim, particle, r);
+    }
+}; // class MonitorEvalSumImpl
+
+template <typename T, typename EvalType>
+inline auto monitor_sum(const EvalType &, int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<double *>()),
+        std::declval<EvalType &>().sum(std::size_t(), std::size_t(),
+            std::declval<Particle<T> &>(), std::declval<double *>()),
+        MonitorEvalSum<T>())
+{
+    return &MonitorEvalSumImpl<T, EvalType>::sum;
+}
+
+template <typename T, typename EvalType>
+inline MonitorEvalSum<T> monitor_sum(const EvalType &, long)
+{
+    return nullptr;
+}
+
+/// \brief Dispatch to `eval.sum` if it is defined, such as `MonitorEvalSMP`,
+/// otherwise a null pointer
+///
+/// \details
+/// The evaluation object is the one stored by `monitor_eval`, which is
+/// therefore required to accept `double` values
+template <typename T, typename EvalType>
+inline MonitorEvalSum<T> monitor_sum(const EvalType &eval)
+{
+    return monitor_sum<T, typename std::decay<EvalType>::type>(eval, 0);
+}
+
+/// \brief Entry points of a fused pass, dispatched to the evaluation object
+/// stored in a `MonitorEvalType<T>`
+template <typename T>
+class MonitorEvalFused
+{
+    public:
+    void (*first)(MonitorEvalType<T> &, std::size_t, Particle<T> &);
+    void (*range)(MonitorEvalType<T> &, std::size_t, std::size_t,
+        const ParticleRange<T> &, double *);
+    void (*last)(MonitorEvalType<T> &, std::size_t, Particle<T> &);
+}; // class MonitorEvalFused
+
+template <typename T, typename EvalType>
+class MonitorEvalFusedImpl
+{
+    public:
+    static void first(
+        MonitorEvalType<T> &eval, std::size_t iter, Particle<T> &particle)
+    {
+        eval.template target<EvalType>()->fused_first(iter, particle);
+    }
+
+    static void range(MonitorEvalType<T> &eval, std::size_t iter,
+        std::size_t dim, const ParticleRange<T> &range, double *r)
+    {
+        eval.template target<EvalType>()->fused_range(iter, dim, range, r);
+    }
+
+    static void last(
+        MonitorEvalType<T> &eval, std::size_t iter, Particle<T> &particle)
+    {
+        eval.template target<EvalType>()->fused_last(iter, particle);
+    }
+}; // class MonitorEvalFusedImpl
+
+template <typename T, typename EvalType>
+inline auto monitor_fused(const EvalType &, int)
+    -> decltype(std::declval<EvalType &>()(std::size_t(), std::size_t(),
+                    std::declval<Particle<T> &>(), std::declval<double *>()),
+        std::declval<EvalType &>().fused_range(std::size_t(),
+                    std::size_t(), std::declval<const ParticleRange<T> &>(),
+                    std::declval<double *>()),
+        MonitorEvalFused<T>())
+{
+    using impl = MonitorEvalFusedImpl<T, EvalType>;
+
+    return {&impl::first, &impl::range, &impl::last};
+}
+
+template <typename T, typename EvalType>
+inline MonitorEvalFused<T> monitor_fused(const EvalType &, long)
+{
+    return {nullptr, nullptr, nullptr};
+}
+
+/// \brief Entry points of a fused pass if `eval.fused_range` is defined, such
+/// as `MonitorEvalSMP`, otherwise null pointers
+///
+/// \details
+/// As with `monitor_sum`, the evaluation object shall accept `double` values
+template <typename T, typename EvalType>
+inline MonitorEvalFused<T> monitor_fused(const EvalType &eval)
+{
+    return monitor_fused<T, typename std::decay<EvalType>::type>(eval, 0);
+}
+
+} // namespace mckl::internal
+
 /// \brief Monitor for Monte Carlo integration
 /// \ingroup Core
+///
+/// \details
+/// Unless it is record only, the evaluation object writes the `dim` values of
+/// each particle to a buffer, and the Monitor records their weighted sums. If
+/// streaming is enabled by `stream(true)`, and the evaluation object has a
+/// method `sum` with the same arguments as `operator()`, such as those derived
+/// from `MonitorEvalSMP`, which writes the weighted sums directly, then it is
+/// used instead, and no storage for the values of all particles is needed. It
+/// is called on the same copy of the evaluation object as `operator()`.
+///
+/// The evaluation object may also write `float` values, that is, its
+/// `operator()` takes a `float *` instead of a `double *`. Then the values of
+/// all particles are stored in single precision, which halves the storage and
+/// the memory traffic, while their weighted sums are still accumulated in
+/// double precision. If it accepts both, the `double` values are used.
+///
+/// If the evaluation object also has the methods `fused_first`,
+/// `fused_range` and `fused_last`, such as those derived from
+/// `MonitorEvalSMP`, then a Sampler with fused iterations enabled evaluates
+/// all such Monitors together in a single pass once the weights are
+/// normalized. Each block of particles is handed to each Monitor in turn, and
+/// its weighted sums are accumulated into partial sums of the block, which
+/// are added in order at last.
 template <typename T>
 class Monitor
 {
     public:
-    using eval_type =
-        std::function<void(std::size_t, std::size_t, Particle<T> &, double *)>;
+    using eval_type = internal::MonitorEvalType<T>;
 
-    Monitor(std::size_t dim, const eval_type &eval, bool record_only = false,
+    template <typename EvalType>
+    Monitor(std::size_t dim, const EvalType &eval, bool record_only = false,
         MonitorStage stage = MonitorMCMC)
         : dim_(dim)
-        , eval_(eval)
+        , eval_(internal::monitor_eval<T>(eval))
+        , eval_float_(internal::monitor_eval_float<T>(eval))
+        , sum_(internal::monitor_sum<T>(eval))
+        , fused_(internal::monitor_fused<T>(eval))
         , record_only_(record_only)
+        , fused_valid_(false)
+        , stream_(false)
         , stage_(stage)
         , name_(dim)
     {
+        static_assert(internal::MonitorEvalCallable<T, EvalType>::value,
+            "**Monitor::Monitor** used with an evaluation object that does "
+            "not accept double or float values");
+
         internal::size_check<MCKL_BLAS_INT>(dim_, "Monitor::Monitor");
     }
 
+    /// \brief Construct a Monitor without an evaluation object, which shall
+    /// be set by `eval` before it is evaluated
+    Monitor(std::size_t dim, std::nullptr_t, bool record_only = false,
+        MonitorStage stage = MonitorMCMC)
+        : Monitor(dim, eval_type(), record_only, stage)
+    {
+    }
+
     /// \brief The dimension of the Monitor
     std::size_t dim() const { return dim_; }
 
@@ -85,7 +326,19 @@ class Monitor
     }
 
     /// \brief Whether the evaluation object is valid
-    bool empty() const { return !eval_; }
+    bool empty() const { return !eval_ && !eval_float_; }
+
+    /// \brief Whether the weighted sums are computed by the method `sum` of
+    /// the evaluation object when it is defined
+    bool stream() const { return stream_; }
+
+    /// \brief Enable or disable computing the weighted sums by the method
+    /// `sum` of the evaluation object, which is disabled by default
+    void stream(bool flag) { stream_ = flag; }
+
+    /// \brief Whether the evaluation can be fused into the iterations of a
+    /// Sampler
+    bool fused() const { return fused_.range != nullptr && !record_only_; }
 
     /// \brief Read and write access to the names of variables
     ///
@@ -222,42 +475,130 @@ class Monitor
     }
 
     /// \brief Set a new evaluation object of type eval_type
-    void eval(const eval_type &new_eval, bool record_only = false,
+    template <typename EvalType>
+    void eval(const EvalType &new_eval, bool record_only = false,
         MonitorStage stage = MonitorMCMC)
     {
-        eval_ = new_eval;
+        static_assert(internal::MonitorEvalCallable<T, EvalType>::value,
+            "**Monitor::eval** used with an evaluation object that does not "
+            "accept double or float values");
+
+        eval_ = internal::monitor_eval<T>(new_eval);
+        eval_float_ = internal::monitor_eval_float<T>(new_eval);
+        sum_ = internal::monitor_sum<T>(new_eval);
+        fused_ = internal::monitor_fused<T>(new_eval);
         record_only_ = record_only;
         stage_ = stage;
     }
 
+    /// \brief Remove the evaluation object
+    void eval(std::nullptr_t, bool record_only = false,
+        MonitorStage stage = MonitorMCMC)
+    {
+        eval(eval_type(), record_only, stage);
+    }
+
+    /// \brief Called before a fused pass over `nblocks` blocks of particles
+    void fused_first(
+        std::size_t iter, Particle<T> &particle, std::size_t nblocks)
+    {
+        internal::size_check<MCKL_BLAS_INT>(
+            particle.size(), "Monitor::fused_first");
+
+        partial_.assign(nblocks * dim_, 0.0);
+        fused_.first(eval_, iter, particle);
+    }
+
+    /// \brief Evaluate the values of the `block`-th block of particles within
+    /// a fused pass and accumulate their weighted sums
+    ///
+    /// \details
+    /// `buffer` shall have space for the values of all particles in `range`.
+    void fused_range(std::size_t iter, std::size_t block,
+        const ParticleRange<T> &range, double *buffer)
+    {
+        fused_.range(eval_, iter, dim_, range, buffer);
+        internal::monitor_dgemv(dim_, static_cast<std::size_t>(range.size()),
+            buffer, range.particle().weight().data() + range.first(),
+            partial_.data() + block * dim_);
+    }
+
+    /// \brief Called after a fused pass over all particles
+    void fused_last(std::size_t iter, Particle<T> &particle)
+    {
+        fused_.last(eval_, iter, particle);
+        result_.resize(dim_);
+        std::fill(result_.begin(), result_.end(), 0.0);
+        for (std::size_t i = 0; i < partial_.size(); i += dim_)
+            add(dim_, result_.data(), partial_.data() + i, result_.data());
+        partial_.clear();
+        fused_valid_ = true;
+    }
+
     /// \brief Perform the evaluation for a given iteration and a Particle<T>
     /// object.
-    void operator()(
-        std::size_t iter, Particle<T> &particle, MonitorStage stage)
+    ///
+    /// \details
+    /// If `fused` is `true`, the weighted sums computed by the last fused pass
+    /// are used instead of evaluating them again.
+    void operator()(std::size_t iter, Particle<T> &particle,
+        MonitorStage stage, bool fused = false)
     {
         internal::size_check<MCKL_BLAS_INT>(particle.size(), "Monitor::eval");
 
         if (stage != stage_)
             return;
 
-        runtime_assert(static_cast<bool>(eval_),
+        runtime_assert(!empty(),
             "**Monitor::operator()** invalid evaluation object");
 
+        if (fused) {
+            runtime_assert(fused_valid_,
+                "**Monitor::operator()** no values computed by a fused pass");
+            push_back(iter);
+
+            return;
+        }
+        fused_valid_ = false;
+
         result_.resize(dim_);
-        if (record_only_) {
+        if (record_only_ && eval_) {
             eval_(iter, dim_, particle, result_.data());
             push_back(iter);
 
             return;
         }
 
+        if (record_only_) {
+            buffer_float_.resize(dim_);
+            eval_float_(iter, dim_, particle, buffer_float_.data());
+            std::copy(
+                buffer_float_.begin(), buffer_float_.end(), result_.begin());
+            push_back(iter);
+
+            return;
+        }
+
+        if (stream_ && sum_) {
+            sum_(eval_, iter, dim_, particle, result_.data());
+            push_back(iter);
+
+            return;
+        }
+
         const std::size_t N = static_cast<std::size_t>(particle.size());
-        buffer_.resize(N * dim_);
-        eval_(iter, dim_, particle, buffer_.data());
-        internal::cblas_dgemv(internal::CblasColMajor, internal::CblasNoTrans,
-            static_cast<MCKL_BLAS_INT>(dim_), static_cast<MCKL_BLAS_INT>(N),
-            1.0, buffer_.data(), static_cast<MCKL_BLAS_INT>(dim_),
-            particle.weight().data(), 1, 0.0, result_.data(), 1);
+        std::fill(result_.begin(), result_.end(), 0.0);
+        if (eval_) {
+            buffer_.resize(N * dim_);
+            eval_(iter, dim_, particle, buffer_.data());
+            internal::monitor_dgemv(dim_, N, buffer_.data(),
+                particle.weight().data(), result_.data());
+        } else {
+            buffer_float_.resize(N * dim_);
+            eval_float_(iter, dim_, particle, buffer_float_.data());
+            internal::monitor_dgemv(dim_, N, buffer_float_.data(),
+                particle.weight().data(), result_.data());
+        }
         push_back(iter);
     }
 
@@ -268,16 +609,53 @@ class Monitor
         record_.clear();
     }
 
+    /// \brief Store the records in checkpoint sections prefixed by `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        ar.write(name + "/Dim", dim_);
+        ar.write(name + "/Index", index_.size(), index_.data());
+        ar.write(name + "/Record", record_.size(), record_.data());
+    }
+
+    /// \brief Restore the records from checkpoint sections prefixed by
+    /// `name`
+    ///
+    /// \details
+    /// The records are restored only if they have the same dimension as this
+    /// Monitor.
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        std::size_t dim = 0;
+        if (!ar.read(name + "/Dim", dim) || dim != dim_)
+            return false;
+
+        const std::size_t n = ar.size(name + "/Index");
+        index_.resize(n);
+        record_.resize(n * dim_);
+
+        return ar.read(name + "/Index", index_.size(), index_.data()) &&
+            ar.read(name + "/Record", record_.size(), record_.data());
+    }
+
     private:
     std::size_t dim_;
     eval_type eval_;
+    internal::MonitorEvalFloatType<T> eval_float_;
+    internal::MonitorEvalSum<T> sum_;
+    internal::MonitorEvalFused<T> fused_;
     bool record_only_;
+    bool fused_valid_;
+    bool stream_;
     MonitorStage stage_;
     Vector<std::string> name_;
     Vector<std::size_t> index_;
     Vector<double> record_;
     Vector<double> result_;
     Vector<double> buffer_;
+    Vector<float> buffer_float_;
+    Vector<double> partial_;
 
     void push_back(std::size_t iter)
     {
@@ -386,17 +386,21 @@ class Particle
     ///
     /// \details
     /// The particle system is resampled to a new system with possibly
-    /// different size. The system will be changed even if `N == size()`.
+    /// different size. The system will be changed even if `N == size()`. The
+    /// replication numbers and parent indices are stored in a workspace owned
+    /// by this object, and reused by subsequent calls.
     template <typename ResampleType>
     void resize_by_resample(size_type N, ResampleType &&op)
     {
-        Vector<size_type> rep(static_cast<std::size_t>(size_));
-        Vector<size_type> idx(static_cast<std::size_t>(N));
+        size_type *const rep =
+            workspace_.get<size_type>(0, static_cast<std::size_t>(size_));
+        size_type *const idx =
+            workspace_.get<size_type>(1, static_cast<std::size_t>(N));
         op(static_cast<std::size_t>(size_), static_cast<std::size_t>(N), rng_,
-            weight_.data(), rep.data());
+            weight_.data(), rep);
         resample_trans_rep_index(static_cast<std::size_t>(size_),
-            static_cast<std::size_t>(N), rep.data(), idx.data());
-        resize(N, idx.data());
+            static_cast<std::size_t>(N), rep, idx);
+        resize(N, idx);
     }
 
     /// \brief Resize by uniformly selecting from all particles
@@ -471,6 +475,36 @@ class Particle
         return ParticleRange<T>(0, size(), this, grainsize);
     }
 
+    /// \brief Store the particle system in checkpoint sections prefixed by
+    /// `name`
+    ///
+    /// \details
+    /// The state collection object shall have methods `checkpoint_store` and
+    /// `checkpoint_load` with the same signatures as these, such as those of
+    /// StateMatrix. The RNG set shall be one of RNGSetScalar, RNGSetVector and
+    /// RNGSetCounter, whose engines are stored bit exactly.
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        ar.write(name + "/Size", size_);
+        state_.checkpoint_store(ar, name + "/State");
+        weight_.checkpoint_store(ar, name + "/Weight");
+        rng_set_.checkpoint_store(ar, name + "/RNGSet");
+        ar.write(name + "/RNG", rng_);
+    }
+
+    /// \brief Restore the particle system from checkpoint sections prefixed
+    /// by `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        return ar.read(name + "/Size", size_) &&
+            state_.checkpoint_load(ar, name + "/State") &&
+            weight_.checkpoint_load(ar, name + "/Weight") &&
+            rng_set_.checkpoint_load(ar, name + "/RNGSet") &&
+            ar.read(name + "/RNG", rng_);
+    }
+
     private:
     static constexpr std::size_t M_ = internal::BufferSize<size_type>::value;
 
@@ -479,6 +513,7 @@ class Particle
     weight_type weight_;
     rng_set_type rng_set_;
     rng_type rng_;
+    ResampleWorkspace workspace_;
 
     void resize(size_type N, const size_type *idx)
     {
@@ -497,9 +532,10 @@ class Particle
     template <typename InputIter>
     void resize_by_index(size_type N, InputIter index, std::false_type)
     {
-        Vector<size_type> idx(static_cast<std::size_t>(N));
-        std::copy_n(index, N, idx.data());
-        resize(N, idx.data());
+        size_type *const idx =
+            workspace_.get<size_type>(1, static_cast<std::size_t>(N));
+        std::copy_n(index, N, idx);
+        resize(N, idx);
     }
 
     template <typename InputIter, typename OutputIter>
@@ -35,6 +35,7 @@
 #include <mckl/internal/common.hpp>
 #include <mckl/core/monitor.hpp>
 #include <mckl/core/particle.hpp>
+#include <mckl/utility/stop_watch.hpp>
 
 namespace mckl
 {
@@ -85,6 +86,84 @@ inline SamplerStage &operator^=(SamplerStage &s1, SamplerStage s2)
     return s1 = s1 ^ s2;
 }
 
+namespace internal
+{
+
+template <typename T>
+using SamplerEvalType = std::function<void(std::size_t, Particle<T> &)>;
+
+/// \brief Entry points of a fused pass, dispatched to the evaluation object
+/// stored in a `SamplerEvalType<T>`
+template <typename T>
+class SamplerEvalFused
+{
+    public:
+    void (*first)(SamplerEvalType<T> &, std::size_t, Particle<T> &);
+    void (*range)(
+        SamplerEvalType<T> &, std::size_t, const ParticleRange<T> &);
+    void (*last)(SamplerEvalType<T> &, std::size_t, Particle<T> &);
+}; // class SamplerEvalFused
+
+template <typename T, typename EvalType>
+class SamplerEvalFusedImpl
+{
+    public:
+    static void first(
+        SamplerEvalType<T> &eval, std::size_t iter, Particle<T> &particle)
+    {
+        eval.template target<EvalType>()->fused_first(iter, particle);
+    }
+
+    static void range(SamplerEvalType<T> &eval, std::size_t iter,
+        const ParticleRange<T> &range)
+    {
+        eval.template target<EvalType>()->fused_range(iter, range);
+    }
+
+    static void last(
+        SamplerEvalType<T> &eval, std::size_t iter, Particle<T> &particle)
+    {
+        eval.template target<EvalType>()->fused_last(iter, particle);
+    }
+}; // class SamplerEvalFusedImpl
+
+template <typename T, typename EvalType>
+inline auto sampler_fused(const EvalType &, int)
+    -> decltype(std::declval<EvalType &>().fused_range(std::size_t(),
+                    std::declval<const ParticleRange<T> &>()),
+        SamplerEvalFused<T>())
+{
+    using impl = SamplerEvalFusedImpl<T, EvalType>;
+
+    return {&impl::first, &impl::range, &impl::last};
+}
+
+template <typename T, typename EvalType>
+inline SamplerEvalFused<T> sampler_fused(const EvalType &, long)
+{
+    return {nullptr, nullptr, nullptr};
+}
+
+/// \brief Entry points of a fused pass if `eval.fused_range` is defined, such
+/// as `SamplerEvalSMP`, otherwise null pointers
+template <typename T, typename EvalType>
+inline SamplerEvalFused<T> sampler_fused(const EvalType &eval)
+{
+    return sampler_fused<T, typename std::decay<EvalType>::type>(eval, 0);
+}
+
+using SamplerFusedWork = std::function<void(std::size_t, std::size_t)>;
+
+using SamplerFusedRun = void (*)(std::size_t, const SamplerFusedWork &);
+
+template <typename Backend>
+inline void sampler_fused_run(std::size_t n, const SamplerFusedWork &work)
+{
+    BackendFor<Backend>::run(n, 1, work);
+}
+
+} // namespace mckl::internal
+
 /// \brief SMC Sampler
 /// \ingroup Core
 template <typename T>
@@ -92,7 +171,7 @@ class Sampler
 {
     public:
     using size_type = typename Particle<T>::size_type;
-    using eval_type = std::function<void(std::size_t, Particle<T> &)>;
+    using eval_type = internal::SamplerEvalType<T>;
 
     /// \brief Construct a Sampler
     ///
@@ -103,6 +182,9 @@ class Sampler
         : particle_(std::forward<Args>(args)...)
         , iter_num_(0)
         , resample_threshold_(resample_threshold_never())
+        , fused_run_(nullptr)
+        , fused_valid_(false)
+        , profile_(false)
     {
     }
 
@@ -154,6 +236,7 @@ class Sampler
         size_history_.clear();
         ess_history_.clear();
         resampled_history_.clear();
+        profile_history_.clear();
     }
 
     /// \brief Set resampling method by a built-in ResampleScheme scheme
@@ -215,15 +298,98 @@ class Sampler
     static double resample_threshold_always() { return const_inf<double>(); }
 
     /// \brief Add a new evaluation object
-    Sampler<T> &eval(const eval_type &new_eval, SamplerStage stage)
+    template <typename EvalType>
+    Sampler<T> &eval(const EvalType &new_eval, SamplerStage stage)
     {
-        eval_.push_back(std::make_pair(stage, new_eval));
+        eval_.push_back(std::make_pair(stage, eval_type(new_eval)));
+        eval_fused_.push_back(internal::sampler_fused<T>(new_eval));
 
         return *this;
     }
 
     /// \brief Clear the evaluation sequence
-    void eval_clear() { eval_.clear(); }
+    void eval_clear()
+    {
+        eval_.clear();
+        eval_fused_.clear();
+    }
+
+    /// \brief If fused iterations are enabled
+    bool fused() const { return fused_run_ != nullptr; }
+
+    /// \brief Enable or disable fused iterations
+    ///
+    /// \details
+    /// Normally each iteration applies the move evaluation objects one after
+    /// another, each in a pass over all particles, and then each Monitor in
+    /// another pass. When fused iterations are enabled, and all objects added
+    /// with the stage `SamplerMove` have the methods `fused_first`,
+    /// `fused_range` and `fused_last`, such as those derived from
+    /// `SamplerEvalSMP`, an iteration makes a single parallel pass over blocks
+    /// of particles using `Backend`. Each block is handed to all move
+    /// evaluation objects in order, including the one that computes the
+    /// incremental weights, while the block is still in cache. The
+    /// `fused_first` and `fused_last` methods are called before and after the
+    /// pass, and thus the normalization of the weights, such as
+    /// `Weight::add_log` called by `fused_last`, becomes a final reduction
+    /// over the weights. Otherwise the iteration falls back to the normal
+    /// one.
+    ///
+    /// The Monitors that can be fused are then evaluated together in a second
+    /// pass, which accumulates the weighted sums of each block without
+    /// storing the values of all particles. A Monitor is fused only if it is
+    /// evaluated at the `MonitorMove` stage, or at a later stage when no
+    /// resampling, which is possible whenever the threshold is positive, or
+    /// MCMC move can change the particles before its evaluation. Other
+    /// Monitors are evaluated at their stages as usual.
+    ///
+    /// The RNG set is stepped once before each pass instead of once before
+    /// each move or Monitor. If the RNG set has the method `pass`, such as
+    /// `RNGSetCounter`, the step reserves one set of streams for each move or
+    /// Monitor, and the streams of each are selected before it processes a
+    /// block, such that their random numbers are as if they were evaluated
+    /// one after another.
+    template <typename Backend = BackendSMP>
+    Sampler<T> &fused(bool flag)
+    {
+        fused_run_ = flag ? internal::sampler_fused_run<Backend> : nullptr;
+
+        return *this;
+    }
+
+    /// \brief If profiling is enabled
+    bool profile() const { return profile_; }
+
+    /// \brief Enable or disable profiling
+    ///
+    /// \details
+    /// When profiling is enabled, the wall time, in milliseconds, and the
+    /// number of cycles, counted by `rdtsc`, spent in each iteration are
+    /// recorded for
+    /// - each stage, with columns `Time.Move`, `Time.Monitor`,
+    /// `Time.Resample` and `Time.MCMC`, where the initialization counts as
+    /// the move of iteration zero;
+    /// - each evaluation object, with columns `Time.Eval.k`, where `k` is the
+    /// order in which it is added;
+    /// - each Monitor, with columns `Time.Monitor.name`,
+    ///
+    /// and the corresponding `Cycles` columns. They are included in the
+    /// results of `summary()` and `print()`, with NaN for iterations not
+    /// profiled. The `Time.Eval.k` of an evaluation object not run in an
+    /// iteration, such as one for initialization only within `iterate`, is
+    /// also NaN. The move evaluation objects and the Monitors of a fused
+    /// iteration are not timed separately. Instead, the fused pass is counted
+    /// as a whole in `Time.Move`, and the move evaluation objects are
+    /// considered not run.
+    ///
+    /// When profiling is disabled, which is the default, nothing is measured
+    /// and no memory is used.
+    Sampler<T> &profile(bool flag)
+    {
+        profile_ = flag;
+
+        return *this;
+    }
 
     /// \brief Attach a new monitor
     ///
@@ -351,6 +517,12 @@ class Sampler
 
         df["ESS"] = ess_history_;
 
+        for (const auto &p : profile_history_) {
+            data = p.second;
+            data.resize(iter_size(), const_nan<double>());
+            df[p.first] = data;
+        }
+
         for (const auto &m : monitor_) {
             if (m.second.iter_size() > 0) {
                 for (std::size_t d = 0; d != m.second.dim(); ++d) {
@@ -399,6 +571,67 @@ class Sampler
         return os;
     }
 
+    /// \brief Store the state of the Sampler in checkpoint sections prefixed
+    /// by `name`
+    ///
+    /// \details
+    /// The particle system, the iteration number, the histories and the
+    /// records of all Monitors are stored. The evaluation objects, the
+    /// resampling method and threshold are not.
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        const Vector<unsigned char> resampled(
+            resampled_history_.begin(), resampled_history_.end());
+
+        ar.write(name + "/IterNum", iter_num_);
+        ar.write(name + "/SizeHistory", size_history_.size(),
+            size_history_.data());
+        ar.write(
+            name + "/ESSHistory", ess_history_.size(), ess_history_.data());
+        ar.write(
+            name + "/ResampledHistory", resampled.size(), resampled.data());
+        particle_.checkpoint_store(ar, name + "/Particle");
+        for (const auto &m : monitor_)
+            m.second.checkpoint_store(ar, name + "/Monitor/" + m.first);
+    }
+
+    /// \brief Restore the state of the Sampler from checkpoint sections
+    /// prefixed by `name`
+    ///
+    /// \details
+    /// Monitors of this Sampler not found in the checkpoint are cleared, and
+    /// those found in the checkpoint but not added to this Sampler are
+    /// ignored.
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        const std::size_t n = ar.size(name + "/SizeHistory");
+        Vector<unsigned char> resampled(n);
+        size_history_.resize(n);
+        ess_history_.resize(n);
+        fused_valid_ = false;
+
+        if (!ar.read(name + "/IterNum", iter_num_) ||
+            !ar.read(name + "/SizeHistory", n, size_history_.data()) ||
+            !ar.read(name + "/ESSHistory", n, ess_history_.data()) ||
+            !ar.read(name + "/ResampledHistory", n, resampled.data()) ||
+            !particle_.checkpoint_load(ar, name + "/Particle")) {
+            return false;
+        }
+        resampled_history_.assign(resampled.begin(), resampled.end());
+
+        for (auto &m : monitor_) {
+            const std::string mname = name + "/Monitor/" + m.first;
+            if (!ar.contains(mname + "/Index"))
+                m.second.clear();
+            else if (!m.second.checkpoint_load(ar, mname))
+                return false;
+        }
+
+        return true;
+    }
+
     private:
     Particle<T> particle_;
     std::size_t iter_num_;
@@ -406,64 +639,197 @@ class Sampler
     double resample_threshold_;
     eval_type resample_eval_;
     Vector<std::pair<SamplerStage, eval_type>> eval_;
+    Vector<internal::SamplerEvalFused<T>> eval_fused_;
     Vector<std::pair<std::string, Monitor<T>>> monitor_;
+    internal::SamplerFusedRun fused_run_;
+    bool fused_valid_;
+    Vector<std::size_t> fused_moves_;
+    Vector<Monitor<T> *> fused_monitors_;
 
     Vector<size_type> size_history_;
     Vector<double> ess_history_;
     Vector<bool> resampled_history_;
 
+    bool profile_;
+    StopWatch profile_move_;
+    StopWatch profile_monitor_;
+    StopWatch profile_resample_;
+    StopWatch profile_mcmc_;
+    Vector<StopWatch> profile_eval_;
+    Vector<bool> profile_eval_run_;
+    Vector<StopWatch> profile_monitor_each_;
+    std::map<std::string, Vector<double>> profile_history_;
+
     void do_initialize()
     {
         clear();
-        do_init();
+        fused_valid_ = false;
+        profile_reset();
+        {
+            StopWatchGuard<StopWatch> guard(profile_move_, profile_);
+            do_init();
+        }
         do_common();
     }
 
     void do_iterate()
     {
         ++iter_num_;
-        do_move();
+        profile_reset();
+        {
+            StopWatchGuard<StopWatch> guard(profile_move_, profile_);
+            fused_valid_ = do_fused();
+            if (!fused_valid_)
+                do_move();
+        }
         do_common();
     }
 
     void do_common()
     {
         do_monitor(MonitorMove);
-        do_resample(resample_threshold_);
+        {
+            StopWatchGuard<StopWatch> guard(profile_resample_, profile_);
+            do_resample(resample_threshold_);
+        }
         do_monitor(MonitorResample);
-        do_mcmc();
+        {
+            StopWatchGuard<StopWatch> guard(profile_mcmc_, profile_);
+            do_mcmc();
+        }
         do_monitor(MonitorMCMC);
+        profile_push_back();
     }
 
-    void do_init()
+    void do_init() { do_eval(SamplerInit); }
+
+    void do_move() { do_eval(SamplerMove); }
+
+    void do_eval(SamplerStage stage)
     {
-        for (auto &e : eval_) {
-            if ((e.first & SamplerInit) != 0) {
-                runtime_assert(static_cast<bool>(e.second),
+        for (std::size_t k = 0; k != eval_.size(); ++k) {
+            if ((eval_[k].first & stage) != 0) {
+                runtime_assert(static_cast<bool>(eval_[k].second),
                     "**Sampler** invalid evaluation object");
-                e.second(iter_num_, particle_);
+                internal::rng_set_step(particle_.rng_set());
+                StopWatchGuard<StopWatch> guard(profile_eval(k), profile_);
+                eval_[k].second(iter_num_, particle_);
             }
         }
     }
 
-    void do_move()
+    // Return false without doing anything if any move evaluation object
+    // cannot be fused
+    bool do_fused()
     {
-        for (auto &e : eval_) {
-            if ((e.first & SamplerMove) != 0) {
-                runtime_assert(static_cast<bool>(e.second),
+        if (fused_run_ == nullptr)
+            return false;
+
+        fused_moves_.clear();
+        for (std::size_t k = 0; k != eval_.size(); ++k) {
+            if ((eval_[k].first & SamplerMove) != 0) {
+                if (eval_fused_[k].range == nullptr)
+                    return false;
+                runtime_assert(static_cast<bool>(eval_[k].second),
                     "**Sampler** invalid evaluation object");
-                e.second(iter_num_, particle_);
+                fused_moves_.push_back(k);
+            }
+        }
+
+        fused_monitors_.clear();
+        std::size_t dim = 0;
+        for (auto &m : monitor_) {
+            if (fused_monitor(m.second)) {
+                fused_monitors_.push_back(&m.second);
+                dim = std::max(dim, m.second.dim());
             }
         }
+
+        const std::size_t N = static_cast<std::size_t>(size());
+        const std::size_t bs = internal::BufferSize<double>::value;
+        const std::size_t nb = N / bs + (N % bs == 0 ? 0 : 1);
+        auto range = [this, N, bs](std::size_t j) {
+            return particle_.range(static_cast<size_type>(j * bs),
+                static_cast<size_type>(std::min(N, (j + 1) * bs)));
+        };
+
+        // Each move draws from the streams of its own pass, the same as those
+        // of its separate evaluation in an iteration that is not fused
+        internal::rng_set_step(particle_.rng_set(), fused_moves_.size());
+        for (auto k : fused_moves_)
+            eval_fused_[k].first(eval_[k].second, iter_num_, particle_);
+        fused_run_(nb, [&](std::size_t b, std::size_t e) {
+            for (std::size_t j = b; j != e; ++j) {
+                const ParticleRange<T> r = range(j);
+                for (std::size_t p = 0; p != fused_moves_.size(); ++p) {
+                    const std::size_t k = fused_moves_[p];
+                    internal::rng_set_pass(particle_.rng_set(), p);
+                    eval_fused_[k].range(eval_[k].second, iter_num_, r);
+                }
+            }
+        });
+        for (auto k : fused_moves_)
+            eval_fused_[k].last(eval_[k].second, iter_num_, particle_);
+
+        if (fused_monitors_.empty())
+            return true;
+
+        // The weighted sums need the normalized weights, and thus the
+        // Monitors make a second pass, sharing each block among them
+        internal::rng_set_step(particle_.rng_set(), fused_monitors_.size());
+        for (auto m : fused_monitors_)
+            m->fused_first(iter_num_, particle_, nb);
+        fused_run_(nb, [&](std::size_t b, std::size_t e) {
+            Vector<double> buffer(bs * dim);
+            for (std::size_t j = b; j != e; ++j) {
+                const ParticleRange<T> r = range(j);
+                for (std::size_t p = 0; p != fused_monitors_.size(); ++p) {
+                    internal::rng_set_pass(particle_.rng_set(), p);
+                    fused_monitors_[p]->fused_range(
+                        iter_num_, j, r, buffer.data());
+                }
+            }
+        });
+        for (auto m : fused_monitors_)
+            m->fused_last(iter_num_, particle_);
+
+        return true;
+    }
+
+    // A Monitor is fused only if no stage between the moves and its
+    // evaluation can change the particles
+    bool fused_monitor(const Monitor<T> &m) const
+    {
+        if (m.empty() || !m.fused())
+            return false;
+
+        const bool resample = resample_threshold_ > 0;
+        bool mcmc = false;
+        for (const auto &e : eval_)
+            mcmc = mcmc || (e.first & SamplerMCMC) != 0;
+
+        switch (m.stage()) {
+            case MonitorMove:
+                return true;
+            case MonitorResample:
+                return !resample;
+            case MonitorMCMC:
+                return !resample && !mcmc;
+        }
+
+        return false;
     }
 
     void do_mcmc()
     {
-        for (auto &e : eval_) {
-            if ((e.first & SamplerMCMC) != 0) {
-                runtime_assert(static_cast<bool>(e.second),
+        for (std::size_t k = 0; k != eval_.size(); ++k) {
+            if ((eval_[k].first & SamplerMCMC) != 0) {
+                runtime_assert(static_cast<bool>(eval_[k].second),
                     "**Sampler** invalid evaluation object");
-                e.second(iter_num_, particle_);
+                internal::rng_set_step(particle_.rng_set());
+                StopWatchGuard<StopWatch> guard(profile_eval(k), profile_);
+                eval_[k].second(iter_num_, particle_);
+                fused_valid_ = false;
             }
         }
     }
@@ -476,6 +842,7 @@ class Sampler
         if (ess_history_.back() < size() * threshold) {
             resampled_history_.push_back(true);
             resample_eval_(iter_num_, particle_);
+            fused_valid_ = false;
         } else {
             resampled_history_.push_back(false);
         }
@@ -483,9 +850,88 @@ class Sampler
 
     void do_monitor(MonitorStage stage)
     {
-        for (auto &m : monitor_)
-            if (!m.second.empty())
-                m.second(iter_num_, particle_, stage);
+        StopWatchGuard<StopWatch> guard(profile_monitor_, profile_);
+        for (std::size_t i = 0; i != monitor_.size(); ++i) {
+            Monitor<T> &m = monitor_[i].second;
+            if (!m.empty()) {
+                internal::rng_set_step(particle_.rng_set());
+                StopWatchGuard<StopWatch> guard_each(
+                    profile_monitor_each(i), profile_);
+                m(iter_num_, particle_, stage,
+                    fused_valid_ && fused_monitor(m));
+            }
+        }
+    }
+
+    // The watches are only accessed when profiling is enabled, and thus
+    // `profile_reset` has allocated them for this iteration. Otherwise a
+    // reference to an unused watch is returned. The evaluation object is
+    // marked as run in this iteration
+    StopWatch &profile_eval(std::size_t k)
+    {
+        if (!profile_)
+            return profile_move_;
+        profile_eval_run_[k] = true;
+
+        return profile_eval_[k];
+    }
+
+    StopWatch &profile_monitor_each(std::size_t i)
+    {
+        return profile_ ? profile_monitor_each_[i] : profile_monitor_;
+    }
+
+    void profile_reset()
+    {
+        if (!profile_)
+            return;
+
+        profile_move_.reset();
+        profile_monitor_.reset();
+        profile_resample_.reset();
+        profile_mcmc_.reset();
+        profile_eval_.clear();
+        profile_eval_.resize(eval_.size());
+        profile_eval_run_.clear();
+        profile_eval_run_.resize(eval_.size(), false);
+        profile_monitor_each_.clear();
+        profile_monitor_each_.resize(monitor_.size());
+    }
+
+    void profile_push_back()
+    {
+        if (!profile_)
+            return;
+
+        profile_push_back("Move", profile_move_);
+        profile_push_back("Monitor", profile_monitor_);
+        profile_push_back("Resample", profile_resample_);
+        profile_push_back("MCMC", profile_mcmc_);
+        for (std::size_t k = 0; k != eval_.size(); ++k) {
+            profile_push_back("Eval." + std::to_string(k), profile_eval_[k],
+                profile_eval_run_[k]);
+        }
+        for (std::size_t i = 0; i != monitor_.size(); ++i) {
+            profile_push_back(
+                "Monitor." + monitor_[i].first, profile_monitor_each_[i]);
+        }
+    }
+
+    // Append a record of the current iteration, such that its index is the
+    // same as that of the iteration, padded with NaN if necessary. The record
+    // is NaN if the watch was not run in this iteration
+    void profile_push_back(
+        const std::string &name, const StopWatch &watch, bool run = true)
+    {
+        const std::size_t iter = iter_size() - 1;
+
+        Vector<double> &time = profile_history_["Time." + name];
+        time.resize(iter, const_nan<double>());
+        time.push_back(run ? watch.milliseconds() : const_nan<double>());
+
+        Vector<double> &cycles = profile_history_["Cycles." + name];
+        cycles.resize(iter, const_nan<double>());
+        cycles.push_back(run ? watch.cycles() : const_nan<double>());
     }
 }; // class Sampler
 
@@ -33,6 +33,19 @@
 #define MCKL_CORE_STATE_MATRIX_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/resample/transform.hpp>
+#include <mckl/smp/backend_seq.hpp>
+
+#if MCKL_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+/// \brief Minimum size in bytes of a RowMajor StateMatrix for which
+/// `select_rep` uses non-temporal stores
+/// \ingroup Config
+#ifndef MCKL_STATE_MATRIX_STREAM_SIZE
+#define MCKL_STATE_MATRIX_STREAM_SIZE (1 << 24)
+#endif
 
 namespace mckl
 {
@@ -40,6 +53,40 @@ namespace mckl
 namespace internal
 {
 
+template <typename T>
+inline void state_matrix_stream(std::size_t n, const T *src, T *dst)
+{
+    std::copy_n(src, n, dst);
+}
+
+#if MCKL_HAS_SSE2
+
+inline void state_matrix_stream(std::size_t n, const float *src, float *dst)
+{
+    for (; n != 0 && reinterpret_cast<std::uintptr_t>(dst) % 16 != 0; --n)
+        *dst++ = *src++;
+    for (; n >= 4; n -= 4, src += 4, dst += 4)
+        _mm_stream_ps(dst, _mm_loadu_ps(src));
+    std::copy_n(src, n, dst);
+}
+
+inline void state_matrix_stream(std::size_t n, const double *src, double *dst)
+{
+    for (; n != 0 && reinterpret_cast<std::uintptr_t>(dst) % 16 != 0; --n)
+        *dst++ = *src++;
+    for (; n >= 2; n -= 2, src += 2, dst += 2)
+        _mm_stream_pd(dst, _mm_loadu_pd(src));
+    std::copy_n(src, n, dst);
+}
+
+inline void state_matrix_stream_fence() { _mm_sfence(); }
+
+#else // MCKL_HAS_SSE2
+
+inline void state_matrix_stream_fence() {}
+
+#endif // MCKL_HAS_SSE2
+
 template <std::size_t Dim>
 class StateMatrixDim
 {
@@ -168,6 +215,34 @@ class StateMatrixBase : private internal::StateMatrixDim<Dim>
         data_.swap(other.data_);
     }
 
+    /// \brief Store the matrix in checkpoint sections prefixed by `name`
+    ///
+    /// \details
+    /// A state type derived from StateMatrix with additional members shall
+    /// hide this method and the following one, and call them in turn.
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        const std::array<size_type, 2> shape = {{size_, dim()}};
+        ar.write(name + "/Shape", shape.size(), shape.data());
+        ar.write(name + "/Data", data_.size(), data_.data());
+    }
+
+    /// \brief Restore the matrix from checkpoint sections prefixed by `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        std::array<size_type, 2> shape;
+        if (!ar.read(name + "/Shape", shape.size(), shape.data()))
+            return false;
+        if (Dim != Dynamic && shape[1] != Dim)
+            return false;
+
+        resize_data(shape[0], shape[1]);
+
+        return ar.read(name + "/Data", data_.size(), data_.data());
+    }
+
     protected:
     explicit StateMatrixBase(size_type N) : size_(N), data_(N * Dim) {}
 
@@ -197,6 +272,68 @@ class StateMatrixBase : private internal::StateMatrixDim<Dim>
         data_.resize(N * dim);
     }
 
+    // Transform the replication numbers into parent indices a block at a
+    // time and call `work(index, first, n)` for each block, where `index` is
+    // the parent indices of the `n` destinations starting at `first`. The
+    // blocks are processed in parallel unless `Backend` is BackendSEQ, in
+    // which case no memory is allocated.
+    template <typename Backend, typename InputIter, typename WorkType>
+    static void select_rep_run(
+        size_type N, size_type M, InputIter replication, WorkType &&work)
+    {
+        select_rep_run<Backend>(N, M, replication, std::forward<WorkType>(work),
+            std::is_same<Backend, BackendSEQ>());
+    }
+
+    template <typename Backend, typename InputIter, typename WorkType>
+    static void select_rep_run(size_type N, size_type M,
+        InputIter replication, WorkType &&work, std::true_type)
+    {
+        using trans_type = internal::ResampleTransRepIndex<InputIter>;
+
+        static constexpr size_type K = internal::BufferSize<size_type>::value;
+
+        trans_type trans(N, M, replication);
+        Array<size_type, K> index;
+        for (size_type first = 0; first < M; first += K) {
+            const size_type n = std::min(K, M - first);
+            trans(n, index.data());
+            work(index.data(), first, n);
+        }
+    }
+
+    template <typename Backend, typename InputIter, typename WorkType>
+    static void select_rep_run(size_type N, size_type M,
+        InputIter replication, WorkType &&work, std::false_type)
+    {
+        using trans_type = internal::ResampleTransRepIndex<InputIter>;
+
+        static constexpr size_type K = internal::BufferSize<size_type>::value;
+
+        const size_type nb = M / K + (M % K == 0 ? 0 : 1);
+        if (nb < 2) {
+            select_rep_run<Backend>(N, M, replication,
+                std::forward<WorkType>(work), std::true_type());
+            return;
+        }
+
+        Vector<trans_type> state(nb, trans_type(N, M, replication));
+        Vector<std::size_t> extra(N / K + 2);
+        Vector<std::size_t> hole(M / K + 2);
+        internal::resample_trans_rep_index_state<Backend>(
+            N, M, replication, K, state.data(), extra.data(), hole.data());
+
+        internal::BackendFor<Backend>::run(
+            nb, 1, [M, &state, &work](std::size_t first, std::size_t last) {
+                Array<size_type, K> index;
+                for (std::size_t b = first; b != last; ++b) {
+                    const size_type n = std::min(K, M - b * K);
+                    state[b](n, index.data());
+                    work(index.data(), b * K, n);
+                }
+            });
+    }
+
     size_type data_size() const { return data_.size(); }
 
     friend bool operator==(const StateMatrixBase<Layout, Dim, T> &state1,
@@ -380,6 +517,69 @@ class StateMatrix<RowMajor, Dim, T> : public StateMatrixBase<RowMajor, Dim, T>
         return;
     }
 
+    /// \brief Select samples using replication numbers
+    ///
+    /// \param N The new sample size
+    /// \param replication `size()`-vector of replication numbers, which sum
+    /// to `N`
+    ///
+    /// \details
+    /// This is equivalent to `select` with the parent indices computed by
+    /// `resample_trans_rep_index`. However, the indices are computed a block
+    /// at a time while the rows are copied, and no memory is allocated other
+    /// than by resizing. When the matrix is larger than
+    /// `MCKL_STATE_MATRIX_STREAM_SIZE` bytes, the rows are copied with
+    /// non-temporal stores.
+    template <typename IntType, typename InputIter>
+    void select_rep(IntType N, InputIter replication)
+    {
+        select_rep<BackendSEQ>(N, replication);
+    }
+
+    /// \brief Select samples using replication numbers, with the rows copied
+    /// in parallel using a given SMP backend
+    ///
+    /// \details
+    /// Unless `Backend` is BackendSEQ, `replication` shall be a random access
+    /// iterator.
+    template <typename Backend, typename IntType, typename InputIter>
+    void select_rep(IntType N, InputIter replication)
+    {
+        const size_type n0 = this->size();
+        const size_type n = static_cast<size_type>(N);
+        if (n0 == 0 || n == 0 || internal::is_nullptr(replication)) {
+            this->resize(n);
+            return;
+        }
+
+        if (n > n0)
+            this->resize(n);
+
+        const bool stream = this->dim() * sizeof(T) >= 64 &&
+            this->data_size() * sizeof(T) >= MCKL_STATE_MATRIX_STREAM_SIZE;
+        this->template select_rep_run<Backend>(n0, n, replication,
+            [this, stream](const size_type *index, size_type first,
+                size_type m) {
+                if (stream) {
+                    const size_type d = this->dim();
+                    for (size_type i = 0; i != m; ++i) {
+                        if (index[i] != first + i) {
+                            internal::state_matrix_stream(d,
+                                this->row_data(index[i]),
+                                this->row_data(first + i));
+                        }
+                    }
+                    internal::state_matrix_stream_fence();
+                } else {
+                    for (size_type i = 0; i != m; ++i)
+                        this->duplicate(index[i], first + i);
+                }
+            });
+
+        if (n < n0)
+            this->resize(n);
+    }
+
     /// \brief Duplicate a sample
     ///
     /// \param src The index of sample to be duplicated
@@ -664,6 +864,49 @@ class StateMatrix<ColMajor, Dim, T> : public StateMatrixBase<ColMajor, Dim, T>
         return;
     }
 
+    /// \brief Select samples using replication numbers
+    ///
+    /// \param N The new sample size
+    /// \param replication `size()`-vector of replication numbers, which sum
+    /// to `N`
+    ///
+    /// \details
+    /// This is equivalent to `select` with the parent indices computed by
+    /// `resample_trans_rep_index`. However, the indices are computed a block
+    /// at a time, and all columns are copied for each block while its indices
+    /// are still in cache.
+    template <typename IntType, typename InputIter>
+    void select_rep(IntType N, InputIter replication)
+    {
+        select_rep<BackendSEQ>(N, replication);
+    }
+
+    /// \brief Select samples using replication numbers, with the blocks
+    /// copied in parallel using a given SMP backend
+    ///
+    /// \details
+    /// Unless `Backend` is BackendSEQ, `replication` shall be a random access
+    /// iterator.
+    template <typename Backend, typename IntType, typename InputIter>
+    void select_rep(IntType N, InputIter replication)
+    {
+        const size_type n0 = this->size();
+        const size_type n = static_cast<size_type>(N);
+        if (n0 == 0 || n == 0 || internal::is_nullptr(replication)) {
+            this->resize(n);
+            return;
+        }
+
+        if (n == n0) {
+            select_rep_col<Backend>(n0, n, replication, *this);
+        } else {
+            StateMatrix<ColMajor, Dim, T> tmp;
+            tmp.resize_data(n, this->dim());
+            select_rep_col<Backend>(n0, n, replication, tmp);
+            *this = std::move(tmp);
+        }
+    }
+
     /// \brief Duplicate a sample
     ///
     /// \param src The index of sample to be duplicated
@@ -758,6 +1001,28 @@ class StateMatrix<ColMajor, Dim, T> : public StateMatrixBase<ColMajor, Dim, T>
         *this = std::move(tmp);
     }
 
+    template <typename Backend, typename InputIter>
+    void select_rep_col(size_type N, size_type M, InputIter replication,
+        StateMatrix<ColMajor, Dim, T> &dst)
+    {
+        // Rows selected by themselves are not written if copying in place in
+        // parallel, such that no row is written while it might be read by
+        // another thread
+        const bool inplace =
+            &dst == this && !std::is_same<Backend, BackendSEQ>::value;
+        this->template select_rep_run<Backend>(N, M, replication,
+            [this, &dst, inplace](
+                const size_type *index, size_type first, size_type m) {
+                for (size_type j = 0; j != this->dim(); ++j) {
+                    const value_type *s = this->col_data(j);
+                    value_type *d = dst.col_data(j) + first;
+                    for (size_type i = 0; i != m; ++i)
+                        if (!inplace || index[i] != first + i)
+                            d[i] = s[index[i]];
+                }
+            });
+    }
+
     void duplicate_dispatch(size_type src, size_type dst, std::true_type)
     {
         for (size_type d = 0; d != this->dim(); ++d)
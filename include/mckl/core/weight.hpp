@@ -34,18 +34,223 @@
 
 #include <mckl/internal/common.hpp>
 #include <mckl/random/discrete_distribution.hpp>
+#include <mckl/smp/backend_seq.hpp>
+
+#if MCKL_HAS_AVX2 || MCKL_HAS_AVX512F
+#include <immintrin.h>
+#endif
 
 namespace mckl
 {
 
-/// \brief Weight class
+namespace internal
+{
+
+/// \brief Set \f$w_i = w_i + v_i\f$ and return \f$\max_i w_i\f$
+template <typename InputIter, typename RealType>
+inline double weight_add_max(std::size_t n, InputIter v, RealType *w)
+{
+    double lmax = -const_inf<double>();
+    for (std::size_t i = 0; i != n; ++i, ++v) {
+        w[i] += static_cast<RealType>(*v);
+        if (lmax < w[i])
+            lmax = static_cast<double>(w[i]);
+    }
+
+    return lmax;
+}
+
+#if MCKL_HAS_AVX512F
+
+inline double weight_add_max(std::size_t n, const double *v, double *w)
+{
+    const std::size_t m = n / 8;
+    const std::size_t l = n % 8;
+    __m512d mmax = _mm512_set1_pd(-const_inf<double>());
+    for (std::size_t i = 0; i != m; ++i, v += 8, w += 8) {
+        const __m512d x =
+            _mm512_add_pd(_mm512_loadu_pd(w), _mm512_loadu_pd(v));
+        _mm512_storeu_pd(w, x);
+        mmax = _mm512_maskz_max_pd(0xFF, x, mmax);
+    }
+    alignas(64) double t[8];
+    _mm512_store_pd(t, mmax);
+    for (std::size_t i = 1; i != 8; ++i)
+        t[0] = std::max(t[0], t[i]);
+
+    return std::max(t[0], weight_add_max<const double *>(l, v, w));
+}
+
+#elif MCKL_HAS_AVX2
+
+inline double weight_add_max(std::size_t n, const double *v, double *w)
+{
+    const std::size_t m = n / 4;
+    const std::size_t l = n % 4;
+    __m256d mmax = _mm256_set1_pd(-const_inf<double>());
+    for (std::size_t i = 0; i != m; ++i, v += 4, w += 4) {
+        const __m256d x =
+            _mm256_add_pd(_mm256_loadu_pd(w), _mm256_loadu_pd(v));
+        _mm256_storeu_pd(w, x);
+        mmax = _mm256_max_pd(x, mmax);
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, mmax);
+
+    return std::max(std::max(std::max(t[0], t[1]), std::max(t[2], t[3])),
+        weight_add_max<const double *>(l, v, w));
+}
+
+#endif // MCKL_HAS_AVX512F
+
+/// \brief Add \f$\sum_i w_i\f$ to `accw` and \f$\sum_i w_i^2\f$ to `essw`
+/// in a single pass
+inline void weight_acc_ess(
+    std::size_t n, const double *w, double &accw, double &essw)
+{
+#if MCKL_HAS_AVX512F
+    const std::size_t m = n / 8;
+    const std::size_t l = n % 8;
+    __m512d macc = _mm512_setzero_pd();
+    __m512d mess = _mm512_setzero_pd();
+    for (std::size_t i = 0; i != m; ++i, w += 8) {
+        const __m512d x = _mm512_loadu_pd(w);
+        macc = _mm512_add_pd(macc, x);
+        mess = _mm512_fmadd_pd(x, x, mess);
+    }
+    // The lanes are added in the same order as `_mm512_reduce_add_pd`, which
+    // is not used since GCC warns that its undefined operands may be used
+    // uninitialized
+    alignas(64) double t[8];
+    _mm512_store_pd(t, macc);
+    accw += ((t[0] + t[4]) + (t[2] + t[6])) + ((t[1] + t[5]) + (t[3] + t[7]));
+    _mm512_store_pd(t, mess);
+    essw += ((t[0] + t[4]) + (t[2] + t[6])) + ((t[1] + t[5]) + (t[3] + t[7]));
+#elif MCKL_HAS_AVX2
+    const std::size_t m = n / 4;
+    const std::size_t l = n % 4;
+    __m256d macc = _mm256_setzero_pd();
+    __m256d mess = _mm256_setzero_pd();
+    for (std::size_t i = 0; i != m; ++i, w += 4) {
+        const __m256d x = _mm256_loadu_pd(w);
+        macc = _mm256_add_pd(macc, x);
+#if MCKL_HAS_FMA
+        mess = _mm256_fmadd_pd(x, x, mess);
+#else
+        mess = _mm256_add_pd(_mm256_mul_pd(x, x), mess);
+#endif
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, macc);
+    accw += (t[0] + t[1]) + (t[2] + t[3]);
+    _mm256_store_pd(t, mess);
+    essw += (t[0] + t[1]) + (t[2] + t[3]);
+#else
+    const std::size_t m = n / 4;
+    const std::size_t l = n % 4;
+    double acc[4] = {0, 0, 0, 0};
+    double ess[4] = {0, 0, 0, 0};
+    for (std::size_t i = 0; i != m; ++i, w += 4) {
+        acc[0] += w[0];
+        acc[1] += w[1];
+        acc[2] += w[2];
+        acc[3] += w[3];
+        ess[0] += w[0] * w[0];
+        ess[1] += w[1] * w[1];
+        ess[2] += w[2] * w[2];
+        ess[3] += w[3] * w[3];
+    }
+    accw += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    essw += (ess[0] + ess[1]) + (ess[2] + ess[3]);
+#endif
+    for (std::size_t i = 0; i != l; ++i) {
+        accw += w[i];
+        essw += w[i] * w[i];
+    }
+}
+
+/// \brief Add \f$\sum_i w_i\f$ to `accw` and \f$\sum_i w_i^2\f$ to `essw`
+/// in a single pass, accumulated in double precision
+template <typename RealType>
+inline void weight_acc_ess(
+    std::size_t n, const RealType *w, double &accw, double &essw)
+{
+    const std::size_t m = n / 4;
+    const std::size_t l = n % 4;
+    double acc[4] = {0, 0, 0, 0};
+    double ess[4] = {0, 0, 0, 0};
+    for (std::size_t i = 0; i != m; ++i, w += 4) {
+        for (std::size_t j = 0; j != 4; ++j) {
+            const double x = static_cast<double>(w[j]);
+            acc[j] += x;
+            ess[j] += x * x;
+        }
+    }
+    accw += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    essw += (ess[0] + ess[1]) + (ess[2] + ess[3]);
+    for (std::size_t i = 0; i != l; ++i) {
+        const double x = static_cast<double>(w[i]);
+        accw += x;
+        essw += x * x;
+    }
+}
+
+/// \brief Set \f$w_i = w_i v_i\f$
+template <typename InputType, typename RealType>
+inline void weight_mul(std::size_t n, const InputType *v, RealType *w)
+{
+    for (std::size_t i = 0; i != n; ++i)
+        w[i] *= static_cast<RealType>(v[i]);
+}
+
+/// \brief Set \f$w_i = w_i v_i\f$
+template <typename RealType>
+inline void weight_mul(std::size_t n, const RealType *v, RealType *w)
+{
+    mul(n, v, w, w);
+}
+
+} // namespace mckl::internal
+
+/// \brief Weight class using a given SMP backend
 /// \ingroup Core
-class Weight
+///
+/// \details
+/// The weights are processed in blocks of a fixed size. The reductions,
+/// such as the sum of the weights, are first computed within each block, and
+/// then the partial results are summed in a fixed order. Therefore the
+/// results are identical regardless of the backend and the number of threads.
+///
+/// When the weights are manipulated through the logarithm interface, `set_log`
+/// and `add_log`, the logarithm weights are retained, such that subsequent
+/// calls of `add_log` need not to recompute them from the normalized weights.
+///
+/// Since the logarithm weights are retained, and the sums are accumulated in
+/// vectorized partial sums, the normalized weights and the ESS are not
+/// bit-identical to those computed by prior versions of `Weight`. They differ
+/// only by rounding errors.
+///
+/// The weights and the logarithm weights are stored as `RealType`, which can
+/// be `float` to halve the memory traffic of the weights. The maximum, the sum
+/// and the sum of squares of the weights are always accumulated in double
+/// precision. To use it with a Particle, define the member type `weight_type`
+/// of the state class, for example, `using weight_type = WeightSMP<BackendSMP,
+/// float>`.
+template <typename Backend = BackendSMP, typename RealType = double>
+class WeightSMP
 {
+    static_assert(std::is_floating_point<RealType>::value,
+        "**WeightSMP** used with RealType other than floating point types");
+
     public:
     using size_type = std::size_t;
+    using real_type = RealType;
 
-    explicit Weight(size_type N = 0) : ess_(0), data_(N) { set_equal(); }
+    explicit WeightSMP(size_type N = 0)
+        : ess_(0), use_log_(false), alias_valid_(false), data_(N)
+    {
+        set_equal();
+    }
 
     /// \brief Size of this Weight object
     size_type size() const { return data_.size(); }
@@ -60,6 +265,8 @@ class Weight
             return;
 
         data_.resize(N);
+        if (use_log_)
+            log_data_.resize(N);
         set_equal();
     }
 
@@ -67,13 +274,17 @@ class Weight
     void reserve(size_type N) { data_.reserve(N); }
 
     /// \brief Shrink to fit
-    void shrink_to_fit() { data_.shrink_to_fit(); }
+    void shrink_to_fit()
+    {
+        data_.shrink_to_fit();
+        log_data_.shrink_to_fit();
+    }
 
     /// \brief Return the ESS of the particle system
     double ess() const { return ess_; }
 
     /// \brief Pointer to data of the normalized weight
-    const double *data() const { return data_.data(); }
+    const real_type *data() const { return data_.data(); }
 
     /// \brief Read all normalized weights to an output iterator
     template <typename OutputIter>
@@ -85,8 +296,16 @@ class Weight
     /// \brief Set \f$W_i = 1/N\f$
     void set_equal()
     {
-        std::fill(data_.begin(), data_.end(), 1.0 / size());
+        const real_type w = static_cast<real_type>(1.0 / size());
+        real_type *const d = data_.data();
+        real_type *const l = use_log_ ? log_data_.data() : nullptr;
+        run([d, l, w](std::size_t first, std::size_t n, double &, double &) {
+            std::fill_n(d + first, n, w);
+            if (l != nullptr)
+                std::fill_n(l + first, n, const_zero<real_type>());
+        });
         ess_ = static_cast<double>(size());
+        alias_valid_ = false;
     }
 
     /// \brief Set \f$W_i \propto w_i\f$
@@ -94,7 +313,7 @@ class Weight
     void set(InputIter first)
     {
         std::copy_n(first, size(), data_.begin());
-        normalize(false);
+        normalize();
     }
 
     /// \brief Set \f$W_i \propto W_i w_i\f$
@@ -102,15 +321,18 @@ class Weight
     void mul(InputIter first)
     {
         for (std::size_t i = 0; i != size(); ++i, ++first)
-            data_[i] *= *first;
-        normalize(false);
+            data_[i] *= static_cast<real_type>(*first);
+        normalize();
     }
 
     /// \brief Set \f$W_i \propto W_i w_i\f$
     void mul(const double *first)
     {
-        ::mckl::mul(size(), first, data_.data(), data_.data());
-        normalize(false);
+        real_type *const d = data_.data();
+        run([d, first](std::size_t i, std::size_t n, double &, double &) {
+            internal::weight_mul(n, first + i, d + i);
+        });
+        normalize();
     }
 
     /// \brief Set \f$W_i \propto W_i w_i\f$
@@ -120,26 +342,34 @@ class Weight
     template <typename InputIter>
     void set_log(InputIter first)
     {
-        std::copy_n(first, size(), data_.begin());
-        normalize(true);
+        use_log_ = true;
+        log_data_.resize(size());
+        std::fill(log_data_.begin(), log_data_.end(), const_zero<real_type>());
+        normalize_log(
+            internal::weight_add_max(size(), first, log_data_.data()));
     }
 
     /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$
     template <typename InputIter>
     void add_log(InputIter first)
     {
-        log(size(), data_.data(), data_.data());
-        for (std::size_t i = 0; i != size(); ++i)
-            data_[i] += *first;
-        normalize(true);
+        init_log();
+        normalize_log(
+            internal::weight_add_max(size(), first, log_data_.data()));
     }
 
     /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$
     void add_log(const double *first)
     {
-        log(size(), data_.data(), data_.data());
-        add(size(), first, data_.data(), data_.data());
-        normalize(true);
+        init_log();
+        real_type *const l = log_data_.data();
+        run([l, first](std::size_t i, std::size_t n, double &m, double &) {
+            m = internal::weight_add_max(n, first + i, l + i);
+        });
+        double lmax = -const_inf<double>();
+        for (std::size_t j = 0; j != reduce_.size(); ++j)
+            lmax = std::max(lmax, reduce_[j]);
+        normalize_log(lmax);
     }
 
     /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$
@@ -153,52 +383,156 @@ class Weight
         return draw_(rng, data_.begin(), data_.end(), true);
     }
 
+    /// \brief Draw `n` integer indices in the range \f$[0, N)\f$ according to
+    /// the weights
+    ///
+    /// \details
+    /// The samples are drawn using an alias table, which is constructed in
+    /// \f$O(N)\f$ time on the first call after the weights are changed. Each
+    /// sample is then drawn in constant time.
+    template <typename RNGType>
+    void draw(RNGType &rng, size_type n, size_type *r)
+    {
+        if (!alias_valid_) {
+            alias_.build(data_.begin(), data_.end());
+            alias_valid_ = true;
+        }
+        alias_(rng, n, r);
+    }
+
+    /// \brief Store the weights in checkpoint sections prefixed by `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        ar.write(name + "/ESS", ess_);
+        ar.write(name + "/Data", data_.size(), data_.data());
+        ar.write(name + "/LogData", use_log_ ? log_data_.size() : 0,
+            log_data_.data());
+    }
+
+    /// \brief Restore the weights from checkpoint sections prefixed by `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        const std::size_t n = ar.size(name + "/LogData");
+        data_.resize(ar.size(name + "/Data"));
+        log_data_.resize(n);
+        use_log_ = n != 0;
+        alias_valid_ = false;
+
+        return ar.read(name + "/ESS", ess_) &&
+            ar.read(name + "/Data", data_.size(), data_.data()) &&
+            ar.read(name + "/LogData", n, log_data_.data());
+    }
+
     private:
     double ess_;
-    Vector<double> data_;
+    bool use_log_;
+    bool alias_valid_;
+    Vector<real_type> data_;
+    Vector<real_type> log_data_;
+    Vector<double> reduce_;
+    Vector<double> reduce_ess_;
     DiscreteDistribution<size_type> draw_;
+    internal::DiscreteAlias<size_type> alias_;
 
-    template <typename InputIter>
-    double max_element(std::size_t n, InputIter first)
+    static constexpr std::size_t block_size()
     {
-        using value_type =
-            typename std::iterator_traits<InputIter>::value_type;
+        return internal::BufferSize<real_type>::value;
+    }
 
-        value_type v = -const_inf<value_type>();
-        for (std::size_t i = 0; i != n; ++i, ++first)
-            if (v < *first)
-                v = *first;
+    // Call `work(first, n, acc, ess)` for each block, where `first` is the
+    // index of its first element, `n` is its size, and `acc` and `ess` are
+    // the elements of `reduce_` and `reduce_ess_` of the block. The buffers
+    // are sized here, after any change of the size of the weights
+    template <typename WorkType>
+    void run(WorkType &&work)
+    {
+        const std::size_t N = size();
+        const std::size_t k = block_size();
+        const std::size_t nb = N / k + (N % k == 0 ? 0 : 1);
+        reduce_.resize(nb);
+        reduce_ess_.resize(nb);
+        double *const acc = reduce_.data();
+        double *const ess = reduce_ess_.data();
+        internal::BackendFor<Backend>::run(nb, 1,
+            [N, k, acc, ess, &work](std::size_t b, std::size_t e) {
+                for (std::size_t j = b; j != e; ++j) {
+                    const std::size_t first = j * k;
+                    work(first, std::min(k, N - first), acc[j], ess[j]);
+                }
+            });
+    }
 
-        return static_cast<double>(v);
+    void init_log()
+    {
+        if (use_log_)
+            return;
+
+        use_log_ = true;
+        log_data_.resize(size());
+        const real_type *const d = data_.data();
+        real_type *const l = log_data_.data();
+        run([d, l](std::size_t i, std::size_t n, double &, double &) {
+            log(n, d + i, l + i);
+        });
     }
 
-    void normalize(bool use_log)
+    void normalize()
     {
-        double *w = data_.data();
-        double accw = 0;
-        double essw = 0;
-        const double lmax = use_log ? max_element(size(), w) : 0;
-        const std::size_t k = internal::BufferSize<double>::value;
-        const std::size_t m = size() / k;
-        const std::size_t l = size() % k;
-        for (std::size_t i = 0; i != m; ++i, w += k)
-            normalize(k, w, accw, essw, use_log, lmax);
-        normalize(l, w, accw, essw, use_log, lmax);
-        ::mckl::mul(size(), 1 / accw, data_.data(), data_.data());
-        ess_ = accw * accw / essw;
+        use_log_ = false;
+        real_type *const d = data_.data();
+        run([d](std::size_t i, std::size_t n, double &acc, double &ess) {
+            acc = 0;
+            ess = 0;
+            internal::weight_acc_ess(n, d + i, acc, ess);
+        });
+        normalize_acc();
+    }
+
+    // Compute the normalized weights from the logarithm weights one block at
+    // a time, such that the exponential, the sum and the sum of squares are
+    // all computed while the block is still in cache. The logarithm weights
+    // are shifted by their maximum at the same time to keep them bounded.
+    void normalize_log(double lmax)
+    {
+        real_type *const l = log_data_.data();
+        real_type *const d = data_.data();
+        const real_type m = static_cast<real_type>(lmax);
+        run([l, d, m](std::size_t i, std::size_t n, double &acc, double &ess) {
+            sub(n, l + i, m, l + i);
+            exp(n, l + i, d + i);
+            acc = 0;
+            ess = 0;
+            internal::weight_acc_ess(n, d + i, acc, ess);
+        });
+        normalize_acc();
     }
 
-    void normalize(std::size_t n, double *w, double &accw, double &essw,
-        bool use_log, double lmax)
+    void normalize_acc()
     {
-        if (use_log) {
-            sub(n, w, lmax, w);
-            exp(n, w, w);
+        double accw = 0;
+        double essw = 0;
+        for (std::size_t j = 0; j != reduce_.size(); ++j) {
+            accw += reduce_[j];
+            essw += reduce_ess_[j];
         }
-        accw = std::accumulate(w, w + n, accw);
-        essw +=
-            internal::cblas_ddot(static_cast<MCKL_BLAS_INT>(n), w, 1, w, 1);
+        const real_type a = static_cast<real_type>(1 / accw);
+        real_type *const d = data_.data();
+        run([d, a](std::size_t i, std::size_t n, double &, double &) {
+            ::mckl::mul(n, a, d + i, d + i);
+        });
+        ess_ = accw * accw / essw;
+        alias_valid_ = false;
     }
+}; // class WeightSMP
+
+/// \brief Weight class
+/// \ingroup Core
+class Weight : public WeightSMP<BackendSEQ>
+{
+    public:
+    explicit Weight(size_type N = 0) : WeightSMP<BackendSEQ>(N) {}
 }; // class Weight
 
 /// \brief An empty weight set class
@@ -261,6 +595,22 @@ class WeightNull
     {
         return 0;
     }
+
+    template <typename RNGType>
+    void draw(RNGType &, size_type, size_type *)
+    {
+    }
+
+    template <typename Archive>
+    void checkpoint_store(Archive &, const std::string &) const
+    {
+    }
+
+    template <typename Archive>
+    bool checkpoint_load(Archive &, const std::string &)
+    {
+        return true;
+    }
 }; // class WeightNull
 
 /// \brief Particle::weight_type trait
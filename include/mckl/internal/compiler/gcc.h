@@ -47,6 +47,36 @@
 #endif
 #endif
 
+#ifdef __SSE2__
+#ifndef MCKL_HAS_SSE2
+#define MCKL_HAS_SSE2 1
+#endif
+#endif
+
+#ifdef __AVX2__
+#ifndef MCKL_HAS_AVX2
+#define MCKL_HAS_AVX2 1
+#endif
+#endif
+
+#ifdef __AVX512F__
+#ifndef MCKL_HAS_AVX512F
+#define MCKL_HAS_AVX512F 1
+#endif
+#endif
+
+#ifdef __FMA__
+#ifndef MCKL_HAS_FMA
+#define MCKL_HAS_FMA 1
+#endif
+#endif
+
+#ifdef __VAES__
+#ifndef MCKL_HAS_VAES
+#define MCKL_HAS_VAES 1
+#endif
+#endif
+
 #ifdef __x86_64__
 #ifndef MCKL_HAS_INT128
 #define MCKL_HAS_INT128 1
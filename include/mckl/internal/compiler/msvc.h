@@ -34,4 +34,25 @@
 
 #define MCKL_MSVC_VERSION _MSC_VER
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#ifndef MCKL_HAS_SSE2
+#define MCKL_HAS_SSE2 1
+#endif
+#endif
+
+#ifdef __AVX2__
+#ifndef MCKL_HAS_AVX2
+#define MCKL_HAS_AVX2 1
+#endif
+#ifndef MCKL_HAS_FMA
+#define MCKL_HAS_FMA 1
+#endif
+#endif
+
+#ifdef __AVX512F__
+#ifndef MCKL_HAS_AVX512F
+#define MCKL_HAS_AVX512F 1
+#endif
+#endif
+
 #endif // MCKL_INTERNAL_COMPILER_MSVC_H
@@ -144,6 +144,11 @@
 #define MCKL_USE_MKL_VML MCKL_HAS_MKL
 #endif
 
+#ifndef MCKL_USE_SIMD_VMATH
+#define MCKL_USE_SIMD_VMATH                                                   \
+    (!MCKL_USE_MKL_VML && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F))
+#endif
+
 #ifndef MCKL_USE_MKL_VSL
 #define MCKL_USE_MKL_VSL MCKL_HAS_MKL
 #endif
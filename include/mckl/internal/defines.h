@@ -168,6 +168,17 @@ typedef enum {
     MCKLBackendTBB  ///< `mckl::BackendTBB`
 } MCKLBackendSMP;
 
+/// \brief `mckl::CPUFeature`
+typedef enum {
+    MCKLCPUSSE2 = 1 << 0,    ///< `mckl::CPUSSE2`
+    MCKLCPUAVX2 = 1 << 1,    ///< `mckl::CPUAVX2`
+    MCKLCPUAVX512F = 1 << 2, ///< `mckl::CPUAVX512F`
+    MCKLCPUFMA = 1 << 3,     ///< `mckl::CPUFMA`
+    MCKLCPUAESNI = 1 << 4,   ///< `mckl::CPUAESNI`
+    MCKLCPUVAES = 1 << 5,    ///< `mckl::CPUVAES`
+    MCKLCPURDRAND = 1 << 6   ///< `mckl::CPURDRAND`
+} MCKLCPUFeature;
+
 /// \brief MCKL RNG types
 typedef struct {
     void *ptr;
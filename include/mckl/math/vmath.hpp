@@ -34,6 +34,7 @@
 
 #include <mckl/internal/basic.hpp>
 #include <mckl/math/constants.hpp>
+#include <mckl/math/erf.hpp>
 
 #if MCKL_USE_MKL_VML
 
@@ -167,6 +168,50 @@ inline void modf(std::size_t n, const double *a, double *y, double *z)
 
 #endif // MCKL_USE_MKL_VML
 
+#if MCKL_USE_SIMD_VMATH
+
+#include <mckl/math/internal/vmath_simd.hpp>
+
+#define MCKL_DEFINE_MATH_VMATH_SIMD_1(Kernel, name)                           \
+    inline void name(std::size_t n, const float *a, float *y)                 \
+    {                                                                         \
+        internal::vmath_simd<internal::VMathSIMD##Kernel>(n, a, y);           \
+    }                                                                         \
+    inline void name(std::size_t n, const double *a, double *y)               \
+    {                                                                         \
+        internal::vmath_simd<internal::VMathSIMD##Kernel>(n, a, y);           \
+    }
+
+namespace mckl
+{
+
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Sqrt, sqrt)
+
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Exp, exp)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Expm1, expm1)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Log, log)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Log1p, log1p)
+
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Cos, cos)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Sin, sin)
+inline void sincos(std::size_t n, const float *a, float *y, float *z)
+{
+    internal::vmath_simd_sincos(n, a, y, z);
+}
+inline void sincos(std::size_t n, const double *a, double *y, double *z)
+{
+    internal::vmath_simd_sincos(n, a, y, z);
+}
+
+MCKL_DEFINE_MATH_VMATH_SIMD_1(Erf, erf)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(ErfInv, erfinv)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(ErfcInv, erfcinv)
+MCKL_DEFINE_MATH_VMATH_SIMD_1(CdfNormInv, cdfnorminv)
+
+} // namespace mckl
+
+#endif // MCKL_USE_SIMD_VMATH
+
 #define MCKL_DEFINE_MATH_VMATH_1(func, name)                                  \
     template <typename T>                                                     \
     inline void name(std::size_t n, const T *a, T *y)                         \
@@ -598,6 +643,35 @@ inline void cdfnorm(std::size_t n, const T *a, T *y)
     fma(l, y, static_cast<T>(0.5), static_cast<T>(0.5), y);
 }
 
+/// \brief For \f$i=1,\ldots,n\f$, compute
+/// \f$y_i = \mathrm{erf}^{-1}(a_i)\f$
+template <typename T>
+inline void erfinv(std::size_t n, const T *a, T *y)
+{
+    for (std::size_t i = 0; i != n; ++i)
+        y[i] = static_cast<T>(erfinv(static_cast<double>(a[i])));
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute
+/// \f$y_i = \mathrm{erfc}^{-1}(a_i)\f$
+template <typename T>
+inline void erfcinv(std::size_t n, const T *a, T *y)
+{
+    for (std::size_t i = 0; i != n; ++i)
+        y[i] = static_cast<T>(erfcinv(static_cast<double>(a[i])));
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute
+/// \f$y_i = -\sqrt{2}\mathrm{erfc}^{-1}(2a_i)\f$, the inverse of `cdfnorm`
+template <typename T>
+inline void cdfnorminv(std::size_t n, const T *a, T *y)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = static_cast<T>(-const_sqrt_2<double>() *
+            erfcinv(2 * static_cast<double>(a[i])));
+    }
+}
+
 /// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = \ln\Gamma(a_i)\f$
 MCKL_DEFINE_MATH_VMATH_1(std::lgamma, lgamma)
 
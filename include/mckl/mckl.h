@@ -86,6 +86,9 @@
 /// \defgroup C_API_Utility_Covariance Covariance
 /// \ingroup C_API_Utility
 
+/// \defgroup C_API_Utility_CPUFeatures CPU features
+/// \ingroup C_API_Utility
+
 /// \defgroup C_API_Utility_HDF5 HDF5 objects IO
 /// \ingroup C_API_Utility
 
@@ -145,10 +145,18 @@
 /// \ingroup Utility
 /// \brief Memory allocation with alignment requirement
 
+/// \defgroup Checkpoint Checkpoint
+/// \ingroup Utility
+/// \brief Store and restore the complete state of a sampler
+
 /// \defgroup Covariance Covariance
 /// \ingroup Utility
 /// \brief Covariance matrix estimation
 
+/// \defgroup CPUFeatures CPU features
+/// \ingroup Utility
+/// \brief Runtime detection of CPU features
+
 /// \defgroup HDF5 HDF5 objects I/O
 /// \ingroup Utility
 /// \brief Load and store objects in the HDF5 format
@@ -37,6 +37,8 @@
 #include <mckl/random/rng.hpp>
 #include <mckl/random/rng_set.hpp>
 #include <mckl/random/seed.hpp>
+#include <mckl/random/sobol.hpp>
+#include <mckl/random/stream_tree.hpp>
 #include <mckl/random/test.hpp>
 #include <mckl/random/u01.hpp>
 
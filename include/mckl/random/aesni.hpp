@@ -36,6 +36,10 @@
 #include <mckl/random/counter.hpp>
 #include <wmmintrin.h>
 
+#if MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F)
+#include <immintrin.h>
+#endif
+
 #ifdef MCKL_GCC
 #if __GNUC__ >= 6
 #pragma GCC diagnostic push
@@ -80,6 +84,168 @@
 namespace mckl
 {
 
+namespace internal
+{
+
+#if MCKL_HAS_VAES && MCKL_HAS_AVX512F
+
+using AESNIVAESType = __m512i;
+
+inline void aesni_vaes_set(const __m128i &a, __m512i &v)
+{
+    // Zero-masking with a full mask, such that GCC 12 does not see the
+    // uninitialized pass-through operand of the unmasked intrinsic
+    const __m512i b = _mm512_castsi128_si512(a);
+    v = _mm512_maskz_shuffle_i32x4(0xFFFF, b, b, 0);
+}
+
+inline __m512i aesni_vaes_add(const __m512i &a, const __m512i &b)
+{
+    return _mm512_add_epi64(a, b);
+}
+
+inline __m512i aesni_vaes_xor(const __m512i &a, const __m512i &b)
+{
+    return _mm512_xor_si512(a, b);
+}
+
+inline __m512i aesni_vaes_enc(const __m512i &a, const __m512i &k)
+{
+    return _mm512_aesenc_epi128(a, k);
+}
+
+inline __m512i aesni_vaes_enclast(const __m512i &a, const __m512i &k)
+{
+    return _mm512_aesenclast_epi128(a, k);
+}
+
+#elif MCKL_HAS_VAES && MCKL_HAS_AVX2
+
+using AESNIVAESType = __m256i;
+
+inline void aesni_vaes_set(const __m128i &a, __m256i &v)
+{
+    v = _mm256_broadcastsi128_si256(a);
+}
+
+inline __m256i aesni_vaes_add(const __m256i &a, const __m256i &b)
+{
+    return _mm256_add_epi64(a, b);
+}
+
+inline __m256i aesni_vaes_xor(const __m256i &a, const __m256i &b)
+{
+    return _mm256_xor_si256(a, b);
+}
+
+inline __m256i aesni_vaes_enc(const __m256i &a, const __m256i &k)
+{
+    return _mm256_aesenc_epi128(a, k);
+}
+
+inline __m256i aesni_vaes_enclast(const __m256i &a, const __m256i &k)
+{
+    return _mm256_aesenclast_epi128(a, k);
+}
+
+#else
+
+using AESNIVAESType = __m128i;
+
+#endif
+
+/// \brief Number of blocks encrypted in each step of the VAES implementation
+///
+/// \details
+/// Eight registers are used for the states such that they and the round keys
+/// fit in the register file
+constexpr std::size_t AESNIVAESBlocks = 8 * sizeof(AESNIVAESType) / 16;
+
+/// \brief Encrypt multiple of `B` blocks with VAES instructions
+///
+/// \details
+/// The generic version does nothing and returns zero. The caller encrypts the
+/// blocks with 128-bit instructions.
+template <std::size_t Rp1, std::size_t B,
+    bool = (MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F) &&
+        B % (sizeof(AESNIVAESType) / sizeof(__m128i)) == 0)>
+class AESNIGeneratorVAES
+{
+    public:
+    static std::size_t eval(std::array<std::uint64_t, 2> &, std::size_t,
+        void *, const std::array<__m128i, Rp1> &)
+    {
+        return 0;
+    }
+}; // class AESNIGeneratorVAES
+
+#if MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F)
+
+/// \brief Encrypt multiple of `B` blocks with VAES instructions
+///
+/// \details
+/// Each 128-bit lane of a 256- or 512-bit register holds one block, and all
+/// lanes are encrypted with the same round key broadcast to every lane. The
+/// blocks are the same as those encrypted one at a time with the same
+/// counters, and thus the results are identical to the 128-bit
+/// implementation.
+template <std::size_t Rp1, std::size_t B>
+class AESNIGeneratorVAES<Rp1, B, true>
+{
+    public:
+    /// \brief Encrypt `n * B` blocks and return `n`
+    static std::size_t eval(std::array<std::uint64_t, 2> &ctr, std::size_t n,
+        void *buffer, const std::array<__m128i, Rp1> &rk)
+    {
+        std::array<std::array<std::uint64_t, 2>, B> ctr_block;
+        std::array<AESNIVAESType, S_> offset;
+        std::array<AESNIVAESType, S_> s;
+        std::array<AESNIVAESType, Rp1> rkv;
+        for (std::size_t r = 0; r != Rp1; ++r)
+            aesni_vaes_set(rk[r], rkv[r]);
+
+        for (std::size_t j = 0; j != B; ++j) {
+            ctr_block[j].front() = j + 1;
+            ctr_block[j].back() = 0;
+        }
+        std::memcpy(offset.data(), ctr_block.data(), sizeof(offset));
+
+        char *b = static_cast<char *>(buffer);
+        for (std::size_t i = 0; i != n; ++i, b += sizeof(s)) {
+            if (ctr.front() <= std::numeric_limits<std::uint64_t>::max() - B) {
+                AESNIVAESType c;
+                aesni_vaes_set(_mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                   ctr.data())),
+                    c);
+                for (std::size_t j = 0; j != S_; ++j)
+                    s[j] = aesni_vaes_add(c, offset[j]);
+                ctr.front() += B;
+            } else {
+                increment(ctr, ctr_block);
+                std::memcpy(s.data(), ctr_block.data(), sizeof(s));
+            }
+            for (std::size_t j = 0; j != S_; ++j)
+                s[j] = aesni_vaes_xor(s[j], rkv.front());
+            for (std::size_t r = 1; r < Rp1 - 1; ++r)
+                for (std::size_t j = 0; j != S_; ++j)
+                    s[j] = aesni_vaes_enc(s[j], rkv[r]);
+            for (std::size_t j = 0; j != S_; ++j)
+                s[j] = aesni_vaes_enclast(s[j], rkv.back());
+            std::memcpy(b, s.data(), sizeof(s));
+        }
+
+        return n;
+    }
+
+    private:
+    static constexpr std::size_t S_ =
+        B / (sizeof(AESNIVAESType) / sizeof(__m128i));
+}; // class AESNIGeneratorVAES
+
+#endif // MCKL_HAS_VAES && (MCKL_HAS_AVX2 || MCKL_HAS_AVX512F)
+
+} // namespace mckl::internal
+
 /// \brief RNG generator using AES-NI instructions
 /// \ingroup AESNI
 template <typename KeySeqType, std::size_t Rounds, std::size_t Blocks>
@@ -118,38 +284,29 @@ class AESNIGenerator
     void operator()(ctr_type &ctr,
         std::array<ResultType, size() / sizeof(ResultType)> &buffer) const
     {
-        union {
-            std::array<__m128i, Blocks> state;
-            std::array<ctr_type, Blocks> ctr_block;
-            std::array<ResultType, size() / sizeof(ResultType)> result;
-        } buf;
-
         std::array<__m128i, Rounds + 1> rk_tmp;
         const std::array<__m128i, Rounds + 1> &rk = key_seq_(rk_tmp);
 
-        increment(ctr, buf.ctr_block);
-        enc(buf.state, rk);
-        buffer = buf.result;
+        if (internal::AESNIGeneratorVAES<Rounds + 1, Blocks>::eval(
+                ctr, 1, buffer.data(), rk) == 0) {
+            generate(ctr, buffer.data(), rk);
+        }
     }
 
     template <typename ResultType>
     void operator()(ctr_type &ctr, std::size_t n,
         std::array<ResultType, size() / sizeof(ResultType)> *buffer) const
     {
-        union {
-            std::array<__m128i, Blocks> state;
-            std::array<ctr_type, Blocks> ctr_block;
-            std::array<ResultType, size() / sizeof(ResultType)> result;
-        } buf;
-
         std::array<__m128i, Rounds + 1> rk_tmp;
         const std::array<__m128i, Rounds + 1> &rk = key_seq_(rk_tmp);
 
-        for (std::size_t i = 0; i != n; ++i) {
-            increment(ctr, buf.ctr_block);
-            enc(buf.state, rk);
-            buffer[i] = buf.result;
-        }
+        const std::size_t k = vaes_blocks_ / Blocks;
+        const std::size_t m =
+            internal::AESNIGeneratorVAES<Rounds + 1, vaes_blocks_>::eval(
+                ctr, n / k, buffer, rk) *
+            k;
+        for (std::size_t i = m; i != n; ++i)
+            generate(ctr, buffer[i].data(), rk);
     }
 
     friend bool operator==(
@@ -197,8 +354,34 @@ class AESNIGenerator
     }
 
     private:
+    static constexpr std::size_t vaes_blocks_ =
+        Blocks < internal::AESNIVAESBlocks ?
+        Blocks * (internal::AESNIVAESBlocks / Blocks) :
+        Blocks;
+
     KeySeqType key_seq_;
 
+    // Counters and results are moved with unaligned loads and stores instead
+    // of type punning through a union, which GCC may miscompile at -O3 once
+    // inlined into the caller
+    template <typename ResultType, std::size_t Rp1>
+    void generate(ctr_type &ctr, ResultType *buffer,
+        const std::array<__m128i, Rp1> &rk) const
+    {
+        std::array<ctr_type, Blocks> ctr_block;
+        std::array<__m128i, Blocks> state;
+
+        increment(ctr, ctr_block);
+        for (std::size_t j = 0; j != Blocks; ++j) {
+            state[j] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(ctr_block[j].data()));
+        }
+        enc(state, rk);
+        __m128i *r = reinterpret_cast<__m128i *>(buffer);
+        for (std::size_t j = 0; j != Blocks; ++j)
+            _mm_storeu_si128(r + j, state[j]);
+    }
+
     template <std::size_t K, std::size_t Rp1>
     void enc(std::array<__m128i, K> &state,
         const std::array<__m128i, Rp1> &rk) const
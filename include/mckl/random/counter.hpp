@@ -69,7 +69,7 @@ inline void increment(std::array<T, K> &ctr)
 template <typename T, std::size_t K, T NSkip>
 inline void increment(std::array<T, K> &ctr, std::integral_constant<T, NSkip>)
 {
-    if (ctr.front() < std::numeric_limits<T>::max() - NSkip) {
+    if (ctr.front() <= std::numeric_limits<T>::max() - NSkip) {
         ctr.front() += NSkip;
     } else {
         ctr.front() += NSkip;
@@ -83,7 +83,7 @@ inline void increment(std::array<T, K> &ctr, std::integral_constant<T, NSkip>)
 template <typename T, std::size_t K>
 inline void increment(std::array<T, K> &ctr, T nskip)
 {
-    if (ctr.front() < std::numeric_limits<T>::max() - nskip) {
+    if (ctr.front() <= std::numeric_limits<T>::max() - nskip) {
         ctr.front() += nskip;
     } else {
         ctr.front() += nskip;
@@ -239,6 +239,9 @@ class CounterEngine
 
     void key(const key_type &k) { reset(k); }
 
+    /// \brief The counter of the last generated buffer
+    const ctr_type &ctr() const { return ctr_; }
+
     void ctr(const ctr_type &c)
     {
         ctr_ = c;
@@ -260,15 +263,13 @@ class CounterEngine
         const std::size_t remain = static_cast<std::size_t>(M_ - index_);
 
         if (n < remain) {
-            std::copy_n(buffer_.data() + index_, n, r);
-            index_ += static_cast<unsigned>(n);
+            copy_buffer(n, r);
             return;
         }
 
-        std::copy_n(buffer_.data() + index_, remain, r);
+        copy_buffer(remain, r);
         r += remain;
         n -= remain;
-        index_ = M_;
 
         const std::size_t m = n / M_;
         generator_(ctr_, m, reinterpret_cast<buffer_type *>(r));
@@ -276,8 +277,8 @@ class CounterEngine
         n -= m * M_;
 
         generator_(ctr_, buffer_);
-        std::copy_n(buffer_.data(), n, r);
-        index_ = static_cast<unsigned>(n);
+        index_ = 0;
+        copy_buffer(n, r);
     }
 
     /// \brief Discard the buffer
@@ -399,6 +400,18 @@ class CounterEngine
         generator_.reset(key);
         index_ = M_;
     }
+
+    // Copy at most the remaining buffered results. The bound is explicit so
+    // that the compiler does not assume a read past the end of the buffer
+    void copy_buffer(std::size_t n, result_type *r)
+    {
+        const std::size_t k = index_ < M_ ? M_ - index_ : 0;
+        if (n > k)
+            n = k;
+        for (std::size_t i = 0; i != n; ++i)
+            r[i] = buffer_[index_ + i];
+        index_ += static_cast<unsigned>(n);
+    }
 }; // class CounterEngine
 
 template <typename ResultType, typename Generator>
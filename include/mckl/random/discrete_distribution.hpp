@@ -38,6 +38,148 @@
 namespace mckl
 {
 
+namespace internal
+{
+
+/// \brief Alias table for drawing samples given weights
+/// \ingroup Distribution
+///
+/// \details
+/// The table is constructed with Vose's method in \f$O(N)\f$ time and each
+/// sample is then drawn in constant time using two uniform random numbers.
+/// The storage is reused by subsequent calls to `build`. An empty table
+/// always returns zero.
+template <typename IntType>
+class DiscreteAlias
+{
+    public:
+    using result_type = IntType;
+
+    std::size_t size() const { return prob_.size(); }
+
+    /// \brief Construct the table from weights that are not necessarily
+    /// normalized
+    template <typename InputIter>
+    void build(InputIter first, InputIter last)
+    {
+        prob_.assign(first, last);
+        const std::size_t n = prob_.size();
+        alias_.resize(n);
+        work_.resize(n);
+        if (n == 0)
+            return;
+
+        double sum = 0;
+        for (std::size_t i = 0; i != n; ++i)
+            sum += prob_[i];
+        mul(n, static_cast<double>(n) / sum, prob_.data(), prob_.data());
+
+        // Small ones are stacked from the front and large ones from the back
+        std::size_t ns = 0;
+        std::size_t nl = n;
+        for (std::size_t i = 0; i != n; ++i) {
+            if (prob_[i] < 1)
+                work_[ns++] = static_cast<IntType>(i);
+            else
+                work_[--nl] = static_cast<IntType>(i);
+        }
+
+        while (ns != 0 && nl != n) {
+            const IntType s = work_[--ns];
+            const IntType l = work_[nl++];
+            alias_[static_cast<std::size_t>(s)] = l;
+            double &pl = prob_[static_cast<std::size_t>(l)];
+            pl = (pl + prob_[static_cast<std::size_t>(s)]) - 1;
+            if (pl < 1)
+                work_[ns++] = l;
+            else
+                work_[--nl] = l;
+        }
+
+        // Remaining ones are one up to rounding errors
+        while (ns != 0) {
+            const IntType i = work_[--ns];
+            prob_[static_cast<std::size_t>(i)] = 1;
+            alias_[static_cast<std::size_t>(i)] = i;
+        }
+        while (nl != n) {
+            const IntType i = work_[nl++];
+            prob_[static_cast<std::size_t>(i)] = 1;
+            alias_[static_cast<std::size_t>(i)] = i;
+        }
+    }
+
+    template <typename RNGType>
+    result_type operator()(RNGType &rng) const
+    {
+        if (prob_.empty())
+            return 0;
+
+        U01CODistribution<double> u01;
+        const double u = u01(rng);
+        const double v = u01(rng);
+
+        return lookup(u, v);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        if (prob_.empty()) {
+            std::fill_n(r, n, 0);
+            return;
+        }
+
+        const std::size_t k = BufferSize<double>::value;
+        const std::size_t m = n / k;
+        const std::size_t l = n % k;
+        for (std::size_t i = 0; i != m; ++i, r += k)
+            generate<k>(rng, k, r);
+        generate<k>(rng, l, r);
+    }
+
+    private:
+    Vector<double> prob_;
+    Vector<IntType> alias_;
+    Vector<IntType> work_;
+
+    result_type lookup(double u, double v) const
+    {
+        const std::size_t n = prob_.size();
+        std::size_t j = static_cast<std::size_t>(u * static_cast<double>(n));
+        j = j < n ? j : n - 1;
+
+        return v < prob_[j] ? static_cast<result_type>(j) : alias_[j];
+    }
+
+    template <std::size_t K, typename RNGType>
+    void generate(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        if (n == 0)
+            return;
+
+        Array<double, K> u;
+        Array<double, K> v;
+        Array<std::size_t, K> j;
+        u01_co_distribution(rng, n, u.data());
+        u01_co_distribution(rng, n, v.data());
+
+        const std::size_t s = prob_.size();
+        const std::size_t t = s - 1;
+        const double a = static_cast<double>(s);
+        for (std::size_t i = 0; i != n; ++i)
+            j[i] = static_cast<std::size_t>(u[i] * a);
+        for (std::size_t i = 0; i != n; ++i)
+            j[i] = j[i] < s ? j[i] : t;
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = v[i] < prob_[j[i]] ? static_cast<result_type>(j[i]) :
+                                        alias_[j[i]];
+        }
+    }
+}; // class DiscreteAlias
+
+} // namespace mckl::internal
+
 /// \brief Draw a single sample given weights
 /// \ingroup Distribution
 template <typename IntType>
@@ -135,6 +277,7 @@ class DiscreteDistribution
         Vector<double> probability_;
 
         friend distribution_type;
+        friend DiscreteAliasDistribution<IntType>;
 
         void invariant()
         {
@@ -181,7 +324,7 @@ class DiscreteDistribution
     template <typename UnaryOperation>
     DiscreteDistribution(
         std::size_t count, double xmin, double xmax, UnaryOperation &&unary_op)
-        : param_type(count, xmin, xmax, std::forward<UnaryOperation>(unary_op))
+        : param_(count, xmin, xmax, std::forward<UnaryOperation>(unary_op))
     {
     }
 
@@ -196,18 +339,51 @@ class DiscreteDistribution
 
     result_type max() const
     {
-        return param_.size() == 0 ? 0 : param_.size() - 1;
+        const std::size_t n = param_.probability_.size();
+
+        return n == 0 ? 0 : static_cast<result_type>(n - 1);
     }
 
     Vector<double> probability() const { return param_.probability_; }
 
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param)
+    {
+        param_ = param;
+        reset();
+    }
+
+    void param(param_type &&param)
+    {
+        param_ = std::move(param);
+        reset();
+    }
+
+    void reset() {}
+
     template <typename RNGType>
     result_type operator()(RNGType &rng) const
     {
+        if (param_.probability_.empty())
+            return 0;
+
         return operator()(
             rng, param_.probability_.begin(), param_.probability_.end(), true);
     }
 
+    /// \brief Draw `n` samples
+    ///
+    /// \details
+    /// The results are the same as those of `n` calls to `operator()(rng)`.
+    /// Use DiscreteAliasDistribution for many samples from the same weights.
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        for (std::size_t i = 0; i != n; ++i)
+            r[i] = operator()(rng);
+    }
+
     /// \brief Draw sample with external probabilities
     ///
     /// \param rng A uniform random number generator
@@ -301,6 +477,146 @@ class DiscreteDistribution
     param_type param_;
 }; // class DiscreteDistribution
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(Discrete, IntType)
+
+/// \brief Draw samples given weights using an alias table
+/// \ingroup Distribution
+///
+/// \details
+/// The parameters are the same as those of DiscreteDistribution. The alias
+/// table is constructed along with the distribution in \f$O(N)\f$ time, and
+/// each sample is then drawn in constant time. The results differ from those
+/// of DiscreteDistribution given the same RNG.
+template <typename IntType>
+class DiscreteAliasDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_INT_TYPE(DiscreteAlias, short)
+    public:
+    using result_type = IntType;
+    using distribution_type = DiscreteAliasDistribution<IntType>;
+    using param_type = typename DiscreteDistribution<IntType>::param_type;
+
+    DiscreteAliasDistribution() {}
+
+    template <typename InputIter>
+    DiscreteAliasDistribution(InputIter first, InputIter last)
+        : param_(first, last)
+    {
+        reset();
+    }
+
+    DiscreteAliasDistribution(std::initializer_list<double> weights)
+        : param_(weights)
+    {
+        reset();
+    }
+
+    template <typename UnaryOperation>
+    DiscreteAliasDistribution(
+        std::size_t count, double xmin, double xmax, UnaryOperation &&unary_op)
+        : param_(count, xmin, xmax, std::forward<UnaryOperation>(unary_op))
+    {
+        reset();
+    }
+
+    explicit DiscreteAliasDistribution(const param_type &param)
+        : param_(param)
+    {
+        reset();
+    }
+
+    explicit DiscreteAliasDistribution(param_type &&param)
+        : param_(std::move(param))
+    {
+        reset();
+    }
+
+    result_type min() const { return 0; }
+
+    result_type max() const
+    {
+        const std::size_t n = param_.probability_.size();
+
+        return n == 0 ? 0 : static_cast<result_type>(n - 1);
+    }
+
+    Vector<double> probability() const { return param_.probability_; }
+
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param)
+    {
+        param_ = param;
+        reset();
+    }
+
+    void param(param_type &&param)
+    {
+        param_ = std::move(param);
+        reset();
+    }
+
+    void reset()
+    {
+        double sum = 0;
+        runtime_assert(param_.probability_.empty() ||
+                param_type::is_positive(param_.probability_, sum),
+            "**DiscreteAliasDistribution** constructed with negative weights "
+            "or weights of zero sum");
+        alias_.build(param_.probability_.begin(), param_.probability_.end());
+    }
+
+    template <typename RNGType>
+    result_type operator()(RNGType &rng) const
+    {
+        return alias_(rng);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        alias_(rng, n, r);
+    }
+
+    friend bool operator==(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return dist1.param_ == dist2.param_;
+    }
+
+    friend bool operator!=(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return !(dist1 == dist2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const distribution_type &dist)
+    {
+        os << dist.param_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, distribution_type &dist)
+    {
+        is >> std::ws >> dist.param_;
+        if (is)
+            dist.reset();
+
+        return is;
+    }
+
+    private:
+    param_type param_;
+    internal::DiscreteAlias<IntType> alias_;
+}; // class DiscreteAliasDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(DiscreteAlias, IntType)
+
 } // namespace mckl
 
 #endif // MCKL_RANDOM_DISCRETE_DISTRIBUTION_HPP
@@ -34,6 +34,7 @@
 
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/uniform_bits_distribution.hpp>
 
 namespace mckl
 {
@@ -59,6 +60,137 @@ inline void exponential_distribution_impl(
 MCKL_DEFINE_RANDOM_DISTRIBUTION_IMPL_1(
     Exponential, exponential, RealType, RealType, lambda)
 
+template <typename RealType>
+inline bool exponential_ziggurat_distribution_check_param(RealType lambda)
+{
+    return lambda > 0;
+}
+
+/// \brief Table of the 256 layers of the Ziggurat for the standard
+/// exponential distribution
+///
+/// \details
+/// `x()[i]` is the right boundary of layer `i`, where `x()[0]` is the width of
+/// the rectangle with the same area as the base layer including the tail, and
+/// `x()[256]` is zero. `f()[i]` is the density at `x()[i]`.
+template <typename RealType>
+class ExponentialZigguratTable
+{
+    public:
+    static const ExponentialZigguratTable<RealType> &instance()
+    {
+        static ExponentialZigguratTable<RealType> table;
+
+        return table;
+    }
+
+    static constexpr RealType r() { return static_cast<RealType>(R_); }
+
+    const RealType *x() const { return x_.data(); }
+
+    const RealType *f() const { return f_.data(); }
+
+    private:
+    static constexpr long double R_ = 7.6971174701310497140446280481L;
+
+    std::array<RealType, 257> x_;
+    std::array<RealType, 257> f_;
+
+    ExponentialZigguratTable()
+    {
+        const long double v = (R_ + 1) * std::exp(-R_);
+
+        long double x = R_;
+        x_[0] = static_cast<RealType>(v / std::exp(-R_));
+        x_[1] = static_cast<RealType>(R_);
+        for (std::size_t i = 2; i != 256; ++i) {
+            x = std::max(-std::log(v / x + std::exp(-x)), 0.0L);
+            x_[i] = static_cast<RealType>(x);
+        }
+        x_[256] = 0;
+        for (std::size_t i = 0; i != 257; ++i) {
+            long double y = x_[i];
+            f_[i] = static_cast<RealType>(std::exp(-y));
+        }
+    }
+}; // class ExponentialZigguratTable
+
+/// \brief Tail and wedge of the Ziggurat for a candidate `x` rejected from
+/// layer `i`, falling back to a complete new draw if it is rejected again
+template <typename RealType, typename RNGType>
+inline RealType exponential_ziggurat_slow(
+    RNGType &rng, std::size_t i, RealType x);
+
+template <typename RealType, typename RNGType>
+inline RealType exponential_ziggurat(RNGType &rng)
+{
+    const ExponentialZigguratTable<RealType> &table =
+        ExponentialZigguratTable<RealType>::instance();
+    const RealType *const x = table.x();
+
+    UniformBitsDistribution<std::uint64_t> ubits;
+    const std::uint64_t u = ubits(rng);
+    const std::size_t i = static_cast<std::size_t>(u & 0xFF);
+    const RealType v = ziggurat_u01<RealType>(u) * x[i];
+    if (v < x[i + 1])
+        return v;
+
+    return exponential_ziggurat_slow(rng, i, v);
+}
+
+template <typename RealType, typename RNGType>
+inline RealType exponential_ziggurat_slow(
+    RNGType &rng, std::size_t i, RealType x)
+{
+    const ExponentialZigguratTable<RealType> &table =
+        ExponentialZigguratTable<RealType>::instance();
+    const RealType *const f = table.f();
+
+    U01OCDistribution<RealType> u01;
+    if (i == 0)
+        return table.r() - std::log(u01(rng));
+
+    if (f[i + 1] + u01(rng) * (f[i] - f[i + 1]) < std::exp(-x))
+        return x;
+
+    return exponential_ziggurat<RealType>(rng);
+}
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline void exponential_ziggurat_distribution_impl(
+    RNGType &rng, std::size_t n, RealType *r, RealType lambda)
+{
+    const ExponentialZigguratTable<RealType> &table =
+        ExponentialZigguratTable<RealType>::instance();
+    const RealType *const x = table.x();
+
+    Array<std::uint64_t, K> s;
+    uniform_bits_distribution(rng, n, s.data());
+
+    // Fast path, accepting about 99% of the candidates, after which s[j] is
+    // nonzero if the candidate is rejected
+    for (std::size_t j = 0; j != n; ++j) {
+        const std::uint64_t u = s[j];
+        const std::size_t i = static_cast<std::size_t>(u & 0xFF);
+        const RealType v = ziggurat_u01<RealType>(u) * x[i];
+        r[j] = v;
+        s[j] = ((u & 0xFF) + 1) * static_cast<std::uint64_t>(!(v < x[i + 1]));
+    }
+
+    for (std::size_t j = 0; j != n; ++j) {
+        if (s[j] != 0) {
+            r[j] = exponential_ziggurat_slow(
+                rng, static_cast<std::size_t>(s[j] - 1), r[j]);
+        }
+    }
+
+    if (!is_one(lambda))
+        mul(n, 1 / lambda, r, r);
+}
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_IMPL_1(
+    ExponentialZiggurat, exponential_ziggurat, RealType, RealType, lambda)
+
 } // namespace mckl::internal
 
 /// \brief Exponential distribution
@@ -90,6 +222,40 @@ class ExponentialDistribution
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(Exponential, RealType)
 
+/// \brief Exponential distribution using the Ziggurat method
+/// \ingroup Distribution
+///
+/// \details
+/// The same distribution as `ExponentialDistribution`, generated with the
+/// Ziggurat method of Marsaglia and Tsang (2000) with 256 layers, which
+/// requires no transcendental functions for about 99% of the variates. See
+/// `NormalZigguratDistribution` for the batch generation. The results are
+/// different from those of `ExponentialDistribution`.
+template <typename RealType>
+class ExponentialZigguratDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_REAL_TYPE(ExponentialZiggurat)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_1(ExponentialZiggurat,
+        exponential_ziggurat, RealType, result_type, lambda, 1)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_MEMBER_0
+
+    public:
+    result_type min() const { return 0; }
+
+    result_type max() const { return std::numeric_limits<result_type>::max(); }
+
+    void reset() {}
+
+    private:
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        return internal::exponential_ziggurat<RealType>(rng) / param.lambda();
+    }
+}; // class ExponentialZigguratDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(ExponentialZiggurat, RealType)
+
 } // namespace mckl
 
 #endif // MCKL_RANDOM_EXPONENTIAL_DISTRIBUTION_HPP
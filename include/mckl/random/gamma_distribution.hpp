@@ -111,14 +111,37 @@ class GammaDistributionConstant
     GammaDistributionAlgorithm algorithm_;
 }; // class GammaDistributionConstant
 
+/// \brief Move the accepted candidates `x[i]`, those with `a[i] != 0`, to the
+/// front of `x`, and copy at most `nr` of them to `r`
+///
+/// \details
+/// The compaction is done without branches such that the cost does not depend
+/// on the pattern of rejections. Accepted candidates in excess of `nr` are
+/// discarded.
+template <typename RealType>
+inline std::size_t gamma_distribution_compact(std::size_t n, RealType *x,
+    const std::size_t *a, std::size_t nr, RealType *r)
+{
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        x[m] = x[i];
+        m += a[i];
+    }
+    m = std::min(m, nr);
+    std::copy_n(x, m, r);
+
+    return m;
+}
+
 template <std::size_t K, typename RealType, typename RNGType>
 inline std::size_t gamma_distribution_impl_t(RNGType &rng, std::size_t n,
-    RealType *r, RealType alpha, RealType beta,
+    std::size_t nr, RealType *r, RealType alpha, RealType beta,
     const GammaDistributionConstant<RealType> &constant)
 {
     const RealType d = constant.d();
     const RealType c = constant.c();
     Array<RealType, K * 3> s;
+    Array<std::size_t, K> a;
     RealType *const u = s.data();
     RealType *const e = s.data() + n;
     RealType *const x = s.data() + n * 2;
@@ -126,35 +149,44 @@ inline std::size_t gamma_distribution_impl_t(RNGType &rng, std::size_t n,
     u01_oo_distribution(rng, n * 2, s.data());
     log(n, e, e);
     mul(n, static_cast<RealType>(-1), e, e);
+
+    // Only the candidates with u[i] > d need the logarithm in the second
+    // step. They are packed to the front of x, and the results are unpacked
+    // back without branches
+    std::size_t l = 0;
     for (std::size_t i = 0; i != n; ++i) {
-        if (u[i] > d) {
-            u[i] = -std::log(c * (1 - u[i]));
-            e[i] += u[i];
-            u[i] = d + alpha * u[i];
-        }
+        x[l] = c * (1 - u[i]);
+        l += u[i] > d ? 1 : 0;
     }
+    log(l, x, x);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t f = u[i] > d ? 1 : 0;
+        const RealType t = f != 0 ? x[j] : 0;
+        e[i] -= t;
+        u[i] = f != 0 ? d - alpha * t : u[i];
+        j += f;
+    }
+
     log(n, u, x);
     mul(n, c, x, x);
     exp(n, x, x);
-    abs(n, x, u);
-    mul(n, beta, x, x);
-
-    std::size_t m = 0;
     for (std::size_t i = 0; i != n; ++i)
-        if (u[i] < e[i])
-            r[m++] = x[i];
+        a[i] = std::abs(x[i]) < e[i] ? 1 : 0;
+    mul(n, beta, x, x);
 
-    return m;
+    return gamma_distribution_compact(n, x, a.data(), nr, r);
 }
 
 template <std::size_t K, typename RealType, typename RNGType>
 inline std::size_t gamma_distribution_impl_w(RNGType &rng, std::size_t n,
-    RealType *r, RealType, RealType beta,
+    std::size_t nr, RealType *r, RealType, RealType beta,
     const GammaDistributionConstant<RealType> &constant)
 {
     const RealType d = constant.d();
     const RealType c = constant.c();
     Array<RealType, K * 3> s;
+    Array<std::size_t, K> a;
     RealType *const u = s.data();
     RealType *const e = s.data() + n;
     RealType *const x = s.data() + n * 2;
@@ -167,24 +199,22 @@ inline std::size_t gamma_distribution_impl_w(RNGType &rng, std::size_t n,
     exp(n, x, x);
     add(n, u, e, u);
     add(n, d, x, e);
-    mul(n, beta, x, x);
-
-    std::size_t m = 0;
     for (std::size_t i = 0; i != n; ++i)
-        if (u[i] > e[i])
-            r[m++] = x[i];
+        a[i] = u[i] > e[i] ? 1 : 0;
+    mul(n, beta, x, x);
 
-    return m;
+    return gamma_distribution_compact(n, x, a.data(), nr, r);
 }
 
 template <std::size_t K, typename RealType, typename RNGType>
 inline std::size_t gamma_distribution_impl_n(RNGType &rng, std::size_t n,
-    RealType *r, RealType, RealType beta,
+    std::size_t nr, RealType *r, RealType, RealType beta,
     const GammaDistributionConstant<RealType> &constant)
 {
     const RealType d = constant.d();
     const RealType c = constant.c();
     Array<RealType, K * 5> s;
+    Array<std::size_t, K> a;
     RealType *const u = s.data();
     RealType *const e = s.data() + n;
     RealType *const v = s.data() + n * 2;
@@ -195,41 +225,47 @@ inline std::size_t gamma_distribution_impl_n(RNGType &rng, std::size_t n,
     normal_distribution(
         rng, n, w, const_zero<RealType>(), const_one<RealType>());
     fma(n, c, w, const_one<RealType>(), v);
-    NormalDistribution<RealType> rnorm(0, 1);
-    for (std::size_t i = 0; i != n; ++i) {
-        if (v[i] <= 0) {
-            do {
-                w[i] = rnorm(rng);
-                v[i] = 1 + c * w[i];
-            } while (v[i] <= 0);
-        }
-    }
-    sqr(n, v, e);
-    mul(n, v, e, v);
     sqr(n, w, e);
     sqr(n, e, e);
     fma(n, -static_cast<RealType>(0.0331), e, const_one<RealType>(), e);
+
+    // a[i] is 0 if the candidate is rejected because v[i] <= 0, 1 if it is
+    // accepted by the squeeze, and 2 if it needs the logarithmic test
+    for (std::size_t i = 0; i != n; ++i)
+        a[i] = (v[i] > 0 ? 1 : 0) * (u[i] < e[i] ? 1 : 2);
+    sqr(n, v, e);
+    mul(n, v, e, v);
     mul(n, d * beta, v, x);
 
-    std::size_t m = 0;
+    // The few candidates that fail the squeeze are packed to the front of
+    // u, v and w, such that the logarithms are computed only for them
+    std::size_t l = 0;
     for (std::size_t i = 0; i != n; ++i) {
-        if (u[i] < e[i]) {
-            r[m++] = x[i];
-        } else {
-            e[i] = w[i] * w[i] / 2 + d * (1 - v[i] + std::log(v[i]));
-            if (std::log(u[i]) < e[i])
-                r[m++] = x[i];
-        }
+        u[l] = u[i];
+        v[l] = v[i];
+        w[l] = w[i];
+        l += a[i] >> 1;
+    }
+    log(l, u, u);
+    log(l, v, e);
+    for (std::size_t i = 0; i != l; ++i)
+        e[i] = w[i] * w[i] / 2 + d * (1 - v[i] + e[i]);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t f = a[i] >> 1;
+        a[i] = (a[i] & 1) | (f & (u[j] < e[j] ? 1 : 0));
+        j += f;
     }
 
-    return m;
+    return gamma_distribution_compact(n, x, a.data(), nr, r);
 }
 
 template <std::size_t, typename RealType, typename RNGType>
 inline std::size_t gamma_distribution_impl_e(RNGType &rng, std::size_t n,
-    RealType *r, RealType, RealType beta,
+    std::size_t nr, RealType *r, RealType, RealType beta,
     const GammaDistributionConstant<RealType> &)
 {
+    n = std::min(n, nr);
     u01_oo_distribution(rng, n, r);
     log(n, r, r);
     mul(n, -beta, r, r);
@@ -237,24 +273,26 @@ inline std::size_t gamma_distribution_impl_e(RNGType &rng, std::size_t n,
     return n;
 }
 
+/// \brief Generate `n` candidates and store at most `nr` accepted variates in
+/// `r`, returning the number of variates stored
 template <std::size_t K, typename RealType, typename RNGType>
 inline std::size_t gamma_distribution_impl(RNGType &rng, std::size_t n,
-    RealType *r, RealType alpha, RealType beta,
+    std::size_t nr, RealType *r, RealType alpha, RealType beta,
     const GammaDistributionConstant<RealType> &constant)
 {
     switch (constant.algorithm()) {
         case GammaDistributionAlgorithmT:
             return gamma_distribution_impl_t<K>(
-                rng, n, r, alpha, beta, constant);
+                rng, n, nr, r, alpha, beta, constant);
         case GammaDistributionAlgorithmW:
             return gamma_distribution_impl_w<K>(
-                rng, n, r, alpha, beta, constant);
+                rng, n, nr, r, alpha, beta, constant);
         case GammaDistributionAlgorithmN:
             return gamma_distribution_impl_n<K>(
-                rng, n, r, alpha, beta, constant);
+                rng, n, nr, r, alpha, beta, constant);
         case GammaDistributionAlgorithmE:
             return gamma_distribution_impl_e<K>(
-                rng, n, r, alpha, beta, constant);
+                rng, n, nr, r, alpha, beta, constant);
     }
     return 0;
 }
@@ -265,18 +303,29 @@ inline void gamma_distribution(
 {
     const std::size_t k = BufferSize<RealType>::value;
     const GammaDistributionConstant<RealType> constant(alpha, beta);
-    while (n > k) {
+
+    // When refilling the rejected variates, the number of candidates is
+    // increased by the number of rejections expected from the acceptance rate
+    // observed so far, such that the refill rarely needs another one
+    std::size_t trial = 0;
+    std::size_t accept = 0;
+    while (n != 0) {
+        std::size_t l = std::min(n, k);
+        if (accept != 0 && l < k) {
+            const double rate = static_cast<double>(trial - accept) /
+                static_cast<double>(accept);
+            l += static_cast<std::size_t>(l * rate) + l / 32 + 1;
+            l = std::min(l, k);
+        }
         std::size_t m =
-            gamma_distribution_impl<k>(rng, k, r, alpha, beta, constant);
+            gamma_distribution_impl<k>(rng, l, n, r, alpha, beta, constant);
         if (m == 0)
             break;
+        trial += l;
+        accept += m;
         n -= m;
         r += m;
     }
-    std::size_t m =
-        gamma_distribution_impl<k>(rng, n, r, alpha, beta, constant);
-    n -= m;
-    r += m;
     if (n > 0) {
         GammaDistribution<RealType> dist(alpha, beta);
         for (std::size_t i = 0; i != n; ++i)
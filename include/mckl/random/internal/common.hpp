@@ -880,6 +880,60 @@ inline IntType ftoi(RealType x)
     return ftoi<IntType>(x, std::integral_constant<bool, W <= M>());
 }
 
+template <typename RealType>
+inline RealType ziggurat_u01(std::uint64_t u, std::false_type)
+{
+    static constexpr int W = std::numeric_limits<RealType>::digits < 53 ?
+        std::numeric_limits<RealType>::digits :
+        53;
+
+    return static_cast<RealType>(u >> (64 - W)) *
+        (const_one<RealType>() / static_cast<RealType>(1ULL << W));
+}
+
+inline float ziggurat_u01(std::uint64_t u, std::true_type, float)
+{
+    const std::uint32_t b =
+        static_cast<std::uint32_t>(u >> 41) | UINT32_C(0x3F800000);
+    float r;
+    std::memcpy(&r, &b, sizeof(float));
+
+    return r - 1;
+}
+
+inline double ziggurat_u01(std::uint64_t u, std::true_type, double)
+{
+    const std::uint64_t b = (u >> 12) | UINT64_C(0x3FF0000000000000);
+    double r;
+    std::memcpy(&r, &b, sizeof(double));
+
+    return r - 1;
+}
+
+template <typename RealType>
+inline RealType ziggurat_u01(std::uint64_t u, std::true_type)
+{
+    return ziggurat_u01(u, std::true_type(), RealType());
+}
+
+/// \brief Convert the high bits of a 64-bit random integer to a uniform
+/// random number on [0, 1), leaving the low 9 bits for the Ziggurat layer
+/// index and sign
+///
+/// \details
+/// For IEEE-754 `float` and `double`, the high bits are placed directly into
+/// the mantissa of a number on [1, 2), avoiding the 64-bit integer to floating
+/// point conversion, which is not vectorized on most targets
+template <typename RealType>
+inline RealType ziggurat_u01(std::uint64_t u)
+{
+    return ziggurat_u01<RealType>(u,
+        std::integral_constant<bool,
+            std::numeric_limits<RealType>::is_iec559 &&
+                (std::is_same<RealType, float>::value ||
+                    std::is_same<RealType, double>::value)>());
+}
+
 } // namespace mckl::internal
 
 /// \brief Traits of RNG engines
@@ -950,6 +1004,9 @@ inline void rand(RNGType &rng, DistributionType &distribution, std::size_t n,
 template <typename, typename>
 class CounterEngine;
 
+template <typename>
+class SobolEngine;
+
 template <typename = double>
 class ArcsineDistribution;
 
@@ -968,9 +1025,15 @@ class DirichletDistribution;
 template <typename = int>
 class DiscreteDistribution;
 
+template <typename = int>
+class DiscreteAliasDistribution;
+
 template <typename = double>
 class ExponentialDistribution;
 
+template <typename = double>
+class ExponentialZigguratDistribution;
+
 template <typename = double>
 class ExtremeValueDistribution;
 
@@ -998,6 +1061,9 @@ class NormalDistribution;
 template <typename = double, std::size_t = Dynamic>
 class NormalMVDistribution;
 
+template <typename = double>
+class NormalZigguratDistribution;
+
 template <typename = double>
 class ParetoDistribution;
 
@@ -1047,6 +1113,9 @@ template <typename ResultType, typename Generator>
 inline void rand(
     CounterEngine<ResultType, Generator> &, std::size_t, ResultType *);
 
+template <typename UIntType>
+inline void rand(SobolEngine<UIntType> &, std::size_t, UIntType *);
+
 template <typename RealType, typename RNGType>
 inline void rand(
     RNGType &, ArcsineDistribution<RealType> &, std::size_t, RealType *);
@@ -1071,10 +1140,18 @@ template <typename RealType, typename RNGType>
 inline void rand(
     RNGType &, DiscreteDistribution<RealType> &, std::size_t, RealType *);
 
+template <typename RealType, typename RNGType>
+inline void rand(
+    RNGType &, DiscreteAliasDistribution<RealType> &, std::size_t, RealType *);
+
 template <typename RealType, typename RNGType>
 inline void rand(
     RNGType &, ExponentialDistribution<RealType> &, std::size_t, RealType *);
 
+template <typename RealType, typename RNGType>
+inline void rand(RNGType &, ExponentialZigguratDistribution<RealType> &,
+    std::size_t, RealType *);
+
 template <typename RealType, typename RNGType>
 inline void rand(
     RNGType &, ExtremeValueDistribution<RealType> &, std::size_t, RealType *);
@@ -1111,6 +1188,10 @@ template <typename RealType, std::size_t Dim, typename RNGType>
 inline void rand(
     RNGType &, NormalMVDistribution<RealType, Dim> &, std::size_t, RealType *);
 
+template <typename RealType, typename RNGType>
+inline void rand(RNGType &, NormalZigguratDistribution<RealType> &,
+    std::size_t, RealType *);
+
 template <typename RealType, typename RNGType>
 inline void rand(
     RNGType &, ParetoDistribution<RealType> &, std::size_t, RealType *);
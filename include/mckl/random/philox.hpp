@@ -40,6 +40,19 @@
 #include <intrin.h>
 #endif
 
+#if MCKL_HAS_AVX2 || MCKL_HAS_AVX512F
+#include <immintrin.h>
+#elif MCKL_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+#endif
+
 #define MCKL_DEFINE_RANDOM_PHILOX_WEYL_CONSTANT(W, K, val)                    \
     template <typename T>                                                     \
     class PhiloxWeylConstant<T, K, W>                                         \
@@ -381,6 +394,229 @@ class PhiloxPBox<T, 8, N, true>
     }
 }; // class PhiloxPBox
 
+#if MCKL_HAS_SSE2
+
+#if MCKL_HAS_AVX512F
+using PhiloxSIMDType = __m512i;
+#elif MCKL_HAS_AVX2
+using PhiloxSIMDType = __m256i;
+#else
+using PhiloxSIMDType = __m128i;
+#endif
+
+inline void philox_simd_set(__m128i a, __m128i &v) { v = a; }
+
+inline __m128i philox_simd_add(__m128i a, __m128i b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+template <int Imm>
+inline __m128i philox_simd_sbox(__m128i s, __m128i m, __m128i k)
+{
+    const __m128i p = _mm_shuffle_epi32(_mm_mul_epu32(s, m), Imm);
+
+    return _mm_xor_si128(_mm_xor_si128(p, _mm_srli_epi64(s, 32)), k);
+}
+
+#if MCKL_HAS_AVX2
+
+inline void philox_simd_set(__m128i a, __m256i &v)
+{
+    v = _mm256_broadcastsi128_si256(a);
+}
+
+inline __m256i philox_simd_add(__m256i a, __m256i b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+template <int Imm>
+inline __m256i philox_simd_sbox(__m256i s, __m256i m, __m256i k)
+{
+    const __m256i p = _mm256_shuffle_epi32(_mm256_mul_epu32(s, m), Imm);
+
+    return _mm256_xor_si256(_mm256_xor_si256(p, _mm256_srli_epi64(s, 32)), k);
+}
+
+#endif // MCKL_HAS_AVX2
+
+#if MCKL_HAS_AVX512F
+
+// The zero-masking forms with full masks compile to the same instructions as
+// the unmasked ones. Unlike the latter, they do not take an uninitialized
+// pass-through operand, which GCC 12 reports through -Wmaybe-uninitialized
+
+inline void philox_simd_set(__m128i a, __m512i &v)
+{
+    const __m512i b = _mm512_castsi128_si512(a);
+    v = _mm512_maskz_shuffle_i32x4(0xFFFF, b, b, 0);
+}
+
+inline __m512i philox_simd_add(__m512i a, __m512i b)
+{
+    return _mm512_add_epi32(a, b);
+}
+
+template <int Imm>
+inline __m512i philox_simd_sbox(__m512i s, __m512i m, __m512i k)
+{
+    const __m512i p = _mm512_maskz_shuffle_epi32(0xFFFF,
+        _mm512_maskz_mul_epu32(0xFF, s, m), static_cast<_MM_PERM_ENUM>(Imm));
+
+    return _mm512_ternarylogic_epi32(
+        p, _mm512_maskz_srli_epi64(0xFF, s, 32), k, 0x96);
+}
+
+#endif // MCKL_HAS_AVX512F
+
+#endif // MCKL_HAS_SSE2
+
+/// \brief Generate multiple blocks with SIMD instructions
+///
+/// \details
+/// The generic version does nothing and returns zero, the number of blocks
+/// generated. The caller generates the remaining blocks.
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants,
+    bool = (MCKL_HAS_SSE2 && std::numeric_limits<T>::digits == 32 &&
+        (K == 2 || K == 4))>
+class PhiloxGeneratorSIMD
+{
+    public:
+    static std::size_t eval(std::array<T, K> &, std::size_t, void *,
+        const std::array<std::array<T, K / 2>, Rounds + 1> &)
+    {
+        return 0;
+    }
+}; // class PhiloxGeneratorSIMD
+
+#if MCKL_HAS_SSE2
+
+/// \brief Generate multiple 32-bit Philox2x32 or Philox4x32 blocks with SIMD
+/// instructions
+///
+/// \details
+/// Each 64-bit lane holds a pair of 32-bit words of a block, and the blocks
+/// are kept in their usual layout. In each round, the low words of the lanes
+/// are multiplied with `mul_epu32`. The PBox of Philox4x32 is absorbed into
+/// the order of the multipliers and the shuffle of the products. The results
+/// are identical to the scalar implementation.
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
+class PhiloxGeneratorSIMD<T, K, Rounds, Constants, true>
+{
+    public:
+    static std::size_t eval(std::array<T, K> &ctr, std::size_t n,
+        void *buffer, const std::array<std::array<T, K / 2>, Rounds + 1> &par)
+    {
+        union {
+            std::array<PhiloxSIMDType, S_> state;
+            std::array<std::array<T, K>, Blocks_> ctr_block;
+        } buf;
+
+        PhiloxSIMDType mul;
+        std::array<PhiloxSIMDType, Rounds + 1> key;
+        philox_simd_set(multiplier(tag()), mul);
+        for (std::size_t r = 1; r <= Rounds; ++r)
+            philox_simd_set(pattern(par[r], tag()), key[r]);
+
+        std::memset(buf.ctr_block.data(), 0, sizeof(buf));
+        for (std::size_t j = 0; j != Blocks_; ++j)
+            buf.ctr_block[j].front() = static_cast<T>(j + 1);
+        const std::array<PhiloxSIMDType, S_> offset(buf.state);
+
+        const std::size_t m = n / Blocks_;
+        char *b = static_cast<char *>(buffer);
+        PhiloxSIMDType s0;
+        PhiloxSIMDType s1;
+        PhiloxSIMDType s2;
+        PhiloxSIMDType s3;
+        for (std::size_t i = 0; i != m; ++i, b += sizeof(buf)) {
+            if (ctr.front() <=
+                std::numeric_limits<T>::max() - static_cast<T>(Blocks_)) {
+                PhiloxSIMDType c;
+                philox_simd_set(pattern(ctr, tag()), c);
+                s0 = philox_simd_add(c, std::get<0>(offset));
+                s1 = philox_simd_add(c, std::get<1>(offset));
+                s2 = philox_simd_add(c, std::get<2>(offset));
+                s3 = philox_simd_add(c, std::get<3>(offset));
+                ctr.front() += static_cast<T>(Blocks_);
+            } else {
+                increment(ctr, buf.ctr_block);
+                s0 = std::get<0>(buf.state);
+                s1 = std::get<1>(buf.state);
+                s2 = std::get<2>(buf.state);
+                s3 = std::get<3>(buf.state);
+            }
+            for (std::size_t r = 1; r <= Rounds; ++r) {
+                s0 = philox_simd_sbox<Imm_>(s0, mul, key[r]);
+                s1 = philox_simd_sbox<Imm_>(s1, mul, key[r]);
+                s2 = philox_simd_sbox<Imm_>(s2, mul, key[r]);
+                s3 = philox_simd_sbox<Imm_>(s3, mul, key[r]);
+            }
+            std::get<0>(buf.state) = s0;
+            std::get<1>(buf.state) = s1;
+            std::get<2>(buf.state) = s2;
+            std::get<3>(buf.state) = s3;
+            std::memcpy(b, buf.state.data(), sizeof(buf));
+        }
+
+        return m * Blocks_;
+    }
+
+    private:
+    static constexpr std::size_t S_ = 4;
+    static constexpr std::size_t Blocks_ =
+        sizeof(PhiloxSIMDType) * S_ / (sizeof(T) * K);
+    static constexpr int Imm_ = K == 4 ? 0x1B : 0xB1;
+
+    template <std::size_t I>
+    using mulc = typename Constants::template multiplier<I>;
+
+    using tag = std::integral_constant<std::size_t, K>;
+
+    static int cast(T x) { return static_cast<int>(x); }
+
+    static __m128i multiplier(std::integral_constant<std::size_t, 2>)
+    {
+        return _mm_set_epi32(0, cast(mulc<0>::value), 0, cast(mulc<0>::value));
+    }
+
+    static __m128i multiplier(std::integral_constant<std::size_t, 4>)
+    {
+        return _mm_set_epi32(0, cast(mulc<0>::value), 0, cast(mulc<1>::value));
+    }
+
+    static __m128i pattern(
+        const std::array<T, 1> &k, std::integral_constant<std::size_t, 2>)
+    {
+        return _mm_set_epi32(
+            0, cast(std::get<0>(k)), 0, cast(std::get<0>(k)));
+    }
+
+    static __m128i pattern(
+        const std::array<T, 2> &k, std::integral_constant<std::size_t, 4>)
+    {
+        return _mm_set_epi32(
+            0, cast(std::get<1>(k)), 0, cast(std::get<0>(k)));
+    }
+
+    static __m128i pattern(
+        const std::array<T, 2> &c, std::integral_constant<std::size_t, 2>)
+    {
+        return _mm_set_epi32(cast(std::get<1>(c)), cast(std::get<0>(c)),
+            cast(std::get<1>(c)), cast(std::get<0>(c)));
+    }
+
+    static __m128i pattern(
+        const std::array<T, 4> &c, std::integral_constant<std::size_t, 4>)
+    {
+        return _mm_set_epi32(cast(std::get<3>(c)), cast(std::get<2>(c)),
+            cast(std::get<1>(c)), cast(std::get<0>(c)));
+    }
+}; // class PhiloxGeneratorSIMD
+
+#endif // MCKL_HAS_SSE2
+
 } // namespace mckl::internal
 
 /// \brief Philox RNG generator
@@ -450,7 +686,10 @@ class PhiloxGenerator
         std::array<key_type, Rounds + 1> par;
         internal::PhiloxInitPar<T, K, Constants>::eval(key_, par);
 
-        for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t m =
+            internal::PhiloxGeneratorSIMD<T, K, Rounds, Constants>::eval(
+                ctr, n, buffer, par);
+        for (std::size_t i = m; i != n; ++i) {
             increment(ctr);
             buf.ctr = ctr;
             generate<0>(buf.state, par, std::true_type());
@@ -591,4 +830,10 @@ using Philox_64 = Philox4x64Engine<std::uint64_t>;
 
 } // namespace mckl
 
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic pop
+#endif
+#endif
+
 #endif // MCKL_RANDOM_PHILOX_HPP
@@ -74,6 +74,21 @@ class RNGSetScalar
 
     rng_type &operator[](size_type) { return rng_; }
 
+    /// \brief Store the engine in checkpoint sections prefixed by `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        ar.write(name + "/Size", size_);
+        ar.write(name + "/RNG", rng_);
+    }
+
+    /// \brief Restore the engine from checkpoint sections prefixed by `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        return ar.read(name + "/Size", size_) && ar.read(name + "/RNG", rng_);
+    }
+
     private:
     std::size_t size_;
     rng_type rng_;
@@ -109,10 +124,321 @@ class RNGSetVector
 
     rng_type &operator[](size_type id) { return rng_[id % size()]; }
 
+    /// \brief Store the engines in checkpoint sections prefixed by `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        ar.write(name + "/RNG", rng_.size(), rng_.data());
+    }
+
+    /// \brief Restore the engines from checkpoint sections prefixed by `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        rng_.resize(ar.size(name + "/RNG"));
+
+        return ar.read(name + "/RNG", rng_.size(), rng_.data());
+    }
+
     private:
     Vector<rng_type> rng_;
 }; // class RNGSetVector
 
+/// \brief Counter-based RNG set
+/// \ingroup Random
+///
+/// \details
+/// Instead of storing an engine for each particle, the engines of a particle
+/// are created on demand. The key of an engine is derived by encrypting the
+/// particle index and the number of calls to `operator[]` made before for
+/// that particle within the same stream, with a global key, which is seeded
+/// by `Seed`. Its counter starts with the most significant word set to the
+/// current stream number. Therefore the random numbers of a particle depend
+/// only on the seed, its index, the stream number and the number of calls
+/// made before, but not on the number of threads, the backend or the order in
+/// which the particles are processed, and resizing or resampling does not
+/// copy any RNG state. Only the stream number and the call count are stored
+/// for each particle.
+///
+/// Each call to `step(n)` starts `n` new streams for every particle, one for
+/// each pass over the particles, such as those of the moves of a fused
+/// iteration. The stream number of pass `k` is `step_num() + k`, and thus it
+/// is determined by the number of steps and passes made before. A thread
+/// selects the pass of its subsequent accesses with `pass(k)`, and the first
+/// pass is selected after each step. The passes of a step shall be made in
+/// order.
+///
+/// Each call to `operator[]` returns a new engine, which is independent of
+/// those returned by previous calls for the same particle. The reference
+/// remains valid until `operator[]` has been called `local_size()` more times
+/// on the same thread, for any particle or `RNGSetCounter` object. Within a
+/// pass, a particle may be accessed by any thread, but not concurrently.
+/// `Sampler` calls `step()` before each evaluation, including those of
+/// monitors, and the fused iteration makes one pass for each evaluation
+/// object.
+///
+/// `RNGType` shall be a counter-based engine, such as `Philox4x32`,
+/// `Threefry4x64` or `ARS`. The stream of an engine is exhausted after its
+/// counter overflows into the most significant word. If the counter of
+/// `RNGType` is narrower than 128 bits, the particle index and the call count
+/// shall be less than \f$2^{32}\f$.
+template <typename RNGType = RNG>
+class RNGSetCounter
+{
+    public:
+    using rng_type = RNGType;
+    using size_type = std::size_t;
+
+    explicit RNGSetCounter(size_type N = 0) : size_(N) { seed(); }
+
+    RNGSetCounter(const RNGSetCounter<RNGType> &other)
+        : size_(other.size_)
+        , step_(other.step_)
+        , passes_(other.passes_)
+        , serial_(serial())
+        , rng_(other.rng_)
+        , count_(other.count_)
+    {
+    }
+
+    RNGSetCounter<RNGType> &operator=(const RNGSetCounter<RNGType> &other)
+    {
+        if (this != &other) {
+            size_ = other.size_;
+            step_ = other.step_;
+            passes_ = other.passes_;
+            serial_ = serial();
+            rng_ = other.rng_;
+            count_ = other.count_;
+        }
+
+        return *this;
+    }
+
+    size_type size() const { return size_; }
+
+    void resize(std::size_t n)
+    {
+        size_ = n;
+        count_.resize(n);
+    }
+
+    void seed()
+    {
+        Seed::instance()(rng_);
+        step_ = 0;
+        passes_ = 1;
+        serial_ = serial();
+        reset();
+    }
+
+    /// \brief Start new streams for all particles, for `n` passes
+    void step(std::size_t n = 1)
+    {
+        step_ += passes_;
+        passes_ = std::max(n, static_cast<std::size_t>(1));
+    }
+
+    /// \brief Select the streams of pass `k` of the current step for the
+    /// subsequent accesses made by the calling thread
+    void pass(std::size_t k)
+    {
+        runtime_assert(k < passes_,
+            "**RNGSetCounter::pass** the pass is not within the current step");
+
+        Local &local = this->local();
+        local.serial = serial_;
+        local.step = step_;
+        local.pass = k;
+    }
+
+    /// \brief The current step number, which is also the stream number of the
+    /// first pass
+    std::size_t step_num() const { return step_; }
+
+    /// \brief The number of passes of the current step
+    std::size_t num_passes() const { return passes_; }
+
+    /// \brief The number of engines held by each thread
+    static constexpr std::size_t local_size() { return LocalSize; }
+
+    rng_type &operator[](size_type id)
+    {
+        runtime_assert(id < count_.size(),
+            "**RNGSetCounter::operator[]** the index is out of range");
+
+        Local &local = this->local();
+        const std::size_t stream = step_ +
+            (local.serial == serial_ && local.step == step_ ? local.pass : 0);
+
+        Count &count = count_[id];
+        if (count.stream != stream + 1) {
+            runtime_assert(count.stream < stream + 1,
+                "**RNGSetCounter::operator[]** the pass is before the last "
+                "pass made for the particle");
+            count.stream = stream + 1;
+            count.call = 0;
+        }
+
+        rng_type &rng = local.rng[local.next];
+        local.next = (local.next + 1) % LocalSize;
+        rng = engine_stream(id, stream, count.call++);
+
+        return rng;
+    }
+
+    /// \brief Store the global engine, the step number and the number of
+    /// passes in checkpoint sections prefixed by `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        const std::array<std::size_t, 3> state = {{size_, step_, passes_}};
+        ar.write(name + "/Step", state.size(), state.data());
+        ar.write(name + "/RNG", rng_);
+    }
+
+    /// \brief Restore the global engine, the step number and the number of
+    /// passes from checkpoint sections prefixed by `name`
+    ///
+    /// \details
+    /// The call counts within the streams of the current step are not stored,
+    /// and thus `step()` shall be called before drawing random numbers again.
+    /// The new streams do not overlap any drawn before the checkpoint.
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        std::array<std::size_t, 3> state;
+        if (!ar.read(name + "/Step", state.size(), state.data()) ||
+            !ar.read(name + "/RNG", rng_)) {
+            return false;
+        }
+        size_ = state[0];
+        step_ = state[1];
+        passes_ = state[2];
+        serial_ = serial();
+        reset();
+
+        return true;
+    }
+
+    /// \brief Create the engine returned by the first call to `operator[]`
+    /// for a given particle in pass `k` of the current step
+    rng_type engine(size_type id, std::size_t k = 0) const
+    {
+        return engine_stream(id, step_ + k, 0);
+    }
+
+    private:
+    using ctr_type = typename rng_type::ctr_type;
+    using result_type = typename rng_type::result_type;
+    using skip_type = typename rng_type::skip_type;
+
+    static constexpr std::size_t LocalSize = 16;
+
+    class Count
+    {
+        public:
+        Count() : stream(0), call(0) {}
+
+        // One plus the stream number of the last access, zero if none
+        std::size_t stream;
+        std::size_t call;
+    }; // class Count
+
+    class Local
+    {
+        public:
+        Local() : next(0), serial(0), step(0), pass(0) {}
+
+        std::array<rng_type, LocalSize> rng;
+        std::size_t next;
+
+        // The pass selected by `pass()`, valid only within the same step
+        std::size_t serial;
+        std::size_t step;
+        std::size_t pass;
+    }; // class Local
+
+    std::size_t size_;
+    std::size_t step_;
+    std::size_t passes_;
+    std::size_t serial_;
+    rng_type rng_;
+    Vector<Count> count_;
+
+    void reset()
+    {
+        count_.clear();
+        count_.resize(size_);
+    }
+
+    rng_type engine_stream(
+        size_type id, std::size_t stream, std::size_t call) const
+    {
+        using key_type = typename rng_type::key_type;
+
+        static constexpr std::size_t K =
+            (sizeof(key_type) + sizeof(result_type) - 1) /
+            sizeof(result_type);
+
+        ctr_type ctr;
+        ctr.fill(0);
+        encode(ctr, id, call,
+            std::integral_constant<bool,
+                (sizeof(ctr_type) >= 2 * sizeof(std::size_t))>());
+        std::array<result_type, K> buf;
+        rng_type rng(rng_);
+        rng.ctr(ctr);
+        rng(K, buf.data());
+
+        key_type key;
+        std::memcpy(key.data(), buf.data(), sizeof(key_type));
+        rng.seed(key);
+
+        ctr.fill(0);
+        ctr.back() = static_cast<skip_type>(stream);
+        rng.ctr(ctr);
+
+        return rng;
+    }
+
+    static void encode(
+        ctr_type &ctr, size_type id, std::size_t call, std::true_type)
+    {
+        char *c = reinterpret_cast<char *>(ctr.data());
+        std::memcpy(c, &id, sizeof(id));
+        std::memcpy(c + sizeof(id), &call, sizeof(call));
+    }
+
+    static void encode(
+        ctr_type &ctr, size_type id, std::size_t call, std::false_type)
+    {
+        static constexpr std::size_t W = 0xFFFFFFFF;
+
+        runtime_assert(id <= W && call <= W,
+            "**RNGSetCounter::operator[]** the particle index or the call "
+            "count is too large for the counter");
+
+        const std::uint64_t c = static_cast<std::uint64_t>(id) |
+            (static_cast<std::uint64_t>(call) << 32);
+        std::memcpy(ctr.data(), &c, std::min(sizeof(c), sizeof(ctr)));
+    }
+
+    static Local &local()
+    {
+        static thread_local Local local;
+
+        return local;
+    }
+
+    static std::size_t serial()
+    {
+        static std::atomic<std::size_t> count(0);
+
+        return ++count;
+    }
+}; // class RNGSetCounter
+
 #if MCKL_HAS_TBB
 
 /// \brief Thread-local storage RNG set using tbb::combinable
@@ -149,6 +475,49 @@ class RNGSetTBB
 
 #endif // MCKL_HAS_TBB
 
+namespace internal
+{
+
+template <typename RNGSetType>
+inline auto rng_set_step(RNGSetType &rng_set, std::size_t n, int)
+    -> decltype(rng_set.step(n))
+{
+    rng_set.step(n);
+}
+
+template <typename RNGSetType>
+inline void rng_set_step(RNGSetType &, std::size_t, long)
+{
+}
+
+/// \brief Call `rng_set.step(n)` if it is defined
+template <typename RNGSetType>
+inline void rng_set_step(RNGSetType &rng_set, std::size_t n = 1)
+{
+    rng_set_step(rng_set, n, 0);
+}
+
+template <typename RNGSetType>
+inline auto rng_set_pass(RNGSetType &rng_set, std::size_t k, int)
+    -> decltype(rng_set.pass(k))
+{
+    rng_set.pass(k);
+}
+
+template <typename RNGSetType>
+inline void rng_set_pass(RNGSetType &, std::size_t, long)
+{
+}
+
+/// \brief Call `rng_set.pass(k)` if it is defined
+template <typename RNGSetType>
+inline void rng_set_pass(RNGSetType &rng_set, std::size_t k)
+{
+    rng_set_pass(rng_set, k, 0);
+}
+
+} // namespace mckl::internal
+
 /// \brief Default RNG set
 /// \ingroup Random
 template <typename RNGType = typename std::conditional<
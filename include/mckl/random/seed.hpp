@@ -99,13 +99,19 @@ class SeedGenerator
     void set(result_type s) { seed_ = s % max_; }
 
     /// \brief Get a seed
+    ///
+    /// \details
+    /// This function is thread-safe and lock-free. Concurrent calls always
+    /// return distinct seeds, unless all `max()` seeds are used.
     result_type get()
     {
-        ++seed_;
-        if (seed_ >= max_)
-            seed_ = 1;
+        result_type s = seed_.load();
+        result_type t = 0;
+        do {
+            t = s + 1 < max_ ? s + 1 : 1;
+        } while (!seed_.compare_exchange_weak(s, t));
 
-        return seed_ * divisor_ + remainder_;
+        return t * divisor_ + remainder_;
     }
 
     /// \brief The maximum of the seed
@@ -137,6 +143,31 @@ class SeedGenerator
         set(seed_);
     }
 
+    /// \brief Store the state in a checkpoint section `name`
+    template <typename Archive>
+    void checkpoint_store(Archive &ar, const std::string &name) const
+    {
+        const std::array<result_type, 4> state = {
+            {seed_.load(), max_, divisor_, remainder_}};
+        ar.write(name, state.size(), state.data());
+    }
+
+    /// \brief Restore the state from a checkpoint section `name`
+    template <typename Archive>
+    bool checkpoint_load(Archive &ar, const std::string &name)
+    {
+        std::array<result_type, 4> state;
+        if (!ar.read(name, state.size(), state.data()))
+            return false;
+
+        seed_ = state[0];
+        max_ = state[1];
+        divisor_ = state[2];
+        remainder_ = state[3];
+
+        return true;
+    }
+
     template <typename CharT, typename Traits>
     friend std::basic_ostream<CharT, Traits> &operator<<(
         std::basic_ostream<CharT, Traits> &os,
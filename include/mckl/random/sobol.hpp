@@ -0,0 +1,398 @@
+//============================================================================
+// MCKL/include/mckl/random/sobol.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_SOBOL_HPP
+#define MCKL_RANDOM_SOBOL_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/threefry.hpp>
+#include <mckl/random/uniform_bits_distribution.hpp>
+
+namespace mckl
+{
+
+namespace internal
+{
+
+// Primitive polynomials and initial direction numbers of dimensions 2 to 32
+// of Joe and Kuo (2008). Each row is the degree s, the coefficients a, and
+// the initial direction numbers m_1, ..., m_s
+inline const unsigned *sobol_direction_table(std::size_t d)
+{
+    static const unsigned table[][9] = {
+        {1, 0, 1, 0, 0, 0, 0, 0, 0}, {2, 1, 1, 3, 0, 0, 0, 0, 0},
+        {3, 1, 1, 3, 1, 0, 0, 0, 0}, {3, 2, 1, 1, 1, 0, 0, 0, 0},
+        {4, 1, 1, 1, 3, 3, 0, 0, 0}, {4, 4, 1, 3, 5, 13, 0, 0, 0},
+        {5, 2, 1, 1, 5, 5, 17, 0, 0}, {5, 4, 1, 1, 5, 5, 5, 0, 0},
+        {5, 7, 1, 1, 7, 11, 19, 0, 0}, {5, 11, 1, 1, 5, 1, 1, 0, 0},
+        {5, 13, 1, 1, 1, 3, 11, 0, 0}, {5, 14, 1, 3, 5, 5, 31, 0, 0},
+        {6, 1, 1, 3, 3, 9, 7, 49, 0}, {6, 13, 1, 1, 1, 15, 21, 21, 0},
+        {6, 16, 1, 3, 1, 13, 27, 49, 0}, {6, 19, 1, 1, 1, 15, 7, 5, 0},
+        {6, 22, 1, 3, 1, 15, 13, 25, 0}, {6, 25, 1, 1, 5, 5, 19, 61, 0},
+        {7, 1, 1, 3, 7, 11, 23, 15, 103}, {7, 4, 1, 3, 7, 13, 13, 15, 69},
+        {7, 7, 1, 1, 3, 13, 7, 35, 63}, {7, 8, 1, 3, 5, 9, 1, 25, 53},
+        {7, 14, 1, 3, 1, 13, 9, 35, 107}, {7, 19, 1, 3, 1, 5, 27, 61, 31},
+        {7, 21, 1, 1, 5, 11, 19, 41, 61}, {7, 28, 1, 3, 5, 3, 3, 13, 69},
+        {7, 31, 1, 1, 7, 13, 1, 19, 1}, {7, 32, 1, 3, 7, 5, 13, 19, 59},
+        {7, 37, 1, 1, 3, 9, 25, 29, 41}, {7, 41, 1, 3, 5, 13, 23, 1, 55},
+        {7, 42, 1, 3, 7, 3, 13, 59, 17}};
+
+    return table[d - 1];
+}
+
+// The index of the lowest set bit, u != 0
+template <typename UIntType>
+inline int sobol_ctz(UIntType u)
+{
+    int k = 0;
+    while ((u & 1) == 0) {
+        u >>= 1;
+        ++k;
+    }
+
+    return k;
+}
+
+template <typename UIntType>
+inline UIntType sobol_parity(UIntType u)
+{
+    static constexpr int W = std::numeric_limits<UIntType>::digits;
+
+    for (int s = W / 2; s > 0; s /= 2)
+        u ^= u >> s;
+
+    return u & 1;
+}
+
+} // namespace mckl::internal
+
+/// \brief Sobol quasi random sequence with optional scrambling
+/// \ingroup Random
+///
+/// \details
+/// The engine generates the points of a `dim()` dimensional Sobol sequence,
+/// using the direction numbers of Joe and Kuo (2008), in Gray code order.
+/// Each call of `operator()` returns the next coordinate of the current
+/// point, as an integer whose \f$W\f$ bits are the first \f$W\f$ binary
+/// digits of the coordinate. Thus the engine can be used in place of a
+/// pseudo random engine with any distribution, such as `U01Distribution`,
+/// and at most \f$2^W\f$ points are generated before the sequence repeats.
+/// The first point is always the origin, unless the sequence is scrambled.
+///
+/// The sequence can be randomized by `scramble(rng)` or `seed(s)`, which
+/// apply a random linear matrix scrambling followed by a random digital shift
+/// to each dimension (Matousek, 1998). This is an affine approximation of
+/// Owen's nested scrambling. Each point of the scrambled sequence is uniform
+/// on the unit cube, and each block of \f$2^m\f$ points starting at index
+/// \f$k2^m\f$ is still a \f$(t,m,s)\f$-net. The scrambling is applied to the
+/// direction numbers, and thus has no cost during the generation.
+///
+/// The method `index(k)` moves the engine to the \f$k\f$-th point with a
+/// cost of \f$O(W\cdot\mathrm{dim()})\f$. Parallel blocks of points can be
+/// generated by engines that share the same scrambling and start at
+/// different indices.
+template <typename UIntType>
+class SobolEngine
+{
+    static_assert(std::is_unsigned<UIntType>::value,
+        "**SobolEngine** used with UIntType other than unsigned integer "
+        "types");
+
+    static_assert(std::numeric_limits<UIntType>::digits >= 32,
+        "**SobolEngine** used with UIntType smaller than 32 bits");
+
+    public:
+    using result_type = UIntType;
+    using skip_type = UIntType;
+
+    /// \brief Unscrambled sequence of a given dimension
+    explicit SobolEngine(std::size_t dim = 1)
+        : dim_(dim), index_(0), coord_(0)
+    {
+        runtime_assert(dim >= 1 && dim <= max_dim(),
+            "**SobolEngine** dimension not supported");
+
+        shift_.resize(dim_);
+        reset();
+    }
+
+    /// \brief Scrambled sequence of a given dimension
+    SobolEngine(std::size_t dim, result_type s) : SobolEngine(dim) { seed(s); }
+
+    /// \brief The maximum dimension supported
+    static constexpr std::size_t max_dim() { return 32; }
+
+    /// \brief The dimension of the sequence
+    std::size_t dim() const { return dim_; }
+
+    /// \brief The index of the current point
+    result_type index() const { return index_; }
+
+    /// \brief Move to the beginning of the `k`-th point
+    void index(result_type k)
+    {
+        const result_type g = k ^ (k >> 1);
+        index_ = k;
+        coord_ = 0;
+        x_ = shift_;
+        for (std::size_t i = 0; i != W_; ++i) {
+            if (((g >> i) & 1) != 0) {
+                const result_type *v = v_.data() + i * dim_;
+                for (std::size_t d = 0; d != dim_; ++d)
+                    x_[d] ^= v[d];
+            }
+        }
+    }
+
+    /// \brief Remove the scrambling, and move to the first point
+    void reset()
+    {
+        init();
+        std::fill(shift_.begin(), shift_.end(), 0);
+        index(0);
+    }
+
+    /// \brief Scramble the sequence with a seed, and move to the first point
+    void seed(result_type s)
+    {
+        Threefry4x64Engine<result_type> rng(s);
+        scramble(rng);
+    }
+
+    /// \brief Scramble the sequence with random bits generated by `rng`, and
+    /// move to the first point
+    template <typename RNGType>
+    void scramble(RNGType &rng)
+    {
+        UniformBitsDistribution<result_type> ubits;
+        std::array<result_type, W_> lms;
+        init();
+        for (std::size_t d = 0; d != dim_; ++d) {
+            for (std::size_t r = 0; r != W_; ++r) {
+                const std::size_t p = W_ - 1 - r;
+                const result_type b = const_one<result_type>() << p;
+                lms[r] = (ubits(rng) & ~(b + (b - 1))) | b;
+            }
+            for (std::size_t i = 0; i != W_; ++i) {
+                const result_type v = v_[i * dim_ + d];
+                result_type y = 0;
+                for (std::size_t r = 0; r != W_; ++r)
+                    y |= internal::sobol_parity(lms[r] & v) << (W_ - 1 - r);
+                v_[i * dim_ + d] = y;
+            }
+            shift_[d] = ubits(rng);
+        }
+        index(0);
+    }
+
+    result_type operator()()
+    {
+        const result_type u = x_[coord_++];
+        if (coord_ == dim_)
+            next();
+
+        return u;
+    }
+
+    /// \brief Generate `n` coordinates, with a cost of \f$O(1)\f$ for each
+    void operator()(std::size_t n, result_type *r)
+    {
+        while (n != 0 && coord_ != 0) {
+            *r++ = operator()();
+            --n;
+        }
+
+        const std::size_t m = n / dim_;
+        if (dim_ == 1) {
+            static constexpr result_type h = const_one<result_type>()
+                << (W_ - 1);
+            result_type x = x_[0];
+            result_type k = index_;
+            for (std::size_t i = 0; i != m; ++i) {
+                r[i] = x;
+                x ^= v_[static_cast<std::size_t>(internal::sobol_ctz(++k | h))];
+            }
+            x_[0] = x;
+            index_ = k;
+        } else {
+            for (std::size_t i = 0; i != m; ++i) {
+                std::copy_n(x_.data(), dim_, r + i * dim_);
+                next();
+            }
+        }
+        r += m * dim_;
+        n -= m * dim_;
+
+        for (std::size_t i = 0; i != n; ++i)
+            r[i] = x_[coord_++];
+    }
+
+    /// \brief Skip `nskip` coordinates
+    void discard(skip_type nskip)
+    {
+        const skip_type d = static_cast<skip_type>(dim_);
+        const skip_type c = static_cast<skip_type>(coord_) + nskip % d;
+        index(static_cast<result_type>(index_ + nskip / d + c / d));
+        coord_ = static_cast<std::size_t>(c % d);
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    friend bool operator==(const SobolEngine<UIntType> &eng1,
+        const SobolEngine<UIntType> &eng2)
+    {
+        return eng1.dim_ == eng2.dim_ && eng1.index_ == eng2.index_ &&
+            eng1.coord_ == eng2.coord_ && eng1.x_ == eng2.x_ &&
+            eng1.v_ == eng2.v_ && eng1.shift_ == eng2.shift_;
+    }
+
+    friend bool operator!=(const SobolEngine<UIntType> &eng1,
+        const SobolEngine<UIntType> &eng2)
+    {
+        return !(eng1 == eng2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const SobolEngine<UIntType> &eng)
+    {
+        if (!os)
+            return os;
+
+        os << eng.dim_ << ' ';
+        os << eng.index_ << ' ';
+        os << eng.coord_ << ' ';
+        os << eng.x_ << ' ';
+        os << eng.v_ << ' ';
+        os << eng.shift_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, SobolEngine<UIntType> &eng)
+    {
+        if (!is)
+            return is;
+
+        SobolEngine<UIntType> eng_tmp;
+        is >> std::ws >> eng_tmp.dim_;
+        is >> std::ws >> eng_tmp.index_;
+        is >> std::ws >> eng_tmp.coord_;
+        is >> std::ws >> eng_tmp.x_;
+        is >> std::ws >> eng_tmp.v_;
+        is >> std::ws >> eng_tmp.shift_;
+
+        if (is)
+            eng = std::move(eng_tmp);
+
+        return is;
+    }
+
+    private:
+    static constexpr std::size_t W_ = std::numeric_limits<UIntType>::digits;
+
+    std::size_t dim_;
+    result_type index_;
+    std::size_t coord_;
+    Vector<result_type> x_;
+    Vector<result_type> v_;
+    Vector<result_type> shift_;
+
+    // Direction numbers of the unscrambled sequence, v_[i * dim_ + d] is the
+    // i-th direction number of the d-th dimension
+    void init()
+    {
+        v_.resize(W_ * dim_);
+        for (std::size_t i = 0; i != W_; ++i)
+            v_[i * dim_] = const_one<result_type>() << (W_ - 1 - i);
+
+        for (std::size_t d = 1; d < dim_; ++d) {
+            const unsigned *t = internal::sobol_direction_table(d);
+            const std::size_t s = t[0];
+            const unsigned a = t[1];
+            for (std::size_t i = 0; i != s; ++i) {
+                v_[i * dim_ + d] = static_cast<result_type>(t[i + 2])
+                    << (W_ - 1 - i);
+            }
+            for (std::size_t i = s; i < W_; ++i) {
+                result_type v = v_[(i - s) * dim_ + d];
+                v ^= v >> s;
+                for (std::size_t j = 1; j < s; ++j) {
+                    if (((a >> (s - 1 - j)) & 1) != 0)
+                        v ^= v_[(i - j) * dim_ + d];
+                }
+                v_[i * dim_ + d] = v;
+            }
+        }
+    }
+
+    // Move to the next point in Gray code order
+    void next()
+    {
+        static constexpr result_type h = const_one<result_type>() << (W_ - 1);
+
+        coord_ = 0;
+        const std::size_t i =
+            static_cast<std::size_t>(internal::sobol_ctz(++index_ | h));
+        const result_type *v = v_.data() + i * dim_;
+        for (std::size_t d = 0; d != dim_; ++d)
+            x_[d] ^= v[d];
+    }
+}; // class SobolEngine
+
+/// \brief Sobol sequence with 32-bit output
+/// \ingroup Random
+using Sobol32 = SobolEngine<std::uint32_t>;
+
+/// \brief Sobol sequence with 64-bit output
+/// \ingroup Random
+using Sobol64 = SobolEngine<std::uint64_t>;
+
+template <typename UIntType>
+inline void rand(SobolEngine<UIntType> &rng, std::size_t n, UIntType *r)
+{
+    rng(n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_SOBOL_HPP
@@ -0,0 +1,251 @@
+//============================================================================
+// MCKL/include/mckl/random/stream_tree.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_STREAM_TREE_HPP
+#define MCKL_RANDOM_STREAM_TREE_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/counter.hpp>
+
+namespace mckl
+{
+
+namespace internal
+{
+
+template <typename T, std::size_t K>
+inline void stream_tree_set_bits(
+    std::array<T, K> &ctr, unsigned pos, unsigned b, std::uintmax_t v)
+{
+    static constexpr unsigned W = std::numeric_limits<T>::digits;
+    static constexpr unsigned U = std::numeric_limits<std::uintmax_t>::digits;
+
+    while (b != 0) {
+        const unsigned s = pos % W;
+        const unsigned n = std::min(b, W - s);
+        const std::uintmax_t mask =
+            n < U ? (UINTMAX_C(1) << n) - 1 : ~UINTMAX_C(0);
+        ctr[pos / W] |= static_cast<T>((v & mask) << s);
+        v = n < U ? v >> n : 0;
+        pos += n;
+        b -= n;
+    }
+}
+
+} // namespace mckl::internal
+
+/// \brief Hierarchical partition of the counter space of a counter-based
+/// engine
+/// \ingroup Random
+///
+/// \details
+/// A node owns the counters whose low `bits()` bits are free and whose high
+/// bits are equal to those of `ctr()`, all under the same `key()`. The root
+/// owns the whole counter space of its key. The method `child(i, b)` splits
+/// the node into \f$2^b\f$ children and returns the `i`-th, which owns the
+/// counters with the next `b` bits, counted from the most significant end of
+/// the free bits, equal to `i`. For example,
+/// ~~~{.cpp}
+/// StreamTree<Philox4x32> root(key);
+/// auto proc = root.child(process_id, 16);
+/// auto smp = proc.child(sampler_id, 8);
+/// Philox4x32 rng = smp.child(stream_id, 32).engine();
+/// ~~~
+/// As long as siblings are created with the same number of bits, distinct
+/// paths own disjoint sets of counters, and an engine created from a node
+/// produces \f$2^{\mathrm{bits()}} - 1\f$ blocks of random numbers before it
+/// reaches the counters of another node.
+///
+/// `RNGType` shall be a counter-based engine, such as `Philox4x32`,
+/// `Threefry4x64` or `ARS`. The partition is purely a function of the key and
+/// the path and requires no communication between processes or threads.
+template <typename RNGType>
+class StreamTree
+{
+    public:
+    using rng_type = RNGType;
+    using ctr_type = typename rng_type::ctr_type;
+    using key_type = typename rng_type::key_type;
+
+    /// \brief The root owning all the counters of a zero key
+    StreamTree() : bits_(max_bits())
+    {
+        std::memset(key_.data(), 0, sizeof(key_type));
+        ctr_.fill(0);
+    }
+
+    /// \brief The root owning all the counters of a given key
+    explicit StreamTree(const key_type &key) : key_(key), bits_(max_bits())
+    {
+        ctr_.fill(0);
+    }
+
+    /// \brief The total number of bits of the counter
+    static constexpr unsigned max_bits()
+    {
+        return static_cast<unsigned>(
+            std::numeric_limits<typename ctr_type::value_type>::digits *
+            std::tuple_size<ctr_type>::value);
+    }
+
+    /// \brief The number of free low bits of the counter owned by this node
+    unsigned bits() const { return bits_; }
+
+    /// \brief The key of this node
+    const key_type &key() const { return key_; }
+
+    /// \brief The first counter owned by this node
+    const ctr_type &ctr() const { return ctr_; }
+
+    /// \brief The `i`-th of the \f$2^b\f$ children of this node
+    StreamTree<RNGType> child(std::uintmax_t i, unsigned b) const
+    {
+        runtime_assert(b <= bits_,
+            "**StreamTree::child** the number of bits is larger than the "
+            "free bits of the node");
+        runtime_assert(
+            b >= std::numeric_limits<std::uintmax_t>::digits || (i >> b) == 0,
+            "**StreamTree::child** the index is not smaller than the number "
+            "of children");
+
+        StreamTree<RNGType> node(*this);
+        node.bits_ -= b;
+        internal::stream_tree_set_bits(node.ctr_, node.bits_, b, i);
+
+        return node;
+    }
+
+    /// \brief Set the engine to the beginning of the stream of this node
+    void seed(rng_type &rng) const
+    {
+        rng.seed(key_);
+        rng.ctr(ctr_);
+    }
+
+    /// \brief Create an engine at the beginning of the stream of this node
+    rng_type engine() const
+    {
+        rng_type rng;
+        seed(rng);
+
+        return rng;
+    }
+
+    friend bool operator==(
+        const StreamTree<RNGType> &node1, const StreamTree<RNGType> &node2)
+    {
+        return node1.key_ == node2.key_ && node1.ctr_ == node2.ctr_ &&
+            node1.bits_ == node2.bits_;
+    }
+
+    friend bool operator!=(
+        const StreamTree<RNGType> &node1, const StreamTree<RNGType> &node2)
+    {
+        return !(node1 == node2);
+    }
+
+    private:
+    key_type key_;
+    ctr_type ctr_;
+    unsigned bits_;
+}; // class StreamTree
+
+/// \brief Thread-safe seeding of engines with the children of a StreamTree
+/// node
+/// \ingroup Random
+///
+/// \details
+/// Each call of `operator()` seeds engines with the next children of the
+/// node, each with `bits` bits, obtained with a single lock-free atomic
+/// increment. Unlike `SeedGenerator`, the streams of the engines seeded are
+/// guaranteed to be disjoint, both among themselves and with those seeded
+/// by other `StreamSeed` objects constructed from distinct nodes.
+template <typename RNGType>
+class StreamSeed
+{
+    public:
+    using rng_type = RNGType;
+    using node_type = StreamTree<RNGType>;
+
+    StreamSeed(const node_type &node, unsigned bits)
+        : node_(node), bits_(bits), next_(0)
+    {
+        runtime_assert(bits <= node.bits(),
+            "**StreamSeed** the number of bits is larger than the free bits "
+            "of the node");
+    }
+
+    StreamSeed(const StreamSeed<RNGType> &) = delete;
+
+    StreamSeed<RNGType> &operator=(const StreamSeed<RNGType> &) = delete;
+
+    /// \brief The node whose children are used
+    const node_type &node() const { return node_; }
+
+    /// \brief The number of bits of each child
+    unsigned bits() const { return bits_; }
+
+    /// \brief Reserve `n` consecutive children and return the index of the
+    /// first
+    std::uintmax_t get(std::uintmax_t n = 1)
+    {
+        const std::uintmax_t i = next_.fetch_add(n);
+        runtime_assert(n == 0 ||
+                bits_ >= std::numeric_limits<std::uintmax_t>::digits ||
+                ((i + n - 1) >> bits_) == 0,
+            "**StreamSeed::get** all children of the node are used");
+
+        return i;
+    }
+
+    /// \brief Seed a single engine
+    void operator()(rng_type &rng) { node_.child(get(), bits_).seed(rng); }
+
+    /// \brief Seed a sequence of engines
+    template <typename OutputIter>
+    OutputIter operator()(std::size_t n, OutputIter first)
+    {
+        const std::uintmax_t i = get(n);
+        for (std::size_t j = 0; j != n; ++j, ++first)
+            node_.child(i + j, bits_).seed(*first);
+
+        return first;
+    }
+
+    private:
+    node_type node_;
+    unsigned bits_;
+    std::atomic<std::uintmax_t> next_;
+}; // class StreamSeed
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_STREAM_TREE_HPP
@@ -35,6 +35,19 @@
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/counter.hpp>
 
+#if MCKL_HAS_AVX2 || MCKL_HAS_AVX512F
+#include <immintrin.h>
+#elif MCKL_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+#endif
+
 #define MCKL_DEFINE_RANDOM_THREEFRY_PARITY_CONSTANT(W, val)                   \
     template <typename T>                                                     \
     class ThreefryParityConstant<T, W>                                        \
@@ -432,6 +445,406 @@ class ThreefryPBox<T, 8, N, true>
     }
 }; // class ThreefryPBox
 
+#if MCKL_HAS_SSE2
+
+#if MCKL_HAS_AVX512F
+using ThreefrySIMDType = __m512i;
+#elif MCKL_HAS_AVX2
+using ThreefrySIMDType = __m256i;
+#else
+using ThreefrySIMDType = __m128i;
+#endif
+
+template <int>
+class ThreefrySIMDOps;
+
+template <>
+class ThreefrySIMDOps<32>
+{
+    public:
+    static void set1(std::uint32_t a, __m128i &v)
+    {
+        v = _mm_set1_epi32(static_cast<int>(a));
+    }
+
+    static __m128i add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+
+    static __m128i bxor(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+
+    template <int L>
+    static __m128i rotl(__m128i a)
+    {
+        return _mm_or_si128(_mm_slli_epi32(a, L), _mm_srli_epi32(a, 32 - L));
+    }
+
+    static void interleave(__m128i a, __m128i b, __m128i &lo, __m128i &hi)
+    {
+        lo = _mm_unpacklo_epi32(a, b);
+        hi = _mm_unpackhi_epi32(a, b);
+    }
+
+#if MCKL_HAS_AVX2
+    static void set1(std::uint32_t a, __m256i &v)
+    {
+        v = _mm256_set1_epi32(static_cast<int>(a));
+    }
+
+    static __m256i add(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi32(a, b);
+    }
+
+    static __m256i bxor(__m256i a, __m256i b)
+    {
+        return _mm256_xor_si256(a, b);
+    }
+
+    template <int L>
+    static __m256i rotl(__m256i a)
+    {
+        return _mm256_or_si256(
+            _mm256_slli_epi32(a, L), _mm256_srli_epi32(a, 32 - L));
+    }
+
+    static void interleave(__m256i a, __m256i b, __m256i &lo, __m256i &hi)
+    {
+        const __m256i l = _mm256_unpacklo_epi32(a, b);
+        const __m256i h = _mm256_unpackhi_epi32(a, b);
+        lo = _mm256_permute2x128_si256(l, h, 0x20);
+        hi = _mm256_permute2x128_si256(l, h, 0x31);
+    }
+#endif // MCKL_HAS_AVX2
+
+#if MCKL_HAS_AVX512F
+    static void set1(std::uint32_t a, __m512i &v)
+    {
+        v = _mm512_set1_epi32(static_cast<int>(a));
+    }
+
+    static __m512i add(__m512i a, __m512i b)
+    {
+        return _mm512_add_epi32(a, b);
+    }
+
+    static __m512i bxor(__m512i a, __m512i b)
+    {
+        return _mm512_xor_si512(a, b);
+    }
+
+    // The zero-masking form avoids the uninitialized pass-through operand of
+    // the unmasked one in GCC 12
+    template <int L>
+    static __m512i rotl(__m512i a)
+    {
+        return _mm512_maskz_rol_epi32(0xFFFF, a, L);
+    }
+
+    static void interleave(__m512i a, __m512i b, __m512i &lo, __m512i &hi)
+    {
+        lo = _mm512_permutex2var_epi32(a,
+            _mm512_set_epi32(
+                23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0),
+            b);
+        hi = _mm512_permutex2var_epi32(a,
+            _mm512_set_epi32(
+                31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8),
+            b);
+    }
+#endif // MCKL_HAS_AVX512F
+}; // class ThreefrySIMDOps
+
+template <>
+class ThreefrySIMDOps<64>
+{
+    public:
+    static void set1(std::uint64_t a, __m128i &v)
+    {
+        v = _mm_set1_epi64x(static_cast<long long>(a));
+    }
+
+    static __m128i add(__m128i a, __m128i b) { return _mm_add_epi64(a, b); }
+
+    static __m128i bxor(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+
+    template <int L>
+    static __m128i rotl(__m128i a)
+    {
+        return _mm_or_si128(_mm_slli_epi64(a, L), _mm_srli_epi64(a, 64 - L));
+    }
+
+    static void interleave(__m128i a, __m128i b, __m128i &lo, __m128i &hi)
+    {
+        lo = _mm_unpacklo_epi64(a, b);
+        hi = _mm_unpackhi_epi64(a, b);
+    }
+
+#if MCKL_HAS_AVX2
+    static void set1(std::uint64_t a, __m256i &v)
+    {
+        v = _mm256_set1_epi64x(static_cast<long long>(a));
+    }
+
+    static __m256i add(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi64(a, b);
+    }
+
+    static __m256i bxor(__m256i a, __m256i b)
+    {
+        return _mm256_xor_si256(a, b);
+    }
+
+    template <int L>
+    static __m256i rotl(__m256i a)
+    {
+        return _mm256_or_si256(
+            _mm256_slli_epi64(a, L), _mm256_srli_epi64(a, 64 - L));
+    }
+
+    static void interleave(__m256i a, __m256i b, __m256i &lo, __m256i &hi)
+    {
+        const __m256i l = _mm256_unpacklo_epi64(a, b);
+        const __m256i h = _mm256_unpackhi_epi64(a, b);
+        lo = _mm256_permute2x128_si256(l, h, 0x20);
+        hi = _mm256_permute2x128_si256(l, h, 0x31);
+    }
+#endif // MCKL_HAS_AVX2
+
+#if MCKL_HAS_AVX512F
+    static void set1(std::uint64_t a, __m512i &v)
+    {
+        v = _mm512_set1_epi64(static_cast<long long>(a));
+    }
+
+    static __m512i add(__m512i a, __m512i b)
+    {
+        return _mm512_add_epi64(a, b);
+    }
+
+    static __m512i bxor(__m512i a, __m512i b)
+    {
+        return _mm512_xor_si512(a, b);
+    }
+
+    template <int L>
+    static __m512i rotl(__m512i a)
+    {
+        return _mm512_maskz_rol_epi64(0xFF, a, L);
+    }
+
+    static void interleave(__m512i a, __m512i b, __m512i &lo, __m512i &hi)
+    {
+        lo = _mm512_permutex2var_epi64(
+            a, _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), b);
+        hi = _mm512_permutex2var_epi64(
+            a, _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4), b);
+    }
+#endif // MCKL_HAS_AVX512F
+}; // class ThreefrySIMDOps
+
+#endif // MCKL_HAS_SSE2
+
+/// \brief Generate multiple blocks with SIMD instructions
+///
+/// \details
+/// The generic version does nothing and returns zero, the number of blocks
+/// generated. The caller generates the remaining blocks.
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants,
+    bool = (MCKL_HAS_SSE2 && (std::numeric_limits<T>::digits == 32 ||
+                                 std::numeric_limits<T>::digits == 64))>
+class ThreefryGeneratorSIMD
+{
+    public:
+    static std::size_t eval(std::array<T, K> &, std::size_t, void *,
+        const std::array<T, K + 1> &)
+    {
+        return 0;
+    }
+}; // class ThreefryGeneratorSIMD
+
+#if MCKL_HAS_SSE2
+
+/// \brief Generate multiple Threefry blocks with SIMD instructions
+///
+/// \details
+/// The I-th word of a group of blocks are kept in the lanes of the I-th
+/// register. The SBox, PBox and key insertion are then the same as the scalar
+/// implementation with each word replaced by a register, and the PBox is only
+/// a renaming of registers. Several groups are processed together when `K` is
+/// small, to have enough independent instructions in each round. The counters
+/// are constructed in the same layout, and the results are transposed back to
+/// the usual layout by repeatedly interleaving the first and second halves of
+/// the registers. The results are identical to the scalar implementation.
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
+class ThreefryGeneratorSIMD<T, K, Rounds, Constants, true>
+{
+    using ops = ThreefrySIMDOps<std::numeric_limits<T>::digits>;
+    using state_type = std::array<ThreefrySIMDType, K>;
+
+    static constexpr std::size_t L_ = sizeof(ThreefrySIMDType) / sizeof(T);
+    static constexpr std::size_t G_ = K < 8 ? 8 / K : 1;
+    static constexpr std::size_t Blocks_ = L_ * G_;
+
+    public:
+    static std::size_t eval(std::array<T, K> &ctr, std::size_t n,
+        void *buffer, const std::array<T, K + 1> &par)
+    {
+        union {
+            std::array<state_type, G_> state;
+            std::array<T, K * Blocks_> word;
+        } buf;
+
+        std::array<ThreefrySIMDType, K + 1> p;
+        for (std::size_t i = 0; i != K + 1; ++i)
+            ops::set1(par[i], p[i]);
+
+        for (std::size_t g = 0; g != G_; ++g)
+            for (std::size_t l = 0; l != L_; ++l)
+                buf.word[g * K * L_ + l] = static_cast<T>(g * L_ + l + 1);
+        std::array<ThreefrySIMDType, G_> offset;
+        for (std::size_t g = 0; g != G_; ++g)
+            offset[g] = std::get<0>(buf.state[g]);
+
+        const std::size_t m = n / Blocks_;
+        char *b = static_cast<char *>(buffer);
+        for (std::size_t i = 0; i != m; ++i, b += sizeof(buf)) {
+            std::array<state_type, G_> s;
+            if (ctr.front() <=
+                std::numeric_limits<T>::max() - static_cast<T>(Blocks_)) {
+                std::array<ThreefrySIMDType, K> c;
+                for (std::size_t k = 0; k != K; ++k)
+                    ops::set1(ctr[k], c[k]);
+                for (std::size_t g = 0; g != G_; ++g) {
+                    s[g] = c;
+                    std::get<0>(s[g]) = ops::add(std::get<0>(c), offset[g]);
+                }
+                ctr.front() += static_cast<T>(Blocks_);
+            } else {
+                std::array<std::array<T, K>, Blocks_> ctr_block;
+                increment(ctr, ctr_block);
+                for (std::size_t j = 0; j != Blocks_; ++j)
+                    for (std::size_t k = 0; k != K; ++k)
+                        buf.word[transpose(j, k)] = ctr_block[j][k];
+                s = buf.state;
+            }
+            generate<0>(s, p, std::true_type());
+            for (std::size_t g = 0; g != G_; ++g) {
+                for (std::size_t k = 1; k < K; k *= 2) {
+                    const state_type t(s[g]);
+                    for (std::size_t j = 0; j != K / 2; ++j) {
+                        ops::interleave(t[j], t[j + K / 2], s[g][j * 2],
+                            s[g][j * 2 + 1]);
+                    }
+                }
+            }
+            std::memcpy(b, s.data(), sizeof(buf));
+        }
+
+        return m * Blocks_;
+    }
+
+    private:
+    template <std::size_t N, std::size_t I>
+    using rotate = typename Constants::template rotate<(N - 1) % 8, I>;
+
+    /// \brief Position of the k-th word of the j-th block in the registers
+    static constexpr std::size_t transpose(std::size_t j, std::size_t k)
+    {
+        return (j / L_ * K + k) * L_ + j % L_;
+    }
+
+    template <std::size_t>
+    static void generate(std::array<state_type, G_> &,
+        const std::array<ThreefrySIMDType, K + 1> &, std::false_type)
+    {
+    }
+
+    template <std::size_t N>
+    static void generate(std::array<state_type, G_> &s,
+        const std::array<ThreefrySIMDType, K + 1> &p, std::true_type)
+    {
+        for (std::size_t g = 0; g != G_; ++g) {
+            sbox<N, 0>(s[g], std::integral_constant<bool, (N > 0)>());
+            pbox<N>(s[g], std::integral_constant<bool, (N > 0)>());
+            insert_key<N>(
+                s[g], p, std::integral_constant<bool, N % 4 == 0>());
+        }
+        generate<N + 1>(s, p, std::integral_constant<bool, (N < Rounds)>());
+    }
+
+    template <std::size_t, std::size_t>
+    static void sbox(state_type &, std::false_type)
+    {
+    }
+
+    template <std::size_t N, std::size_t I>
+    static void sbox(state_type &s, std::true_type)
+    {
+        const ThreefrySIMDType x = std::get<I + 1>(s);
+        std::get<I>(s) = ops::add(std::get<I>(s), x);
+        std::get<I + 1>(s) = ops::bxor(
+            ops::template rotl<rotate<N, I / 2>::value>(x), std::get<I>(s));
+        sbox<N, I + 2>(s, std::integral_constant<bool, I + 3 < K>());
+    }
+
+    template <std::size_t>
+    static void pbox(state_type &, std::false_type)
+    {
+    }
+
+    template <std::size_t N>
+    static void pbox(state_type &s, std::true_type)
+    {
+        const state_type t(s);
+        pbox<0>(s, t, std::true_type());
+    }
+
+    template <std::size_t>
+    static void pbox(state_type &, const state_type &, std::false_type)
+    {
+    }
+
+    template <std::size_t I>
+    static void pbox(state_type &s, const state_type &t, std::true_type)
+    {
+        std::get<I>(s) = std::get<ThreefryPermuteConstant<K, I>::value>(t);
+        pbox<I + 1>(s, t, std::integral_constant<bool, I + 1 < K>());
+    }
+
+    template <std::size_t>
+    static void insert_key(state_type &,
+        const std::array<ThreefrySIMDType, K + 1> &, std::false_type)
+    {
+    }
+
+    template <std::size_t N>
+    static void insert_key(state_type &s,
+        const std::array<ThreefrySIMDType, K + 1> &p, std::true_type)
+    {
+        insert_key<N, 0>(s, p, std::true_type());
+        ThreefrySIMDType v;
+        ops::set1(static_cast<T>(N / 4), v);
+        s.back() = ops::add(s.back(), v);
+    }
+
+    template <std::size_t, std::size_t>
+    static void insert_key(state_type &,
+        const std::array<ThreefrySIMDType, K + 1> &, std::false_type)
+    {
+    }
+
+    template <std::size_t N, std::size_t I>
+    static void insert_key(state_type &s,
+        const std::array<ThreefrySIMDType, K + 1> &p, std::true_type)
+    {
+        std::get<I>(s) =
+            ops::add(std::get<I>(s), std::get<(N / 4 + I) % (K + 1)>(p));
+        insert_key<N, I + 1>(s, p, std::integral_constant<bool, I + 1 < K>());
+    }
+}; // class ThreefryGeneratorSIMD
+
+#endif // MCKL_HAS_SSE2
+
 } // namespace mckl::internal
 
 /// \brief Threefry RNG generator
@@ -502,7 +915,10 @@ class ThreefryGenerator
             std::array<ResultType, size() / sizeof(ResultType)> result;
         } buf;
 
-        for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t m =
+            internal::ThreefryGeneratorSIMD<T, K, Rounds, Constants>::eval(
+                ctr, n, buffer, par_);
+        for (std::size_t i = m; i != n; ++i) {
             increment(ctr);
             buf.ctr = ctr;
             generate<0>(buf.state, par_, std::true_type());
@@ -671,4 +1087,10 @@ using Threefry_64 = Threefry4x64Engine<std::uint64_t>;
 
 } // namespace mckl
 
+#ifdef MCKL_GCC
+#if __GNUC__ >= 6
+#pragma GCC diagnostic pop
+#endif
+#endif
+
 #endif // MCKL_RANDOM_THREEFRY_HPP
@@ -34,6 +34,7 @@
 
 #include <mckl/internal/config.h>
 #include <mckl/resample/algorithm.hpp>
+#include <mckl/resample/genealogy.hpp>
 #include <mckl/resample/index.hpp>
 #include <mckl/resample/transform.hpp>
 #include <mckl/resample/u01_sequence.hpp>
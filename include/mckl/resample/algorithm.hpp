@@ -39,13 +39,68 @@
 namespace mckl
 {
 
+/// \brief Temporary storage of resampling algorithms
+/// \ingroup Resample
+///
+/// \details
+/// Each buffer grows to the largest size requested and is reused by
+/// subsequent calls, such that no memory is allocated once all have grown. A
+/// workspace shall not be used by multiple threads concurrently, while
+/// distinct workspaces can be used with the same algorithm object.
+class ResampleWorkspace
+{
+    public:
+    /// \brief Get the `k`-th buffer with space for at least `n` objects of
+    /// type `T`
+    template <typename T>
+    T *get(std::size_t k, std::size_t n)
+    {
+        static_assert(std::is_trivial<T>::value,
+            "**ResampleWorkspace::get** used with T other than trivial types");
+
+        if (buffer_.size() <= k)
+            buffer_.resize(k + 1);
+        Vector<unsigned char> &buffer = buffer_[k];
+        if (buffer.size() < n * sizeof(T))
+            buffer.resize(n * sizeof(T));
+
+        return reinterpret_cast<T *>(buffer.data());
+    }
+
+    private:
+    Vector<Vector<unsigned char>> buffer_;
+}; // class ResampleWorkspace
+
+namespace internal
+{
+
+template <typename StateType, typename SizeType>
+inline auto resample_select_rep(StateType &state, std::size_t, std::size_t M,
+    const SizeType *rep, ResampleWorkspace &, int)
+    -> decltype(state.select_rep(M, rep), void())
+{
+    state.select_rep(M, rep);
+}
+
+template <typename StateType, typename SizeType>
+inline void resample_select_rep(StateType &state, std::size_t N,
+    std::size_t M, const SizeType *rep, ResampleWorkspace &workspace, long)
+{
+    SizeType *const idx = workspace.get<SizeType>(1, M);
+    resample_trans_rep_index(N, M, rep, idx);
+    state.select(M, idx);
+}
+
+} // namespace internal
+
 /// \brief Sampler<T>::eval_type subtype
 template <typename T>
 class ResampleEval
 {
     public:
     using eval_type = std::function<void(std::size_t, std::size_t,
-        typename Particle<T>::rng_type &, const double *,
+        typename Particle<T>::rng_type &,
+        decltype(std::declval<const Particle<T> &>().weight().data()),
         typename Particle<T>::size_type *)>;
 
     /// \brief Construct a `Sampler::move_type` object
@@ -57,8 +112,20 @@ class ResampleEval
     /// \brief Set a new evaluation object of type eval_type
     void eval(const eval_type &new_eval) { eval_ = new_eval; }
 
-    /// \brief Returns how many particles having non-zero replication number
-    void operator()(std::size_t, Particle<T> &particle) const
+    /// \brief Resample the particle system
+    ///
+    /// \details
+    /// If the state has a member function `select_rep`, such as StateMatrix,
+    /// it is called with the replication numbers, which are transformed into
+    /// parent indices a block at a time while the samples are copied.
+    /// Otherwise the parent indices are computed and passed to `select`. The
+    /// replication numbers and parent indices are stored in a workspace owned
+    /// by this object, and reused by subsequent calls. The evaluation object
+    /// is called through a non-`const` reference, such that a
+    /// ResampleAlgorithm also reuses its own storage. Thus, like other
+    /// non-`const` member functions, it shall not be called concurrently on
+    /// the same object.
+    void operator()(std::size_t, Particle<T> &particle)
     {
         runtime_assert(static_cast<bool>(eval_),
             "**ResampleEval::operator()** invalid evaluation object");
@@ -66,21 +133,37 @@ class ResampleEval
         using size_type = typename Particle<T>::size_type;
 
         const std::size_t N = static_cast<std::size_t>(particle.size());
-        Vector<size_type> rep(N);
-        Vector<size_type> idx(N);
-        eval_(N, N, particle.rng(), particle.weight().data(), rep.data());
-        resample_trans_rep_index(N, N, rep.data(), idx.data());
-        particle.state().select(N, idx.data());
+        size_type *const rep = workspace_.get<size_type>(0, N);
+        eval_(N, N, particle.rng(), particle.weight().data(), rep);
+        internal::resample_select_rep(
+            particle.state(), N, N, rep, workspace_, 0);
         particle.weight().set_equal();
     }
 
     private:
     eval_type eval_;
+    ResampleWorkspace workspace_;
 }; // class ResampleEval
 
 /// \brief Resampling algorithm
 /// \ingroup Resample
-template <typename U01SeqType, bool Residual>
+///
+/// \details
+/// The `const` overloads of `operator()` do not modify the object, and can be
+/// called concurrently by multiple threads. The temporary storage is either
+/// allocated by each call, or provided by the caller as a
+/// `ResampleWorkspace`, one for each thread. The non-`const` overload, which
+/// is used when the object is wrapped in a `ResampleEval` or `std::function`,
+/// reuses storage owned by the object, and like other non-`const` member
+/// functions it shall not be called concurrently on the same object.
+///
+/// With a parallel SMP backend `Backend`, the transformations from the
+/// weights to the replication numbers are performed in blocks of a fixed
+/// size. The results are bit-identical to the sequential transformations,
+/// which are used by the default `BackendSEQ`, regardless of the backend and
+/// the number of threads. The generation of the uniform sequence is
+/// sequential.
+template <typename U01SeqType, bool Residual, typename Backend = BackendSEQ>
 class ResampleAlgorithm
 {
     public:
@@ -91,45 +174,92 @@ class ResampleAlgorithm
     /// \param rng An RNG engine
     /// \param weight N-vector of normalized weights
     /// \param replication N-vector of replication numbers
-    template <typename RNGType, typename InputIter, typename OutputIter>
+    ///
+    /// \details
+    /// Both `weight` and `replication` shall be random access iterators.
+    template <typename RNGType, typename RandomIter, typename RandomIterO>
+    void operator()(std::size_t N, std::size_t M, RNGType &rng,
+        RandomIter weight, RandomIterO replication) const
+    {
+        ResampleWorkspace workspace;
+        eval(u01seq_, workspace, N, M, rng, weight, replication,
+            std::integral_constant<bool, Residual>());
+    }
+
+    /// \brief Generate replication numbers from normalized weights, using
+    /// temporary storage provided by the caller
+    template <typename RNGType, typename RandomIter, typename RandomIterO>
+    void operator()(std::size_t N, std::size_t M, RNGType &rng,
+        RandomIter weight, RandomIterO replication,
+        ResampleWorkspace &workspace) const
+    {
+        eval(u01seq_, workspace, N, M, rng, weight, replication,
+            std::integral_constant<bool, Residual>());
+    }
+
+    /// \brief Generate replication numbers from normalized weights, using
+    /// temporary storage owned by this object
+    template <typename RNGType, typename RandomIter, typename RandomIterO>
     void operator()(std::size_t N, std::size_t M, RNGType &rng,
-        InputIter weight, OutputIter replication) const
+        RandomIter weight, RandomIterO replication)
     {
-        eval(N, M, rng, weight, replication,
+        eval(u01seq_, workspace_, N, M, rng, weight, replication,
             std::integral_constant<bool, Residual>());
     }
 
     private:
     U01SeqType u01seq_;
+    ResampleWorkspace workspace_;
 
-    template <typename RNGType, typename InputIter, typename OutputIter>
-    void eval(std::size_t N, std::size_t M, RNGType &rng, InputIter weight,
-        OutputIter replication, std::false_type) const
+    template <typename U01Seq, typename RNGType, typename RandomIter,
+        typename RandomIterO>
+    static void eval(U01Seq &u01seq, ResampleWorkspace &workspace,
+        std::size_t N, std::size_t M, RNGType &rng, RandomIter weight,
+        RandomIterO replication, std::false_type)
     {
-        using real_type = typename std::iterator_traits<InputIter>::value_type;
+        using real_type =
+            typename std::iterator_traits<RandomIter>::value_type;
+        using acc_type = internal::ResampleAccType<real_type>;
 
-        Vector<real_type> u01(M);
-        u01seq_(rng, M, u01.data());
-        resample_trans_u01_rep(N, M, weight, u01.data(), replication);
+        real_type *const u01 = workspace.get<real_type>(0, M);
+        acc_type *const acc =
+            workspace.get<acc_type>(1, internal::resample_num_blocks(N) + 1);
+        u01seq(rng, M, u01);
+        internal::resample_trans_u01_rep<Backend>(
+            N, M, weight, u01, replication, acc);
     }
 
-    template <typename RNGType, typename InputIter, typename OutputIter>
-    void eval(std::size_t N, std::size_t M, RNGType &rng, InputIter weight,
-        OutputIter replication, std::true_type) const
+    template <typename U01Seq, typename RNGType, typename RandomIter,
+        typename RandomIterO>
+    static void eval(U01Seq &u01seq, ResampleWorkspace &workspace,
+        std::size_t N, std::size_t M, RNGType &rng, RandomIter weight,
+        RandomIterO replication, std::true_type)
     {
-        using real_type = typename std::iterator_traits<InputIter>::value_type;
-        using rep_type = typename std::iterator_traits<OutputIter>::value_type;
-
-        Vector<real_type> resid(N);
-        Vector<rep_type> integ(N);
-        std::size_t R =
-            resample_trans_residual(N, M, weight, resid.data(), integ.data());
-
-        Vector<real_type> u01(R);
-        u01seq_(rng, R, u01.data());
-        resample_trans_u01_rep(N, R, resid.data(), u01.data(), replication);
-        for (std::size_t i = 0; i != N; ++i, ++replication)
-            *replication += integ[i];
+        using real_type =
+            typename std::iterator_traits<RandomIter>::value_type;
+        using rep_type = typename std::iterator_traits<RandomIterO>::value_type;
+        using acc_type = internal::ResampleAccType<real_type>;
+
+        const std::size_t nb = internal::resample_num_blocks(N);
+        real_type *const resid = workspace.get<real_type>(2, N);
+        rep_type *const integ = workspace.get<rep_type>(3, N);
+        acc_type *const acc = workspace.get<acc_type>(1, nb + 1);
+        std::size_t *const sum_integ = workspace.get<std::size_t>(4, nb);
+        const std::size_t R = internal::resample_trans_residual<Backend>(
+            N, M, weight, resid, integ, sum_integ);
+
+        real_type *const u01 = workspace.get<real_type>(0, R);
+        u01seq(rng, R, u01);
+        internal::resample_trans_u01_rep<Backend>(
+            N, R, resid, u01, replication, acc);
+
+        const std::size_t k = internal::resample_block_size();
+        internal::BackendFor<Backend>::run(
+            nb, 1, [=](std::size_t b, std::size_t e) {
+                const std::size_t last = std::min(N, e * k);
+                for (std::size_t i = b * k; i != last; ++i)
+                    replication[i] += integ[i];
+            });
     }
 }; // class ResampleAlgorithm
 
@@ -145,6 +275,10 @@ using ResampleStratified = ResampleAlgorithm<U01SequenceStratified, false>;
 /// \ingroup Resample
 using ResampleSystematic = ResampleAlgorithm<U01SequenceSystematic, false>;
 
+/// \brief Randomized quasi Monte Carlo resampling with a Sobol sequence
+/// \ingroup Resample
+using ResampleSobol = ResampleAlgorithm<U01SequenceSobol, false>;
+
 /// \brief Residual resampling
 /// \ingroup Resample
 using ResampleResidual = ResampleAlgorithm<U01SequenceSorted, true>;
@@ -159,6 +293,11 @@ using ResampleResidualStratified =
 using ResampleResidualSystematic =
     ResampleAlgorithm<U01SequenceSystematic, true>;
 
+/// \brief Residual randomized quasi Monte Carlo resampling with a Sobol
+/// sequence
+/// \ingroup Resample
+using ResampleResidualSobol = ResampleAlgorithm<U01SequenceSobol, true>;
+
 } // namespace mckl
 
 #endif // MCKL_RESAMPLE_ALGORITHM_HPP
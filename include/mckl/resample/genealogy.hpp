@@ -0,0 +1,398 @@
+//============================================================================
+// MCKL/include/mckl/resample/genealogy.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RESAMPLE_GENEALOGY_HPP
+#define MCKL_RESAMPLE_GENEALOGY_HPP
+
+#include <mckl/internal/common.hpp>
+
+namespace mckl
+{
+
+/// \brief Record and trace resampling index with a pruned ancestry tree
+/// \ingroup Resample
+///
+/// \details
+/// This class has the same interface as ResampleIndex, but only the lineages
+/// of the particles at the last iteration are retained. Each node of the
+/// tree is a segment of a lineage starting at the iteration a particle was
+/// resampled. Iterations with an identity index do not create any nodes.
+/// Nodes without descendants are released as soon as their lineages die out,
+/// and once all lineages coalesce, the common ancestry is moved into a flat
+/// array with one index per iteration. The memory is thus \f$O(T + N\log N)\f$
+/// in practice, instead of \f$O(NT)\f$ for ResampleIndex, where \f$T\f$ is
+/// the number of iterations and \f$N\f$ is the sample size.
+///
+/// As a consequence, the argument `iter_back` of all trace back queries must
+/// be the last iteration.
+template <typename IntType = std::size_t>
+class ResampleGenealogy
+{
+    public:
+    using index_type = IntType;
+
+    ResampleGenealogy() : roots_(0), root_(npos()), compact_(0) {}
+
+    /// \brief Number of iterations recorded
+    std::size_t iter_size() const { return size_.size(); }
+
+    /// \brief The sample size of the last iteration
+    std::size_t size() const { return size_.size() == 0 ? 0 : size_.back(); }
+
+    /// \brief The sample size of a given iteration
+    std::size_t size(std::size_t iter) const
+    {
+        return iter < size_.size() ? size_[iter] : 0;
+    }
+
+    /// \brief Number of nodes in the ancestry tree
+    std::size_t node_size() const { return node_.size() - free_.size(); }
+
+    /// \brief Number of iterations in the common ancestry of all particles
+    std::size_t trunk_size() const { return trunk_.size(); }
+
+    /// \brief Reset history
+    void reset()
+    {
+        roots_ = 0;
+        root_ = npos();
+        compact_ = 0;
+        size_.clear();
+        trunk_.clear();
+        leaf_.clear();
+        node_.clear();
+        free_.clear();
+    }
+
+    /// \brief Release memory
+    void clear() { *this = ResampleGenealogy(); }
+
+    /// \brief Append an identity resampling index
+    void push_back(std::size_t N)
+    {
+        if (size_.size() != 0 && N == size_.back()) {
+            size_.push_back(N);
+            return;
+        }
+
+        index_.resize(N);
+        for (std::size_t i = 0; i != N; ++i)
+            index_[i] = static_cast<index_type>(i);
+        push_index();
+    }
+
+    /// \brief Append a resampling index
+    template <typename InputIter>
+    void push_back(std::size_t N, InputIter first)
+    {
+        index_.resize(N);
+        std::copy_n(first, N, index_.begin());
+        push_index();
+    }
+
+    index_type index(std::size_t id) const
+    {
+        return index(id, iter_size() - 1, 0);
+    }
+
+    index_type index(std::size_t id, std::size_t iter_back) const
+    {
+        return index(id, iter_back, 0);
+    }
+
+    /// \brief Get the index given the particle ID and iteration number
+    index_type index(
+        std::size_t id, std::size_t iter_back, std::size_t iter) const
+    {
+        runtime_assert(iter <= iter_back && iter_back + 1 == iter_size(),
+            "**ResampleGenealogy::index** iteration numbers out of range");
+
+        if (iter < trunk_.size())
+            return trunk_[iter];
+
+        std::size_t n = leaf_[id];
+        while (node_[n].gen > iter)
+            n = node_[n].parent;
+
+        return node_[n].gen == iter ? node_[n].value : node_[n].self;
+    }
+
+    std::size_t index_matrix_nrow() const
+    {
+        return index_matrix_nrow(iter_size() - 1);
+    }
+
+    std::size_t index_matrix_nrow(std::size_t iter_back) const
+    {
+        runtime_assert(iter_back + 1 == iter_size(),
+            "**ResampleGenealogy::index_matrix_nrow** iteration numbers out "
+            "of range");
+
+        return size_[iter_back];
+    }
+
+    std::size_t index_matrix_ncol() const
+    {
+        return index_matrix_ncol(iter_size() - 1, 0);
+    }
+
+    std::size_t index_matrix_ncol(std::size_t iter_back) const
+    {
+        return index_matrix_ncol(iter_back, 0);
+    }
+
+    std::size_t index_matrix_ncol(
+        std::size_t iter_back, std::size_t iter) const
+    {
+        runtime_assert(iter <= iter_back && iter_back + 1 == iter_size(),
+            "**ResampleGenealogy::index_matrix_ncol** iteration numbers out "
+            "of range");
+
+        return iter_back - iter + 1;
+    }
+
+    Vector<index_type> index_matrix(MatrixLayout layout) const
+    {
+        return index_matrix(layout, iter_size() - 1, 0);
+    }
+
+    Vector<index_type> index_matrix(
+        MatrixLayout layout, std::size_t iter_back) const
+    {
+        return index_matrix(layout, iter_back, 0);
+    }
+
+    /// \brief Get the resampling index matrix.
+    Vector<index_type> index_matrix(
+        MatrixLayout layout, std::size_t iter_back, std::size_t iter) const
+    {
+        Vector<index_type> idxmat(
+            index_matrix_nrow(iter_back) * index_matrix_ncol(iter_back, iter));
+        read_index_matrix(layout, idxmat.begin(), iter_back, iter);
+
+        return idxmat;
+    }
+
+    template <typename RandomIter>
+    RandomIter read_index_matrix(MatrixLayout layout, RandomIter first) const
+    {
+        return read_index_matrix(layout, first, iter_size() - 1, 0);
+    }
+
+    template <typename RandomIter>
+    RandomIter read_index_matrix(
+        MatrixLayout layout, RandomIter first, std::size_t iter_back) const
+    {
+        return read_index_matrix(layout, first, iter_back, 0);
+    }
+
+    /// \brief Read the resampling index matrix into an random access iterator
+    ///
+    /// \details
+    /// The output is the same as ResampleIndex::read_index_matrix. Each row
+    /// is filled by walking a lineage from its leaf to the common ancestry,
+    /// one node per resampling event, after which the remaining columns are
+    /// copied from the flat common ancestry.
+    template <typename RandomIter>
+    RandomIter read_index_matrix(MatrixLayout layout, RandomIter first,
+        std::size_t iter_back, std::size_t iter) const
+    {
+        runtime_assert(iter <= iter_back && iter_back + 1 == iter_size(),
+            "**ResampleGenealogy::read_index_matrix** iteration numbers out "
+            "of range");
+
+        using difference_type =
+            typename std::iterator_traits<RandomIter>::difference_type;
+        const std::size_t N = index_matrix_nrow(iter_back);
+        const std::size_t R = index_matrix_ncol(iter_back, iter);
+        const std::size_t t0 = std::max(iter, trunk_.size());
+        const std::size_t rs = layout == RowMajor ? R : 1;
+        const std::size_t cs = layout == RowMajor ? 1 : N;
+
+        for (std::size_t i = 0; i != N; ++i) {
+            RandomIter row = first + static_cast<difference_type>(i * rs);
+            std::size_t g = iter_back + 1;
+            std::size_t n = leaf_[i];
+            while (g > t0) {
+                const std::size_t g0 = std::max(node_[n].gen, t0);
+                const index_type s = node_[n].self;
+                while (g > g0 + 1) {
+                    --g;
+                    row[static_cast<difference_type>((g - iter) * cs)] = s;
+                }
+                --g;
+                row[static_cast<difference_type>((g - iter) * cs)] =
+                    node_[n].gen == g ? node_[n].value : s;
+                n = node_[n].parent;
+            }
+            while (g > iter) {
+                --g;
+                row[static_cast<difference_type>((g - iter) * cs)] =
+                    trunk_[g];
+            }
+        }
+
+        return first + static_cast<difference_type>(N * R);
+    }
+
+    private:
+    std::size_t roots_;
+    std::size_t root_;
+    std::size_t compact_;
+    Vector<std::size_t> size_;
+    Vector<index_type> trunk_;
+    Vector<std::size_t> leaf_;
+
+    // A lineage segment starting at iteration gen, where the index is value,
+    // and then followed by identity iterations, where the index is self. The
+    // reference count is the number of children, plus one if it is a leaf
+    struct Node {
+        std::size_t parent;
+        std::size_t gen;
+        std::size_t count;
+        index_type value;
+        index_type self;
+    }; // struct Node
+
+    Vector<Node> node_;
+    Vector<std::size_t> free_;
+
+    Vector<index_type> index_;
+    Vector<std::size_t> leaf_tmp_;
+    Vector<std::size_t> path_;
+
+    static std::size_t npos()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    void push_index()
+    {
+        const std::size_t N = index_.size();
+        const std::size_t M = size();
+        const std::size_t g = size_.size();
+
+        if (g != 0 && N == M) {
+            bool identity = true;
+            for (std::size_t i = 0; i != N && identity; ++i)
+                identity = static_cast<std::size_t>(index_[i]) == i;
+            if (identity) {
+                size_.push_back(N);
+                return;
+            }
+        }
+
+        leaf_tmp_.resize(N);
+        for (std::size_t i = 0; i != N; ++i) {
+            const std::size_t a = static_cast<std::size_t>(index_[i]);
+            std::size_t p = npos();
+            if (g == 0) {
+                ++roots_;
+            } else {
+                runtime_assert(a < M,
+                    "**ResampleGenealogy::push_back** index out of range");
+                p = leaf_[a];
+                ++node_[p].count;
+            }
+            leaf_tmp_[i] = node(p, g, index_[i], static_cast<index_type>(i));
+        }
+        for (std::size_t i = 0; i != M; ++i)
+            release(leaf_[i]);
+        std::swap(leaf_, leaf_tmp_);
+        size_.push_back(N);
+        compact();
+    }
+
+    std::size_t node(std::size_t p, std::size_t g, index_type v, index_type s)
+    {
+        Node nd = {p, g, 1, v, s};
+        if (free_.size() == 0) {
+            node_.push_back(nd);
+            return node_.size() - 1;
+        }
+
+        const std::size_t n = free_.back();
+        free_.pop_back();
+        node_[n] = nd;
+
+        return n;
+    }
+
+    void release(std::size_t n)
+    {
+        while (n != npos() && --node_[n].count == 0) {
+            const std::size_t p = node_[n].parent;
+            free_.push_back(n);
+            if (p == npos())
+                --roots_;
+            n = p;
+        }
+    }
+
+    // Once there is a single root, move its unary segments to the trunk. The
+    // walk from a leaf to the root is amortized over as many iterations as
+    // its length
+    void compact()
+    {
+        if (roots_ != 1 || leaf_.size() == 0 || size_.size() < compact_)
+            return;
+
+        if (root_ == npos()) {
+            root_ = leaf_[0];
+            while (node_[root_].parent != npos())
+                root_ = node_[root_].parent;
+        }
+        if (node_[root_].count != 1)
+            return;
+
+        path_.clear();
+        for (std::size_t n = leaf_[0]; n != npos(); n = node_[n].parent)
+            path_.push_back(n);
+
+        std::size_t k = path_.size() - 1;
+        while (k != 0 && node_[path_[k]].count == 1) {
+            const std::size_t r = path_[k];
+            const std::size_t c = path_[k - 1];
+            trunk_.push_back(node_[r].value);
+            for (std::size_t g = node_[r].gen + 1; g < node_[c].gen; ++g)
+                trunk_.push_back(node_[r].self);
+            free_.push_back(r);
+            node_[c].parent = npos();
+            --k;
+        }
+        root_ = path_[k];
+        compact_ = size_.size() + path_.size();
+    }
+}; // class ResampleGenealogy
+
+} // namespace mckl
+
+#endif // MCKL_RESAMPLE_GENEALOGY_HPP
@@ -33,6 +33,7 @@
 #define MCKL_RESAMPLE_INDEX_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/smp/backend_seq.hpp>
 
 namespace mckl
 {
@@ -155,18 +156,21 @@ class ResampleIndex
         return iter_back - iter + 1;
     }
 
+    template <typename Backend = BackendSEQ>
     Vector<index_type> index_matrix(MatrixLayout layout) const
     {
-        return index_matrix(layout, iter_size_ - 1, 0);
+        return index_matrix<Backend>(layout, iter_size_ - 1, 0);
     }
 
+    template <typename Backend = BackendSEQ>
     Vector<index_type> index_matrix(
         MatrixLayout layout, std::size_t iter_back) const
     {
-        return index_matrix(layout, iter_back, 0);
+        return index_matrix<Backend>(layout, iter_back, 0);
     }
 
     /// \brief Get the resampling index matrix.
+    template <typename Backend = BackendSEQ>
     Vector<index_type> index_matrix(
         MatrixLayout layout, std::size_t iter_back, std::size_t iter) const
     {
@@ -175,22 +179,22 @@ class ResampleIndex
 
         Vector<index_type> idxmat(
             index_matrix_nrow(iter_back) * index_matrix_ncol(iter_back, iter));
-        read_index_matrix(layout, idxmat.begin(), iter_back, iter);
+        read_index_matrix<Backend>(layout, idxmat.begin(), iter_back, iter);
 
         return idxmat;
     }
 
-    template <typename RandomIter>
+    template <typename Backend = BackendSEQ, typename RandomIter>
     RandomIter read_index_matrix(MatrixLayout layout, RandomIter first) const
     {
-        return read_index_matrix(layout, first, iter_size_ - 1, 0);
+        return read_index_matrix<Backend>(layout, first, iter_size_ - 1, 0);
     }
 
-    template <typename RandomIter>
+    template <typename Backend = BackendSEQ, typename RandomIter>
     RandomIter read_index_matrix(
         MatrixLayout layout, RandomIter first, std::size_t iter_back) const
     {
-        return read_index_matrix(layout, first, iter_back, 0);
+        return read_index_matrix<Backend>(layout, first, iter_back, 0);
     }
 
     /// \brief Read the resampling index matrix into an random access iterator
@@ -200,9 +204,14 @@ class ResampleIndex
     /// \f$R\f$ is the number of iterations between `iter` and `iter_back`,
     /// inclusive; and \f$N\f$ is the sample size at iteration `iter_back`. The
     /// output is equivalent to set the \f$M_{i,j}\f$ to
-    /// `index(i, j, iter_back)`. Note that, column major will be more
-    /// efficient.
-    template <typename RandomIter>
+    /// `index(i, j, iter_back)`.
+    ///
+    /// The rows are split into blocks, which are distributed by `Backend`.
+    /// For row major output, the columns of each block are traced back in
+    /// tiles held in a small buffer, such that each row of the matrix is
+    /// written contiguously. For column major output, each range of rows is
+    /// traced back one column at a time, directly into the output.
+    template <typename Backend = BackendSEQ, typename RandomIter>
     RandomIter read_index_matrix(MatrixLayout layout, RandomIter first,
         std::size_t iter_back, std::size_t iter) const
     {
@@ -214,51 +223,93 @@ class ResampleIndex
             typename std::iterator_traits<RandomIter>::difference_type;
         const std::size_t N = index_matrix_nrow(iter_back);
         const std::size_t R = index_matrix_ncol(iter_back, iter);
-
-        if (layout == RowMajor) {
-            RandomIter back = first + static_cast<difference_type>(R - 1);
-            const index_type *idx = index_[iter_back].data();
-            for (std::size_t i = 0; i != N; ++i)
-                back[static_cast<difference_type>(i * R)] = idx[i];
-            for (std::size_t r = 1; r != R; ++r) {
-                const std::size_t j = iter_back - r;
-                RandomIter last = back;
-                --back;
-                idx = index_[j].data();
-                for (std::size_t i = 0; i != N; ++i) {
-                    back[static_cast<difference_type>(i * R)] =
-                        idx[static_cast<std::size_t>(
-                            last[static_cast<difference_type>(i * R)])];
+        const std::size_t n = internal::BufferSize<index_type>::value;
+        const std::size_t nb = N / n + (N % n == 0 ? 0 : 1);
+
+        internal::BackendFor<Backend>::run(
+            nb, 1, [&](std::size_t b, std::size_t e) {
+                if (layout == ColMajor) {
+                    read_index_col(
+                        first, N, R, iter, b * n, std::min(N, e * n));
+                    return;
                 }
-            }
-        }
-
-        if (layout == ColMajor) {
-            RandomIter back =
-                first + static_cast<difference_type>(N * (R - 1));
-            const index_type *idx = index_[iter_back].data();
-            std::copy_n(idx, N, back);
-            for (std::size_t r = 1; r != R; ++r) {
-                const std::size_t j = iter_back - r;
-                RandomIter last = back;
-                back -= static_cast<difference_type>(N);
-                idx = index_[j].data();
-                for (std::size_t i = 0; i != N; ++i) {
-                    back[static_cast<difference_type>(i)] =
-                        idx[static_cast<std::size_t>(
-                            last[static_cast<difference_type>(i)])];
+                Vector<index_type> idx(n);
+                Vector<index_type> tile(n * tile_ncol_);
+                for (std::size_t k = b; k != e; ++k) {
+                    read_index_row(first, R, iter, k * n,
+                        std::min(N, (k + 1) * n), idx.data(), tile.data());
                 }
-            }
-        }
+            });
 
         return first + static_cast<difference_type>(N * R);
     }
 
     private:
+    static constexpr std::size_t tile_ncol_ = 8;
+
     std::size_t iter_size_;
     Vector<index_type> identity_;
     Vector<Vector<index_type>> index_;
 
+    // Trace back rows [rb, re), where columns [0, R) correspond to
+    // iterations [iter, iter + R). The columns are traced in tiles, which are
+    // stored in `tile` and then written out row by row
+    template <typename RandomIter>
+    void read_index_row(RandomIter first, std::size_t R, std::size_t iter,
+        std::size_t rb, std::size_t re, index_type *idx,
+        index_type *tile) const
+    {
+        using difference_type =
+            typename std::iterator_traits<RandomIter>::difference_type;
+        const std::size_t m = re - rb;
+
+        std::copy_n(index_[iter + R - 1].data() + rb, m, idx);
+        std::size_t c1 = R;
+        while (c1 != 0) {
+            const std::size_t c0 = c1 > tile_ncol_ ? c1 - tile_ncol_ : 0;
+            for (std::size_t c = c1; c != c0; --c) {
+                if (c != R) {
+                    const index_type *a = index_[iter + c - 1].data();
+                    for (std::size_t i = 0; i != m; ++i)
+                        idx[i] = a[static_cast<std::size_t>(idx[i])];
+                }
+                std::copy_n(idx, m, tile + (c - 1 - c0) * m);
+            }
+            const std::size_t t = c1 - c0;
+            for (std::size_t i = 0; i != m; ++i) {
+                RandomIter row =
+                    first + static_cast<difference_type>((rb + i) * R + c0);
+                for (std::size_t k = 0; k != t; ++k)
+                    row[static_cast<difference_type>(k)] = tile[k * m + i];
+            }
+            c1 = c0;
+        }
+    }
+
+    // Trace back rows [rb, re), one column at a time
+    template <typename RandomIter>
+    void read_index_col(RandomIter first, std::size_t N, std::size_t R,
+        std::size_t iter, std::size_t rb, std::size_t re) const
+    {
+        using difference_type =
+            typename std::iterator_traits<RandomIter>::difference_type;
+        const std::size_t m = re - rb;
+
+        RandomIter back =
+            first + static_cast<difference_type>(N * (R - 1) + rb);
+        std::copy_n(index_[iter + R - 1].data() + rb, m, back);
+        for (std::size_t c = R - 1; c != 0; --c) {
+            RandomIter last = back;
+            back -= static_cast<difference_type>(N);
+            const index_type *a = index_[iter + c - 1].data();
+            for (std::size_t i = 0; i != m; ++i) {
+                back[static_cast<difference_type>(i)] =
+                    a[static_cast<std::size_t>(
+                        last[static_cast<difference_type>(i)])];
+            }
+        }
+    }
+
     void resize_identity(std::size_t N)
     {
         std::size_t n = identity_.size();
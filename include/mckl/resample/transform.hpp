@@ -33,10 +33,21 @@
 #define MCKL_RESAMPLE_TRANSFORM_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/smp/backend_seq.hpp>
 
 namespace mckl
 {
 
+namespace internal
+{
+
+/// \brief The floating point type in which the sums of weights of type `T`
+/// are accumulated, at least double precision
+template <typename T>
+using ResampleAccType = typename std::common_type<T, double>::type;
+
+} // namespace mckl::internal
+
 /// \brief Transform normalized weights to normalized residual and integrals,
 /// \ingroup Resample
 ///
@@ -57,7 +68,7 @@ inline std::size_t resample_trans_residual(std::size_t N, std::size_t M,
         "**resample_trans_residual** used resid other than floating point "
         "types");
 
-    resid_type sum_resid = 0;
+    internal::ResampleAccType<resid_type> sum_resid = 0;
     integ_type sum_integ = 0;
     OutputIterR resid_i = resid;
     OutputIterI integ_i = integ;
@@ -71,7 +82,7 @@ inline std::size_t resample_trans_residual(std::size_t N, std::size_t M,
         sum_integ += *integ_i;
     }
 
-    const resid_type mul_resid = 1 / sum_resid;
+    const resid_type mul_resid = static_cast<resid_type>(1 / sum_resid);
     for (std::size_t i = 0; i != N; ++i, ++resid)
         *resid *= mul_resid;
 
@@ -91,6 +102,7 @@ inline OutputIter resample_trans_u01_rep(std::size_t N, std::size_t M,
     InputIter weight, U01SeqType &&u01seq, OutputIter replication)
 {
     using real_type = typename std::iterator_traits<InputIter>::value_type;
+    using acc_type = internal::ResampleAccType<real_type>;
     using rep_type = typename std::iterator_traits<OutputIter>::value_type;
 
     if (N == 0)
@@ -105,11 +117,11 @@ inline OutputIter resample_trans_u01_rep(std::size_t N, std::size_t M,
     if (M == 0)
         return rep;
 
-    real_type accw = 0;
+    acc_type accw = 0;
     std::size_t j = 0;
     for (std::size_t i = 0; i != N - 1; ++i, ++weight, ++replication) {
         accw += *weight;
-        while (j != M && static_cast<real_type>(u01seq[j]) < accw) {
+        while (j != M && static_cast<acc_type>(u01seq[j]) < accw) {
             *replication += 1;
             ++j;
         }
@@ -119,6 +131,115 @@ inline OutputIter resample_trans_u01_rep(std::size_t N, std::size_t M,
     return replication;
 }
 
+namespace internal
+{
+
+// Transform replication numbers into parent indices, a few at a time. A copy
+// of the object resumes the transformation from where the copy was made.
+template <typename InputIter>
+class ResampleTransRepIndex
+{
+    public:
+    using rep_type = typename std::iterator_traits<InputIter>::value_type;
+
+    ResampleTransRepIndex(
+        std::size_t N, std::size_t M, InputIter replication)
+        : N_(N)
+        , K_(std::min(N, M))
+        , time_(0)
+        , src_(0)
+        , dst_(0)
+        , rep_src_(replication)
+        , rep_dst_(replication)
+    {
+    }
+
+    /// \brief Resume the transformation at destination `dst`, after `time`
+    /// copies of source `src` have been made into earlier destinations
+    ///
+    /// \details
+    /// `replication` shall be a random access iterator
+    ResampleTransRepIndex(std::size_t N, std::size_t M, InputIter replication,
+        std::size_t dst, std::size_t src, rep_type time)
+        : N_(N)
+        , K_(std::min(N, M))
+        , time_(time)
+        , src_(src)
+        , dst_(dst)
+        , rep_src_(replication + static_cast<std::ptrdiff_t>(std::min(src, N)))
+        , rep_dst_(replication + static_cast<std::ptrdiff_t>(std::min(dst, K_)))
+    {
+    }
+
+    /// \brief Write the next `n` parent indices
+    template <typename OutputIter>
+    OutputIter operator()(std::size_t n, OutputIter index)
+    {
+        using idx_type = typename std::iterator_traits<OutputIter>::value_type;
+
+        // The state is kept in local variables within the loop
+        const std::size_t N = N_;
+        const std::size_t K = K_;
+        rep_type time = time_;
+        std::size_t src = src_;
+        std::size_t dst = dst_;
+        InputIter rep_src = rep_src_;
+        InputIter rep_dst = rep_dst_;
+
+        auto seek = [N, K, &time, &src, &rep_src]() {
+            if (src < K && *rep_src < time + 2) {
+                time = 0;
+                do {
+                    ++src;
+                    ++rep_src;
+                } while (src < K && *rep_src < time + 2);
+            }
+            if (src >= K && *rep_src < time + 1) {
+                time = 0;
+                do {
+                    ++src;
+                    ++rep_src;
+                } while (src < N && *rep_src < time + 1);
+            }
+        };
+
+        const std::size_t last = dst + n;
+        for (; dst < K && dst != last; ++dst, ++rep_dst) {
+            if (*rep_dst > 0) {
+                *index++ = static_cast<idx_type>(dst);
+            } else {
+                seek();
+                *index++ = static_cast<idx_type>(src);
+                ++time;
+            }
+        }
+        for (; dst != last; ++dst) {
+            seek();
+            *index++ = static_cast<idx_type>(src);
+            ++time;
+        }
+
+        time_ = time;
+        src_ = src;
+        dst_ = dst;
+        rep_src_ = rep_src;
+        rep_dst_ = rep_dst;
+
+        return index;
+    }
+
+    private:
+    std::size_t N_;
+    std::size_t K_;
+    rep_type time_;
+    std::size_t src_;
+    std::size_t dst_;
+    InputIter rep_src_;
+    InputIter rep_dst_;
+}; // class ResampleTransRepIndex
+
+} // namespace mckl::internal
+
 /// \brief Transform replication numbers into parent indices
 /// \ingroup Resample
 ///
@@ -130,51 +251,330 @@ template <typename InputIter, typename OutputIter>
 inline OutputIter resample_trans_rep_index(
     std::size_t N, std::size_t M, InputIter replication, OutputIter index)
 {
-    using rep_type = typename std::iterator_traits<InputIter>::value_type;
-    using idx_type = typename std::iterator_traits<OutputIter>::value_type;
-
     if (N == 0 || M == 0)
         return index;
 
-    const std::size_t K = std::min(N, M);
-    rep_type time = 0;
-    std::size_t src = 0;
-    InputIter rep = replication;
-
-    auto seek = [N, K, &time, &src, &rep]() {
-        if (src < K && *rep < time + 2) {
-            time = 0;
-            do {
-                ++src;
-                ++rep;
-            } while (src < K && *rep < time + 2);
+    internal::ResampleTransRepIndex<InputIter> trans(N, M, replication);
+
+    return trans(M, index);
+}
+
+namespace internal
+{
+
+constexpr std::size_t resample_block_size()
+{
+    return BufferSize<double>::value;
+}
+
+inline std::size_t resample_num_blocks(std::size_t N)
+{
+    const std::size_t k = resample_block_size();
+
+    return N / k + (N % k == 0 ? 0 : 1);
+}
+
+// The sequential backend, and any sample within a single block, use the
+// sequential transforms, such that the results are bit-identical to them
+template <typename Backend>
+inline bool resample_trans_serial(std::size_t N)
+{
+    return std::is_same<Backend, BackendSEQ>::value ||
+        N <= resample_block_size();
+}
+
+// `sum_integ` is a workspace of size `resample_num_blocks(N)`
+template <typename Backend, typename RandomIter, typename RandomIterR,
+    typename RandomIterI>
+inline std::size_t resample_trans_residual(std::size_t N, std::size_t M,
+    RandomIter weight, RandomIterR resid, RandomIterI integ,
+    std::size_t *sum_integ)
+{
+    using resid_type = typename std::iterator_traits<RandomIterR>::value_type;
+    using integ_type = typename std::iterator_traits<RandomIterI>::value_type;
+    using acc_type = ResampleAccType<resid_type>;
+
+    static_assert(std::is_floating_point<resid_type>::value,
+        "**resample_trans_residual** used resid other than floating point "
+        "types");
+
+    if (resample_trans_serial<Backend>(N))
+        return mckl::resample_trans_residual(N, M, weight, resid, integ);
+
+    const std::size_t k = resample_block_size();
+    const std::size_t nb = resample_num_blocks(N);
+    const resid_type coeff = static_cast<resid_type>(M);
+    BackendFor<Backend>::run(nb, 1, [=](std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j) {
+            const std::size_t first = j * k;
+            const std::size_t last = std::min(N, first + k);
+            std::size_t si = 0;
+            for (std::size_t i = first; i != last; ++i) {
+                const resid_type w = coeff * static_cast<resid_type>(weight[i]);
+                resid_type integral;
+                resid[i] = std::modf(w, &integral);
+                integ[i] = static_cast<integ_type>(integral);
+                si += static_cast<std::size_t>(integ[i]);
+            }
+            sum_integ[j] = si;
         }
-        if (src >= K && *rep < time + 1) {
-            time = 0;
-            do {
-                ++src;
-                ++rep;
-            } while (src < N && *rep < time + 1);
+    });
+
+    // The residuals are summed in the same order as the sequential transform,
+    // such that the results are bit-identical. The integral parts are exact
+    acc_type sr = 0;
+    for (std::size_t i = 0; i != N; ++i)
+        sr += resid[i];
+    std::size_t si = 0;
+    for (std::size_t j = 0; j != nb; ++j)
+        si += sum_integ[j];
+
+    const resid_type mul_resid = static_cast<resid_type>(1 / sr);
+    BackendFor<Backend>::run(nb, 1, [=](std::size_t b, std::size_t e) {
+        const std::size_t first = b * k;
+        const std::size_t last = std::min(N, e * k);
+        for (std::size_t i = first; i != last; ++i)
+            resid[i] *= mul_resid;
+    });
+
+    return M - si;
+}
+
+// `acc` is a workspace of size `resample_num_blocks(N) + 1`
+template <typename Backend, typename RandomIter, typename RandomIterU,
+    typename RandomIterO>
+inline RandomIterO resample_trans_u01_rep(std::size_t N, std::size_t M,
+    RandomIter weight, RandomIterU u01seq, RandomIterO replication,
+    ResampleAccType<typename std::iterator_traits<RandomIter>::value_type> *acc)
+{
+    using real_type = typename std::iterator_traits<RandomIter>::value_type;
+    using acc_type = ResampleAccType<real_type>;
+    using u01_type = typename std::iterator_traits<RandomIterU>::value_type;
+    using rep_type = typename std::iterator_traits<RandomIterO>::value_type;
+
+    if (N == 0)
+        return replication;
+
+    if (N == 1) {
+        *replication++ = static_cast<rep_type>(M);
+        return replication;
+    }
+
+    if (M == 0)
+        return std::fill_n(replication, N, const_zero<rep_type>());
+
+    if (resample_trans_serial<Backend>(N)) {
+        return mckl::resample_trans_u01_rep(
+            N, M, weight, u01seq, replication);
+    }
+
+    const std::size_t k = resample_block_size();
+    const std::size_t nb = resample_num_blocks(N);
+
+    // The cumulative weights at the boundaries of the blocks. They are added
+    // in the same order as the sequential transform, and each block resumes
+    // from them, such that the results are bit-identical
+    acc_type accw = 0;
+    acc[0] = 0;
+    for (std::size_t j = 0; j != nb; ++j) {
+        const std::size_t last = std::min(N, (j + 1) * k);
+        for (std::size_t i = j * k; i != last; ++i)
+            accw += weight[i];
+        acc[j + 1] = accw;
+    }
+
+    // Each block takes the uniforms in [acc[j], acc[j + 1]), except that the
+    // last block takes all remaining ones
+    auto bound = [=](acc_type a) {
+        return static_cast<std::size_t>(std::lower_bound(u01seq, u01seq + M,
+                                            a, [](u01_type u, acc_type v) {
+                                                return static_cast<acc_type>(
+                                                           u) < v;
+                                            }) -
+            u01seq);
+    };
+    BackendFor<Backend>::run(nb, 1, [=](std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j) {
+            const std::size_t first = j * k;
+            const std::size_t last = std::min(N, first + k);
+            const std::size_t ulast = j + 1 == nb ? M : bound(acc[j + 1]);
+            std::size_t u = j == 0 ? 0 : bound(acc[j]);
+            acc_type accw = acc[j];
+            for (std::size_t i = first; i != last - 1; ++i) {
+                accw += weight[i];
+                std::size_t r = 0;
+                while (u != ulast && static_cast<acc_type>(u01seq[u]) < accw) {
+                    ++r;
+                    ++u;
+                }
+                replication[i] = static_cast<rep_type>(r);
+            }
+            replication[last - 1] = static_cast<rep_type>(ulast - u);
         }
+    });
+
+    return replication + static_cast<std::ptrdiff_t>(N);
+}
+
+// Compute the states of the transformation at the beginning of each block of
+// `k` destinations. `extra` and `hole` are workspaces of sizes
+// `N / k + 2` and `M / k + 2`
+template <typename Backend, typename RandomIter>
+inline void resample_trans_rep_index_state(std::size_t N, std::size_t M,
+    RandomIter replication, std::size_t k,
+    ResampleTransRepIndex<RandomIter> *state, std::size_t *extra,
+    std::size_t *hole)
+{
+    const std::size_t K = std::min(N, M);
+    const std::size_t ns = N / k + (N % k == 0 ? 0 : 1);
+    const std::size_t nd = M / k + (M % k == 0 ? 0 : 1);
+
+    // The number of extra copies made of each source, other than copying
+    // into itself
+    auto nextra = [K, replication](std::size_t src) {
+        const std::size_t r = static_cast<std::size_t>(replication[src]);
+        return src < K ? (r > 0 ? r - 1 : 0) : r;
     };
 
-    for (std::size_t dst = 0; dst != K; ++dst, ++replication, ++index) {
-        if (*replication > 0) {
-            *index = static_cast<idx_type>(dst);
-        } else {
-            seek();
-            *index = static_cast<idx_type>(src);
-            ++time;
+    BackendFor<Backend>::run(ns, 1, [=](std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j) {
+            const std::size_t first = j * k;
+            const std::size_t last = std::min(N, first + k);
+            std::size_t n = 0;
+            for (std::size_t i = first; i != last; ++i)
+                n += nextra(i);
+            extra[j + 1] = n;
         }
-    }
+    });
 
-    for (std::size_t dst = K; dst < M; ++dst, ++index) {
-        seek();
-        *index = static_cast<idx_type>(src);
-        ++time;
-    }
+    // The number of destinations which are not a copy of themselves
+    BackendFor<Backend>::run(nd, 1, [=](std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j) {
+            const std::size_t first = j * k;
+            const std::size_t last = std::min(M, first + k);
+            std::size_t n = 0;
+            for (std::size_t i = first; i < std::min(last, K); ++i)
+                n += replication[i] > 0 ? 0 : 1;
+            if (last > K)
+                n += last - std::max(first, K);
+            hole[j + 1] = n;
+        }
+    });
+
+    extra[0] = 0;
+    for (std::size_t j = 0; j != ns; ++j)
+        extra[j + 1] += extra[j];
+    hole[0] = 0;
+    for (std::size_t j = 0; j != nd; ++j)
+        hole[j + 1] += hole[j];
+
+    // The holes are filled by the extra copies in order
+    BackendFor<Backend>::run(nd, 1, [=](std::size_t b, std::size_t e) {
+        for (std::size_t j = b; j != e; ++j) {
+            const std::size_t h = hole[j];
+            const std::size_t sb = static_cast<std::size_t>(
+                std::upper_bound(extra, extra + ns + 1, h) - extra);
+            std::size_t src = N;
+            std::size_t time = 0;
+            if (sb <= ns) {
+                src = (sb - 1) * k;
+                std::size_t n = extra[sb - 1];
+                while (n + nextra(src) <= h)
+                    n += nextra(src++);
+                time = h - n;
+            }
+            state[j] = ResampleTransRepIndex<RandomIter>(N, M, replication,
+                j * k, src,
+                static_cast<typename ResampleTransRepIndex<
+                    RandomIter>::rep_type>(time));
+        }
+    });
+}
+
+} // namespace mckl::internal
+
+/// \brief Transform normalized weights to normalized residual and integrals
+/// in parallel
+/// \ingroup Resample
+///
+/// \details
+/// With a parallel backend, the residuals and integral parts are computed in
+/// blocks of a fixed size in parallel. The residuals are summed sequentially,
+/// in the same order as the sequential overload. Therefore the results are
+/// bit-identical to the sequential overload, regardless of the backend and the
+/// number of threads.
+template <typename Backend, typename RandomIter, typename RandomIterR,
+    typename RandomIterI>
+inline std::size_t resample_trans_residual(std::size_t N, std::size_t M,
+    RandomIter weight, RandomIterR resid, RandomIterI integ)
+{
+    Vector<std::size_t> sum_integ(internal::resample_num_blocks(N));
+
+    return internal::resample_trans_residual<Backend>(
+        N, M, weight, resid, integ, sum_integ.data());
+}
+
+/// \brief Transform uniform [0, 1) sequence into replication numbers in
+/// parallel
+/// \ingroup Resample
+///
+/// \details
+/// With a parallel backend, the cumulative weights at the boundaries of
+/// blocks of a fixed size are computed first, added in the same order as the
+/// sequential overload. Each block then locates its range of the uniform
+/// sequence with a binary search, and the blocks are merged with the uniform
+/// sequence independently, resuming from the cumulative weights at their
+/// boundaries. Therefore the results are bit-identical to the sequential
+/// overload, regardless of the backend and the number of threads. Only the
+/// additions of the weights remain sequential.
+template <typename Backend, typename RandomIter, typename RandomIterU,
+    typename RandomIterO>
+inline RandomIterO resample_trans_u01_rep(std::size_t N, std::size_t M,
+    RandomIter weight, RandomIterU u01seq, RandomIterO replication)
+{
+    using real_type = typename std::iterator_traits<RandomIter>::value_type;
+
+    Vector<internal::ResampleAccType<real_type>> acc(
+        internal::resample_num_blocks(N) + 1);
+
+    return internal::resample_trans_u01_rep<Backend>(
+        N, M, weight, u01seq, replication, acc.data());
+}
+
+/// \brief Transform replication numbers into parent indices in parallel
+/// \ingroup Resample
+///
+/// \details
+/// The destinations are processed in blocks. The state of the transformation
+/// at the beginning of each block is located with prefix sums of the number
+/// of copies. The results are identical to the sequential overload.
+template <typename Backend, typename RandomIter, typename RandomIterO>
+inline RandomIterO resample_trans_rep_index(
+    std::size_t N, std::size_t M, RandomIter replication, RandomIterO index)
+{
+    using trans_type = internal::ResampleTransRepIndex<RandomIter>;
+
+    if (N == 0 || M == 0)
+        return index;
+
+    const std::size_t k = internal::resample_block_size();
+    const std::size_t nd = M / k + (M % k == 0 ? 0 : 1);
+    Vector<trans_type> state(nd, trans_type(N, M, replication));
+    Vector<std::size_t> extra(N / k + 2);
+    Vector<std::size_t> hole(M / k + 2);
+    internal::resample_trans_rep_index_state<Backend>(
+        N, M, replication, k, state.data(), extra.data(), hole.data());
+
+    internal::BackendFor<Backend>::run(
+        nd, 1, [=, &state](std::size_t b, std::size_t e) {
+            for (std::size_t j = b; j != e; ++j) {
+                const std::size_t first = j * k;
+                state[j](std::min(k, M - first),
+                    index + static_cast<std::ptrdiff_t>(first));
+            }
+        });
 
-    return index;
+    return index + static_cast<std::ptrdiff_t>(M);
 }
 
 } // namespace mckl
@@ -33,6 +33,7 @@
 #define MCKL_RESAMPLE_U01_SEQUENCE_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/random/sobol.hpp>
 #include <mckl/random/u01_distribution.hpp>
 
 namespace mckl
@@ -41,26 +42,25 @@ namespace mckl
 namespace internal
 {
 
-template <std::size_t K, typename RealType>
+template <typename RealType>
 inline void u01_trans_sorted_impl(std::size_t n0, std::size_t n,
     const RealType *u01, RealType *r, std::size_t N, RealType &lmax)
 {
     if (n0 == n)
         return;
 
-    Array<RealType, K> s;
     std::size_t j = 0;
     std::size_t m = N - n0;
     log(n - n0, u01, r);
     for (std::size_t i = n0; i != n; ++i, ++j, --m) {
         lmax += r[j] / m;
-        s[j] = lmax;
+        r[j] = lmax;
     }
-    exp(n - n0, s.data(), s.data());
-    sub(n - n0, const_one<RealType>(), s.data(), r);
+    exp(n - n0, r, r);
+    sub(n - n0, const_one<RealType>(), r, r);
 }
 
-template <std::size_t K, typename RealType, typename RNGType>
+template <typename RealType, typename RNGType>
 inline void u01_rand_sorted_impl(RNGType &rng, std::size_t n0, std::size_t n,
     RealType *r, std::size_t N, RealType &lmax)
 {
@@ -68,7 +68,7 @@ inline void u01_rand_sorted_impl(RNGType &rng, std::size_t n0, std::size_t n,
         return;
 
     u01_distribution(rng, n - n0, r);
-    u01_trans_sorted_impl<K>(n0, n, r, r, N, lmax);
+    u01_trans_sorted_impl(n0, n, r, r, N, lmax);
 }
 
 template <typename RealType>
@@ -108,6 +108,52 @@ inline void u01_trans_systematic_impl(
     fma(n - n0, r, delta, u, r);
 }
 
+// The digital shift of the high 32 bits, 2^32 u < 2^32 unless u = 1, which
+// results in a zero shift
+template <typename RealType>
+inline std::uint64_t u01_sobol_shift(RealType u)
+{
+    return static_cast<std::uint64_t>(std::ldexp(static_cast<double>(u), 32))
+        << 32;
+}
+
+// The first N points of a (randomized) one dimensional Sobol sequence have at
+// most one point in each interval [b / M, (b + 1) / M) where M = 2^m >= N.
+// Thus the points are sorted by placing each in the slot of its interval. The
+// lowest bit of each point is set such that empty slots are zero
+template <typename RealType>
+inline void u01_sobol_impl(SobolEngine<std::uint64_t> &sobol,
+    std::uint64_t shift, std::size_t N, RealType *r,
+    Vector<std::uint64_t> &buffer)
+{
+    const std::size_t k = BufferSize<std::uint64_t>::value;
+
+    int m = 0;
+    while ((static_cast<std::size_t>(1) << m) < N)
+        ++m;
+    const std::size_t M = static_cast<std::size_t>(1) << m;
+    buffer.resize(M);
+    std::fill(buffer.begin(), buffer.end(), 0);
+
+    Array<std::uint64_t, k> s;
+    std::uint64_t *slot = buffer.data();
+    for (std::size_t i = 0; i < N; i += k) {
+        const std::size_t n = std::min(k, N - i);
+        sobol(n, s.data());
+        for (std::size_t j = 0; j != n; ++j) {
+            const std::uint64_t u = s[j] ^ shift;
+            slot[m == 0 ? 0 : u >> (64 - m)] = u | 1;
+        }
+    }
+
+    std::size_t j = 0;
+    for (std::size_t i = 0; i != M; ++i) {
+        slot[j] = slot[i];
+        j += slot[i] != 0;
+    }
+    u01_co(N, slot, r);
+}
+
 } // namespace mckl::internal
 
 /// \brief Tranform a sequence of standard uniform random numbers to sorted
@@ -135,8 +181,8 @@ inline void u01_trans_sorted(std::size_t N, const RealType *u01, RealType *r)
     std::size_t n0 = 0;
     RealType lmax = 0;
     for (std::size_t i = 0; i != m; ++i, n0 += k, u01 += k, r += k)
-        internal::u01_trans_sorted_impl<k>(n0, n0 + k, u01, r, N, lmax);
-    internal::u01_trans_sorted_impl<k>(n0, N, u01, r, N, lmax);
+        internal::u01_trans_sorted_impl(n0, n0 + k, u01, r, N, lmax);
+    internal::u01_trans_sorted_impl(n0, N, u01, r, N, lmax);
 }
 
 /// \brief Transform a sequence of standard uniform random numbers to a
@@ -186,6 +232,25 @@ inline void u01_trans_systematic(
     internal::u01_trans_systematic_impl(n0, N, u, r, delta);
 }
 
+/// \brief Transform a single standard uniform random number to a sorted
+/// digitally shifted Sobol sequence
+/// \ingroup Resample
+template <typename RealType>
+inline void u01_trans_sobol(std::size_t N, const RealType *u01, RealType *r)
+{
+    static_assert(std::is_floating_point<RealType>::value,
+        "**u01_trans_sobol** used with RealType other than floating point "
+        "types");
+
+    if (N == 0)
+        return;
+
+    SobolEngine<std::uint64_t> sobol;
+    Vector<std::uint64_t> buffer;
+    internal::u01_sobol_impl(
+        sobol, internal::u01_sobol_shift(u01[0]), N, r, buffer);
+}
+
 /// \brief Generate sorted standard uniform numbers with \f$O(N)\f$ cost
 /// \ingroup Resample
 template <typename RealType, typename RNGType>
@@ -210,8 +275,8 @@ inline void u01_rand_sorted(RNGType &rng, std::size_t N, RealType *r)
     std::size_t n0 = 0;
     RealType lmax = 0;
     for (std::size_t i = 0; i != m; ++i, n0 += k, r += k)
-        internal::u01_rand_sorted_impl<k>(rng, n0, n0 + k, r, N, lmax);
-    internal::u01_rand_sorted_impl<k>(rng, n0, N, r, N, lmax);
+        internal::u01_rand_sorted_impl(rng, n0, n0 + k, r, N, lmax);
+    internal::u01_rand_sorted_impl(rng, n0, N, r, N, lmax);
 }
 
 /// \brief Generate stratified standard uniform numbers
@@ -246,6 +311,24 @@ inline void u01_rand_systematic(RNGType &rng, std::size_t N, RealType *r)
     u01_trans_systematic(N, &u01, r);
 }
 
+/// \brief Generate a sorted scrambled Sobol sequence with \f$O(N)\f$ cost
+/// \ingroup Resample
+template <typename RealType, typename RNGType>
+inline void u01_rand_sobol(RNGType &rng, std::size_t N, RealType *r)
+{
+    static_assert(std::is_floating_point<RealType>::value,
+        "**u01_rand_sobol** used with RealType other than floating point "
+        "types");
+
+    if (N == 0)
+        return;
+
+    SobolEngine<std::uint64_t> sobol;
+    Vector<std::uint64_t> buffer;
+    sobol.scramble(rng);
+    internal::u01_sobol_impl(sobol, 0, N, r, buffer);
+}
+
 /// \brief Sorted of standard uniform numbers
 /// \ingroup Resample
 class U01SequenceSorted
@@ -300,6 +383,79 @@ class U01SequenceSystematic
     }
 }; // class U01SequenceSystematic
 
+/// \brief Randomized quasi standard uniform numbers
+/// \ingroup Resample
+///
+/// \details
+/// The output is the sorted first \f$N\f$ points of a one dimensional Sobol
+/// sequence. Each point is uniform on \f$[0, 1)\f$ and for \f$N = 2^m\f$
+/// there is exactly one point within each interval
+/// \f$[i/N, (i + 1)/N)\f$. With a random number generator, the sequence
+/// is randomized by `SobolEngine::scramble`. Given a single standard uniform
+/// random number, it is randomized by a digital shift. The `const` overloads
+/// of `operator()` use local storage and can be called concurrently by
+/// multiple threads. The non-`const` overloads reuse the storage owned by
+/// the object, and shall not be called concurrently on the same object.
+class U01SequenceSobol
+{
+    public:
+    template <typename RealType>
+    void operator()(std::size_t N, const RealType *u01, RealType *r) const
+    {
+        SobolEngine<std::uint64_t> sobol;
+        Vector<std::uint64_t> buffer;
+        shift(sobol, buffer, N, u01, r);
+    }
+
+    template <typename RealType, typename RNG>
+    void operator()(RNG &rng, std::size_t N, RealType *r) const
+    {
+        SobolEngine<std::uint64_t> sobol;
+        Vector<std::uint64_t> buffer;
+        scramble(sobol, buffer, rng, N, r);
+    }
+
+    template <typename RealType>
+    void operator()(std::size_t N, const RealType *u01, RealType *r)
+    {
+        shift(sobol_, buffer_, N, u01, r);
+    }
+
+    template <typename RealType, typename RNG>
+    void operator()(RNG &rng, std::size_t N, RealType *r)
+    {
+        scramble(sobol_, buffer_, rng, N, r);
+    }
+
+    private:
+    SobolEngine<std::uint64_t> sobol_;
+    Vector<std::uint64_t> buffer_;
+
+    template <typename RealType>
+    static void shift(SobolEngine<std::uint64_t> &sobol,
+        Vector<std::uint64_t> &buffer, std::size_t N, const RealType *u01,
+        RealType *r)
+    {
+        if (N == 0)
+            return;
+
+        sobol.reset();
+        internal::u01_sobol_impl(
+            sobol, internal::u01_sobol_shift(u01[0]), N, r, buffer);
+    }
+
+    template <typename RealType, typename RNG>
+    static void scramble(SobolEngine<std::uint64_t> &sobol,
+        Vector<std::uint64_t> &buffer, RNG &rng, std::size_t N, RealType *r)
+    {
+        if (N == 0)
+            return;
+
+        sobol.scramble(rng);
+        internal::u01_sobol_impl(sobol, 0, N, r, buffer);
+    }
+}; // class U01SequenceSobol
+
 } // namespace mckl
 
 #endif // MCKL_RESAMPLE_U01_SEQUENCE_HPP
@@ -110,6 +110,90 @@ class Virtual;
 template <typename T, typename = Virtual, typename = BackendSMP>
 class SamplerEvalSMP;
 
+namespace internal
+{
+
+/// \brief Parallel loop over `[0, N)`
+///
+/// \details
+/// Each specialization has a static member function `run(N, grainsize,
+/// work)`, which calls `work(first, last)` on disjoint subranges that
+/// together cover `[0, N)`.
+template <typename Backend>
+class BackendFor;
+
+/// \brief Add \f$\sum_i w_i v_{d,i}\f$ to `r[d]`, where `v` is a `dim` by
+/// `n` column major matrix, accumulated in double precision
+template <typename ValueType, typename RealType>
+inline void monitor_dgemv(std::size_t dim, std::size_t n, const ValueType *v,
+    const RealType *w, double *r)
+{
+    for (std::size_t i = 0; i != n; ++i, v += dim) {
+        const double wi = static_cast<double>(w[i]);
+        for (std::size_t d = 0; d != dim; ++d)
+            r[d] += wi * static_cast<double>(v[d]);
+    }
+}
+
+/// \brief Add \f$\sum_i w_i v_{d,i}\f$ to `r[d]`, where `v` is a `dim` by
+/// `n` column major matrix
+inline void monitor_dgemv(std::size_t dim, std::size_t n, const double *v,
+    const double *w, double *r)
+{
+    cblas_dgemv(CblasColMajor, CblasNoTrans, static_cast<MCKL_BLAS_INT>(dim),
+        static_cast<MCKL_BLAS_INT>(n), 1.0, v, static_cast<MCKL_BLAS_INT>(dim),
+        w, 1, 1.0, r, 1);
+}
+
+/// \brief Weighted sums of the values of all particles computed by a Monitor
+/// evaluation, without storing the values of all particles
+///
+/// \details
+/// `eval(range, r)` writes the `dim` values of each particle within `range`
+/// to `r`. The particles are partitioned into a fixed number of chunks, which
+/// are processed in parallel. Each chunk is evaluated in blocks small enough
+/// to stay in cache, and their weighted sums are accumulated into a vector of
+/// length `dim` of the chunk. The vectors of the chunks are added in order at
+/// last. Thus the memory cost is \f$O(\mathrm{dim})\f$ and the results do not
+/// depend on the number of threads.
+template <typename Backend, typename T, typename EvalType>
+inline void backend_monitor_sum(
+    std::size_t dim, Particle<T> &particle, double *r, EvalType &&eval)
+{
+    using size_type = typename Particle<T>::size_type;
+
+    std::fill_n(r, dim, 0.0);
+    const std::size_t N = static_cast<std::size_t>(particle.size());
+    if (N == 0 || dim == 0)
+        return;
+
+    const std::size_t nc = std::min(N, static_cast<std::size_t>(64));
+    const std::size_t cs = N / nc + (N % nc == 0 ? 0 : 1);
+    const std::size_t bk = BufferSize<double>::value * 8;
+    const std::size_t bs =
+        std::min(cs, std::max(bk / dim, static_cast<std::size_t>(1)));
+    const auto w = particle.weight().data();
+    Vector<double> sum(nc * dim, 0.0);
+    BackendFor<Backend>::run(nc, 1, [&](std::size_t b, std::size_t e) {
+        Vector<double> buffer(bs * dim);
+        for (std::size_t c = b; c != e; ++c) {
+            double *s = sum.data() + c * dim;
+            const std::size_t last = std::min(N, (c + 1) * cs);
+            for (std::size_t i = c * cs; i < last; i += bs) {
+                const std::size_t n = std::min(bs, last - i);
+                eval(particle.range(static_cast<size_type>(i),
+                         static_cast<size_type>(i + n)),
+                    buffer.data());
+                monitor_dgemv(dim, n, buffer.data(), w + i, s);
+            }
+        }
+    });
+    for (std::size_t c = 0; c != nc; ++c)
+        add(dim, r, sum.data() + c * dim, r);
+}
+
+} // namespace mckl::internal
+
 /// \brief Monitor<T>::eval_type
 /// \ingroup SMP
 template <typename T, typename = Virtual, typename = BackendSMP>
@@ -120,6 +204,25 @@ class MonitorEvalSMP;
 template <typename T, typename Derived>
 class SamplerEvalBase
 {
+    public:
+    /// \brief Called before a fused pass over all particles
+    void fused_first(std::size_t iter, Particle<T> &particle)
+    {
+        eval_first(iter, particle);
+    }
+
+    /// \brief Called on each range of particles within a fused pass
+    void fused_range(std::size_t iter, const ParticleRange<T> &range)
+    {
+        eval_range(iter, range);
+    }
+
+    /// \brief Called after a fused pass over all particles
+    void fused_last(std::size_t iter, Particle<T> &particle)
+    {
+        eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_BASE_SPECIAL(SamplerEval)
 
@@ -260,6 +363,25 @@ class SamplerEvalBase
 template <typename T>
 class SamplerEvalBase<T, Virtual>
 {
+    public:
+    /// \brief Called before a fused pass over all particles
+    void fused_first(std::size_t iter, Particle<T> &particle)
+    {
+        eval_first(iter, particle);
+    }
+
+    /// \brief Called on each range of particles within a fused pass
+    void fused_range(std::size_t iter, const ParticleRange<T> &range)
+    {
+        eval_range(iter, range);
+    }
+
+    /// \brief Called after a fused pass over all particles
+    void fused_last(std::size_t iter, Particle<T> &particle)
+    {
+        eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_BASE_SPECIAL_VIRTUAL(SamplerEval)
 
@@ -281,6 +403,26 @@ class SamplerEvalBase<T, Virtual>
 template <typename T, typename Derived>
 class MonitorEvalBase
 {
+    public:
+    /// \brief Called before a fused pass over all particles
+    void fused_first(std::size_t iter, Particle<T> &particle)
+    {
+        eval_first(iter, particle);
+    }
+
+    /// \brief Called on each range of particles within a fused pass
+    void fused_range(std::size_t iter, std::size_t dim,
+        const ParticleRange<T> &range, double *r)
+    {
+        eval_range(iter, dim, range, r);
+    }
+
+    /// \brief Called after a fused pass over all particles
+    void fused_last(std::size_t iter, Particle<T> &particle)
+    {
+        eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_BASE_SPECIAL(MonitorEval)
 
@@ -436,6 +578,26 @@ class MonitorEvalBase
 template <typename T>
 class MonitorEvalBase<T, Virtual>
 {
+    public:
+    /// \brief Called before a fused pass over all particles
+    void fused_first(std::size_t iter, Particle<T> &particle)
+    {
+        eval_first(iter, particle);
+    }
+
+    /// \brief Called on each range of particles within a fused pass
+    void fused_range(std::size_t iter, std::size_t dim,
+        const ParticleRange<T> &range, double *r)
+    {
+        eval_range(iter, dim, range, r);
+    }
+
+    /// \brief Called after a fused pass over all particles
+    void fused_last(std::size_t iter, Particle<T> &particle)
+    {
+        eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_BASE_SPECIAL_VIRTUAL(MonitorEval)
 
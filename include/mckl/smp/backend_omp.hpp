@@ -53,6 +53,30 @@ inline void backend_omp_range(IntType N, IntType &first, IntType &last)
     last = first + n;
 }
 
+template <>
+class BackendFor<BackendOMP>
+{
+    public:
+    template <typename WorkType>
+    static void run(std::size_t N, std::size_t, WorkType &&work)
+    {
+        if (N == 0)
+            return;
+
+        using work_type = typename std::remove_reference<WorkType>::type;
+
+        work_type *wptr = &work;
+#pragma omp parallel default(none) firstprivate(N, wptr)
+        {
+            std::size_t first = 0;
+            std::size_t last = 0;
+            backend_omp_range(N, first, last);
+            if (first != last)
+                (*wptr)(first, last);
+        }
+    }
+}; // class BackendFor
+
 } // namespace mckl::internal
 
 /// \brief Sampler<T>::eval_type subtype using OpenMP
@@ -106,6 +130,19 @@ class MonitorEvalSMP<T, Derived, BackendOMP>
         run(iter, dim, particle, r);
     }
 
+    /// \brief Compute the weighted sums of the values of all particles,
+    /// without storing the values of all particles
+    void sum(
+        std::size_t iter, std::size_t dim, Particle<T> &particle, double *r)
+    {
+        this->eval_first(iter, particle);
+        internal::backend_monitor_sum<BackendOMP>(dim, particle, r,
+            [this, iter, dim](const ParticleRange<T> &range, double *s) {
+                this->eval_range(iter, dim, range, s);
+            });
+        this->eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(OMP, MonitorEval)
 
@@ -37,6 +37,23 @@
 namespace mckl
 {
 
+namespace internal
+{
+
+template <>
+class BackendFor<BackendSEQ>
+{
+    public:
+    template <typename WorkType>
+    static void run(std::size_t N, std::size_t, WorkType &&work)
+    {
+        if (N != 0)
+            work(static_cast<std::size_t>(0), N);
+    }
+}; // class BackendFor
+
+} // namespace mckl::internal
+
 /// \brief Sampler<T>::eval_type subtype
 /// \ingroup SEQ
 template <typename T, typename Derived>
@@ -79,6 +96,19 @@ class MonitorEvalSMP<T, Derived, BackendSEQ>
         run(iter, dim, particle, r);
     }
 
+    /// \brief Compute the weighted sums of the values of all particles,
+    /// without storing the values of all particles
+    void sum(
+        std::size_t iter, std::size_t dim, Particle<T> &particle, double *r)
+    {
+        this->eval_first(iter, particle);
+        internal::backend_monitor_sum<BackendSEQ>(dim, particle, r,
+            [this, iter, dim](const ParticleRange<T> &range, double *s) {
+                this->eval_range(iter, dim, range, s);
+            });
+        this->eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(SEQ, MonitorEval)
 
@@ -34,37 +34,254 @@
 
 #include <mckl/smp/backend_base.hpp>
 
+/// \brief Minimum number of chunks per thread used by BackendSTD
+/// \ingroup Config
+#ifndef MCKL_SMP_STD_CHUNK_PER_THREAD
+#define MCKL_SMP_STD_CHUNK_PER_THREAD 8
+#endif
+
 namespace mckl
 {
 
 namespace internal
 {
 
+/// \brief Split `[0, N)` into chunks for BackendSTD
+///
+/// \details
+/// The range is split into at least `MCKL_SMP_STD_CHUNK_PER_THREAD` chunks
+/// per thread such that idle threads can steal work from busy ones, unless
+/// that would make a chunk smaller than `grainsize`.
 template <typename IntType>
-inline void backend_std_range(
-    IntType N, mckl::Vector<IntType> &first, mckl::Vector<IntType> &last)
+inline void backend_std_range(IntType N, IntType grainsize, std::size_t np,
+    mckl::Vector<IntType> &first, mckl::Vector<IntType> &last)
 {
     first.clear();
     last.clear();
-    const IntType np = std::max(const_one<IntType>(),
-        static_cast<IntType>(std::thread::hardware_concurrency()));
-    if (np == 1) {
-        first.push_back(0);
-        last.push_back(N);
+    if (N == 0)
         return;
-    }
 
-    const IntType m = N / np;
-    const IntType r = N % np;
-    IntType b = 0;
-    for (IntType id = 0; id != np; ++id) {
-        const IntType n = m + (id < r ? 1 : 0);
+    const IntType nc = static_cast<IntType>(
+        std::max(np, static_cast<std::size_t>(1)) *
+        MCKL_SMP_STD_CHUNK_PER_THREAD);
+    IntType g = std::max(grainsize, const_one<IntType>());
+    g = std::max(g, N / nc + (N % nc == 0 ? 0 : 1));
+    for (IntType b = 0; b < N; b += g) {
         first.push_back(b);
-        last.push_back(b + n);
-        b += n;
+        last.push_back(std::min(b + g, N));
     }
 }
 
+/// \brief Persistent work-stealing thread pool used by BackendSTD
+///
+/// \details
+/// Each thread, including the calling one, owns a queue of chunks. A thread
+/// consumes its own queue from the front, such that neighboring particles are
+/// processed by the same thread, and once empty steals from the back of the
+/// other queues. Nested calls, detected by a thread-local flag set while a
+/// thread executes a chunk, and calls made while the pool is busy with
+/// another loop, are executed serially by the calling thread.
+class BackendSTDPool
+{
+    public:
+    using work_type = std::function<void(std::size_t, std::size_t)>;
+
+    BackendSTDPool(const BackendSTDPool &) = delete;
+    BackendSTDPool &operator=(const BackendSTDPool &) = delete;
+
+    static BackendSTDPool &instance()
+    {
+        static BackendSTDPool pool;
+
+        return pool;
+    }
+
+    /// \brief The number of threads, including the calling thread
+    std::size_t size() const { return queue_.size(); }
+
+    /// \brief Apply `work(first, last)` to each chunk of `[0, N)`
+    ///
+    /// \details
+    /// If any call of `work` throws, the first exception captured is
+    /// rethrown in the calling thread after all chunks are processed.
+    void parallel_for(
+        std::size_t N, std::size_t grainsize, const work_type &work)
+    {
+        if (N == 0)
+            return;
+
+        // The calling thread may already own `run_mutex_` if this is a
+        // nested call, and locking it again is undefined
+        if (inside()) {
+            work(0, N);
+            return;
+        }
+
+        std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+        if (size() == 1 || !run_lock.owns_lock()) {
+            work(0, N);
+            return;
+        }
+
+        backend_std_range(N, grainsize, size(), first_, last_);
+        const std::size_t nc = first_.size();
+        const std::size_t np = size();
+        work_ = &work;
+        eptr_ = nullptr;
+        remain_ = nc;
+        for (std::size_t i = 0; i != np; ++i) {
+            std::lock_guard<std::mutex> lock(queue_[i]->mutex);
+            const std::size_t b = nc * i / np;
+            const std::size_t e = nc * (i + 1) / np;
+            for (std::size_t j = b; j != e; ++j) {
+                queue_[i]->chunk.emplace_back(first_[j], last_[j]);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++epoch_;
+        }
+        cv_.notify_all();
+
+        execute(0);
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return remain_ == 0; });
+        }
+        work_ = nullptr;
+
+        if (eptr_ != nullptr)
+            std::rethrow_exception(eptr_);
+    }
+
+    private:
+    using chunk_type = std::pair<std::size_t, std::size_t>;
+
+    struct queue_type {
+        std::mutex mutex;
+        std::deque<chunk_type> chunk;
+    }; // struct queue_type
+
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_;
+    std::size_t epoch_;
+    bool stop_;
+    std::atomic<std::size_t> remain_;
+    const work_type *work_;
+    std::exception_ptr eptr_;
+    Vector<std::unique_ptr<queue_type>> queue_;
+    Vector<std::thread> thread_;
+    Vector<std::size_t> first_;
+    Vector<std::size_t> last_;
+
+    BackendSTDPool() : epoch_(0), stop_(false), remain_(0), work_(nullptr)
+    {
+        const std::size_t np = std::max(static_cast<std::size_t>(1),
+            static_cast<std::size_t>(std::thread::hardware_concurrency()));
+        for (std::size_t i = 0; i != np; ++i)
+            queue_.emplace_back(new queue_type);
+        for (std::size_t i = 1; i < np; ++i)
+            thread_.emplace_back([this, i]() { worker(i); });
+    }
+
+    ~BackendSTDPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &t : thread_)
+            t.join();
+    }
+
+    void worker(std::size_t id)
+    {
+        std::size_t epoch = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this, epoch]() {
+                    return stop_ || epoch_ != epoch;
+                });
+                if (stop_)
+                    return;
+                epoch = epoch_;
+            }
+            execute(id);
+        }
+    }
+
+    void execute(std::size_t id)
+    {
+        chunk_type c;
+        while (pop(id, c) || steal(id, c)) {
+            try {
+                inside() = true;
+                (*work_)(c.first, c.second);
+                inside() = false;
+            } catch (...) {
+                inside() = false;
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (eptr_ == nullptr)
+                    eptr_ = std::current_exception();
+            }
+            if (remain_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    // If the calling thread is executing a chunk
+    static bool &inside()
+    {
+        static thread_local bool flag = false;
+
+        return flag;
+    }
+
+    bool pop(std::size_t id, chunk_type &c)
+    {
+        std::lock_guard<std::mutex> lock(queue_[id]->mutex);
+        if (queue_[id]->chunk.empty())
+            return false;
+        c = queue_[id]->chunk.front();
+        queue_[id]->chunk.pop_front();
+
+        return true;
+    }
+
+    bool steal(std::size_t id, chunk_type &c)
+    {
+        const std::size_t np = size();
+        for (std::size_t k = 1; k != np; ++k) {
+            queue_type &q = *queue_[(id + k) % np];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.chunk.empty()) {
+                c = q.chunk.back();
+                q.chunk.pop_back();
+                return true;
+            }
+        }
+
+        return false;
+    }
+}; // class BackendSTDPool
+
+template <>
+class BackendFor<BackendSTD>
+{
+    public:
+    template <typename WorkType>
+    static void run(std::size_t N, std::size_t grainsize, WorkType &&work)
+    {
+        BackendSTDPool::instance().parallel_for(N, grainsize, work);
+    }
+}; // class BackendFor
+
 } // namespace internal
 
 /// \brief Sampler<T>::eval_type subtype using the standard library
@@ -88,25 +305,19 @@ class SamplerEvalSMP<T, Derived, BackendSTD>
     }
 
     template <typename... Args>
-    void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
+    void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize,
+        Args &&...)
     {
         using size_type = typename Particle<T>::size_type;
 
         this->eval_first(iter, particle);
-        mckl::Vector<size_type> first;
-        mckl::Vector<size_type> last;
-        internal::backend_std_range(particle.size(), first, last);
-        mckl::Vector<std::future<void>> task_group;
-        for (std::size_t i = 0; i != first.size(); ++i) {
-            const size_type b = first[i];
-            const size_type e = last[i];
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, &particle, b, e]() {
-                    this->eval_range(iter, particle.range(b, e));
-                }));
-        }
-        for (auto &task : task_group)
-            task.wait();
+        internal::BackendSTDPool::instance().parallel_for(
+            static_cast<std::size_t>(particle.size()), grainsize,
+            [this, iter, &particle](std::size_t b, std::size_t e) {
+                this->eval_range(iter,
+                    particle.range(static_cast<size_type>(b),
+                                     static_cast<size_type>(e)));
+            });
         this->eval_last(iter, particle);
     }
 }; // class SamplerEvalSMP
@@ -124,6 +335,19 @@ class MonitorEvalSMP<T, Derived, BackendSTD>
         run(iter, dim, particle, r);
     }
 
+    /// \brief Compute the weighted sums of the values of all particles,
+    /// without storing the values of all particles
+    void sum(
+        std::size_t iter, std::size_t dim, Particle<T> &particle, double *r)
+    {
+        this->eval_first(iter, particle);
+        internal::backend_monitor_sum<BackendSTD>(dim, particle, r,
+            [this, iter, dim](const ParticleRange<T> &range, double *s) {
+                this->eval_range(iter, dim, range, s);
+            });
+        this->eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(STD, MonitorEval)
 
@@ -135,26 +359,19 @@ class MonitorEvalSMP<T, Derived, BackendSTD>
 
     template <typename... Args>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
-        double *r, std::size_t, Args &&...)
+        double *r, std::size_t grainsize, Args &&...)
     {
         using size_type = typename Particle<T>::size_type;
 
         this->eval_first(iter, particle);
-        mckl::Vector<size_type> first;
-        mckl::Vector<size_type> last;
-        internal::backend_std_range(particle.size(), first, last);
-        mckl::Vector<std::future<void>> task_group;
-        for (std::size_t i = 0; i != first.size(); ++i) {
-            const size_type b = first[i];
-            const size_type e = last[i];
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, dim, &particle, r, b, e]() {
-                    this->eval_range(iter, dim, particle.range(b, e),
-                        r + static_cast<std::size_t>(b) * dim);
-                }));
-        }
-        for (auto &task : task_group)
-            task.wait();
+        internal::BackendSTDPool::instance().parallel_for(
+            static_cast<std::size_t>(particle.size()), grainsize,
+            [this, iter, dim, &particle, r](std::size_t b, std::size_t e) {
+                this->eval_range(iter, dim,
+                    particle.range(static_cast<size_type>(b),
+                                     static_cast<size_type>(e)),
+                    r + b * dim);
+            });
         this->eval_last(iter, particle);
     }
 }; // class MonitorEvalSMP
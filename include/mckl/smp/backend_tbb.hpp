@@ -50,6 +50,20 @@ inline ::tbb::blocked_range<IntType> backend_tbb_range(
                             ::tbb::blocked_range<IntType>(0, N, grainsize);
 }
 
+template <>
+class BackendFor<BackendTBB>
+{
+    public:
+    template <typename WorkType>
+    static void run(std::size_t N, std::size_t grainsize, WorkType &&work)
+    {
+        ::tbb::parallel_for(backend_tbb_range(N, grainsize),
+            [&work](const ::tbb::blocked_range<std::size_t> &range) {
+                work(range.begin(), range.end());
+            });
+    }
+}; // class BackendFor
+
 } // namespace internal
 
 /// \brief Sampler<T>::eval_type subtype using Intel Threading Building Blocks
@@ -145,6 +159,19 @@ class MonitorEvalSMP<T, Derived, BackendTBB>
         run(iter, dim, particle, r);
     }
 
+    /// \brief Compute the weighted sums of the values of all particles,
+    /// without storing the values of all particles
+    void sum(
+        std::size_t iter, std::size_t dim, Particle<T> &particle, double *r)
+    {
+        this->eval_first(iter, particle);
+        internal::backend_monitor_sum<BackendTBB>(dim, particle, r,
+            [this, iter, dim](const ParticleRange<T> &range, double *s) {
+                this->eval_range(iter, dim, range, s);
+            });
+        this->eval_last(iter, particle);
+    }
+
     protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(TBB, MonitorEval)
 
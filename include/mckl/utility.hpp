@@ -34,11 +34,14 @@
 
 #include <mckl/internal/config.h>
 #include <mckl/utility/aligned_memory.hpp>
+#include <mckl/utility/checkpoint.hpp>
 #include <mckl/utility/covariance.hpp>
+#include <mckl/utility/cpu_features.hpp>
 #include <mckl/utility/stop_watch.hpp>
 
 #if MCKL_HAS_HDF5
 #include <mckl/utility/hdf5.hpp>
+#include <mckl/utility/hdf5_stream.hpp>
 #endif
 
 #endif // MCKL_UTILITY_HPP
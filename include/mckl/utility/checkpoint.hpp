@@ -0,0 +1,369 @@
+//============================================================================
+// MCKL/include/mckl/utility/checkpoint.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_UTILITY_CHECKPOINT_HPP
+#define MCKL_UTILITY_CHECKPOINT_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/random/seed.hpp>
+
+namespace mckl
+{
+
+namespace internal
+{
+
+/// \brief The file header of a checkpoint
+///
+/// \details
+/// A checkpoint file starts with this header, followed by the sections, each
+/// aligned to `checkpoint_alignment()` bytes, then the section table and
+/// finally the names of the sections. All offsets are from the beginning of
+/// the file. Thus, once the file is mapped into memory, the data of each
+/// section can be accessed in place.
+class CheckpointHeader
+{
+    public:
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian;
+    std::uint64_t table_offset;
+    std::uint64_t table_size;
+    std::uint64_t name_offset;
+    std::uint64_t name_size;
+    std::uint64_t file_size;
+    std::uint64_t reserved;
+}; // class CheckpointHeader
+
+/// \brief An entry of the section table of a checkpoint
+///
+/// \details
+/// The section named by `name_size` characters starting at `name_offset`
+/// within the names consists of `count` values of `value_size` bytes each,
+/// starting at `offset`.
+class CheckpointEntry
+{
+    public:
+    std::uint64_t offset;
+    std::uint64_t count;
+    std::uint64_t value_size;
+    std::uint32_t name_offset;
+    std::uint32_t name_size;
+}; // class CheckpointEntry
+
+static_assert(sizeof(CheckpointHeader) == 64,
+    "**CheckpointHeader** has unexpected size");
+
+static_assert(sizeof(CheckpointEntry) == 32,
+    "**CheckpointEntry** has unexpected size");
+
+inline const char *checkpoint_magic() { return "MCKLCKPT"; }
+
+inline constexpr std::uint32_t checkpoint_version() { return 1; }
+
+inline constexpr std::uint32_t checkpoint_endian() { return 0x01020304; }
+
+inline constexpr std::uint64_t checkpoint_alignment() { return 64; }
+
+} // namespace mckl::internal
+
+/// \brief Write a binary checkpoint file
+/// \ingroup Checkpoint
+///
+/// \details
+/// Each section is an array of trivially copyable values identified by a
+/// unique name. The values are written as they are in memory, and thus
+/// restored bit exactly by CheckpointReader on a platform with the same
+/// endianness and type sizes. The section table is written when `close()` is
+/// called or the object is destroyed.
+class CheckpointWriter
+{
+    public:
+    explicit CheckpointWriter(const std::string &filename)
+        : os_(filename, std::ios::out | std::ios::binary | std::ios::trunc)
+        , offset_(sizeof(internal::CheckpointHeader))
+    {
+        internal::CheckpointHeader header;
+        std::memset(&header, 0, sizeof(header));
+        os_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    ~CheckpointWriter() { close(); }
+
+    /// \brief If all sections have been written successfully
+    bool good() const { return static_cast<bool>(os_); }
+
+    /// \brief Write a section of `n` values
+    template <typename T>
+    void write(const std::string &name, std::size_t n, const T *data)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "**CheckpointWriter::write** used with T not trivially "
+            "copyable");
+
+        if (!os_.is_open() || !os_)
+            return;
+
+        const std::uint64_t pad = padding(offset_);
+        if (pad != 0) {
+            const char zero[internal::checkpoint_alignment()] = {0};
+            os_.write(zero, static_cast<std::streamsize>(pad));
+            offset_ += pad;
+        }
+
+        internal::CheckpointEntry entry;
+        entry.offset = offset_;
+        entry.count = n;
+        entry.value_size = sizeof(T);
+        entry.name_offset = static_cast<std::uint32_t>(name_.size());
+        entry.name_size = static_cast<std::uint32_t>(name.size());
+        table_.push_back(entry);
+        name_.insert(name_.end(), name.begin(), name.end());
+
+        const std::uint64_t bytes = sizeof(T) * n;
+        if (bytes != 0) {
+            os_.write(reinterpret_cast<const char *>(data),
+                static_cast<std::streamsize>(bytes));
+        }
+        offset_ += bytes;
+    }
+
+    /// \brief Write a section of a single value
+    template <typename T>
+    void write(const std::string &name, const T &value)
+    {
+        write(name, 1, &value);
+    }
+
+    /// \brief Write the section table and close the file
+    void close()
+    {
+        if (!os_.is_open())
+            return;
+
+        if (os_) {
+            offset_ += padding(offset_);
+            os_.seekp(static_cast<std::streamoff>(offset_));
+
+            internal::CheckpointHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, internal::checkpoint_magic(), 8);
+            header.version = internal::checkpoint_version();
+            header.endian = internal::checkpoint_endian();
+            header.table_offset = offset_;
+            header.table_size = table_.size();
+            header.name_offset =
+                offset_ + sizeof(internal::CheckpointEntry) * table_.size();
+            header.name_size = name_.size();
+            header.file_size = header.name_offset + header.name_size;
+
+            os_.write(reinterpret_cast<const char *>(table_.data()),
+                static_cast<std::streamsize>(
+                    sizeof(internal::CheckpointEntry) * table_.size()));
+            os_.write(
+                name_.data(), static_cast<std::streamsize>(name_.size()));
+            os_.seekp(0);
+            os_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        }
+        os_.close();
+    }
+
+    private:
+    std::ofstream os_;
+    std::uint64_t offset_;
+    Vector<internal::CheckpointEntry> table_;
+    Vector<char> name_;
+
+    static std::uint64_t padding(std::uint64_t offset)
+    {
+        const std::uint64_t r = offset % internal::checkpoint_alignment();
+
+        return r == 0 ? 0 : internal::checkpoint_alignment() - r;
+    }
+}; // class CheckpointWriter
+
+/// \brief Read a binary checkpoint file written by CheckpointWriter
+/// \ingroup Checkpoint
+///
+/// \details
+/// The header and the section table are read when the object is
+/// constructed. Each section is read directly into the destination on
+/// request. The object is not good if the file is not a checkpoint of the
+/// same version and endianness, or if any read has failed.
+class CheckpointReader
+{
+    public:
+    explicit CheckpointReader(const std::string &filename)
+        : is_(filename, std::ios::in | std::ios::binary)
+    {
+        internal::CheckpointHeader header;
+        is_.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!is_ || std::memcmp(header.magic, internal::checkpoint_magic(),
+                        8) != 0 ||
+            header.version != internal::checkpoint_version() ||
+            header.endian != internal::checkpoint_endian()) {
+            is_.setstate(std::ios::failbit);
+            return;
+        }
+
+        Vector<internal::CheckpointEntry> table(
+            static_cast<std::size_t>(header.table_size));
+        Vector<char> name(static_cast<std::size_t>(header.name_size));
+        is_.seekg(static_cast<std::streamoff>(header.table_offset));
+        is_.read(reinterpret_cast<char *>(table.data()),
+            static_cast<std::streamsize>(
+                sizeof(internal::CheckpointEntry) * table.size()));
+        is_.read(name.data(), static_cast<std::streamsize>(name.size()));
+        if (!is_)
+            return;
+
+        for (const auto &entry : table) {
+            if (entry.name_offset + entry.name_size > name.size()) {
+                is_.setstate(std::ios::failbit);
+                return;
+            }
+            table_[std::string(name.data() + entry.name_offset,
+                entry.name_size)] = entry;
+        }
+    }
+
+    CheckpointReader(const CheckpointReader &) = delete;
+
+    CheckpointReader &operator=(const CheckpointReader &) = delete;
+
+    /// \brief If the file is valid and all reads have succeeded
+    bool good() const { return static_cast<bool>(is_); }
+
+    /// \brief If a section of the given name exists
+    bool contains(const std::string &name) const
+    {
+        return table_.count(name) != 0;
+    }
+
+    /// \brief The number of values of a section, zero if it does not exist
+    std::size_t size(const std::string &name) const
+    {
+        auto iter = table_.find(name);
+
+        return iter == table_.end() ? 0 :
+                                      static_cast<std::size_t>(
+                                          iter->second.count);
+    }
+
+    /// \brief Read a section of exactly `n` values
+    ///
+    /// \return `false` if the section does not exist, has a different number
+    /// of values or a different value size, or cannot be read. The object is
+    /// not good afterward.
+    template <typename T>
+    bool read(const std::string &name, std::size_t n, T *data)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "**CheckpointReader::read** used with T not trivially copyable");
+
+        if (!is_)
+            return false;
+
+        auto iter = table_.find(name);
+        if (iter == table_.end() || iter->second.count != n ||
+            iter->second.value_size != sizeof(T)) {
+            is_.setstate(std::ios::failbit);
+            return false;
+        }
+
+        if (n != 0) {
+            is_.seekg(static_cast<std::streamoff>(iter->second.offset));
+            is_.read(reinterpret_cast<char *>(data),
+                static_cast<std::streamsize>(sizeof(T) * n));
+        }
+
+        return static_cast<bool>(is_);
+    }
+
+    /// \brief Read a section of a single value
+    template <typename T>
+    bool read(const std::string &name, T &value)
+    {
+        return read(name, 1, &value);
+    }
+
+    private:
+    std::ifstream is_;
+    std::map<std::string, internal::CheckpointEntry> table_;
+}; // class CheckpointReader
+
+/// \brief Store the complete state of a Sampler in a checkpoint file
+/// \ingroup Checkpoint
+///
+/// \details
+/// The state consists of the particle states, the weights, the RNG engines,
+/// the iteration number, the size, ESS and resampling histories, the records
+/// of all Monitors and the state of `Seed`. The evaluation objects are not
+/// stored.
+template <typename T>
+inline bool checkpoint_store(
+    const Sampler<T> &sampler, const std::string &filename)
+{
+    CheckpointWriter writer(filename);
+    Seed::instance().checkpoint_store(writer, "Seed");
+    sampler.checkpoint_store(writer, "Sampler");
+    writer.close();
+
+    return writer.good();
+}
+
+/// \brief Restore the complete state of a Sampler from a checkpoint file
+/// \ingroup Checkpoint
+///
+/// \details
+/// The Sampler shall be set up with the same evaluation objects and
+/// Monitors as the one stored. Monitors not found in the file are cleared.
+/// Afterward, further iterations produce results identical to those of the
+/// stored Sampler continuing without interruption. If `false` is returned,
+/// the Sampler is left in a valid but unspecified state.
+template <typename T>
+inline bool checkpoint_load(const std::string &filename, Sampler<T> &sampler)
+{
+    CheckpointReader reader(filename);
+    if (!reader.good())
+        return false;
+
+    return Seed::instance().checkpoint_load(reader, "Seed") &&
+        sampler.checkpoint_load(reader, "Sampler");
+}
+
+} // namespace mckl
+
+#endif // MCKL_UTILITY_CHECKPOINT_HPP
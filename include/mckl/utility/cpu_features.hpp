@@ -0,0 +1,198 @@
+//============================================================================
+// MCKL/include/mckl/utility/cpu_features.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_UTILITY_CPU_FEATURES_HPP
+#define MCKL_UTILITY_CPU_FEATURES_HPP
+
+#include <mckl/internal/common.hpp>
+
+#if MCKL_HAS_X86
+#ifdef MCKL_MSVC
+#include <intrin.h>
+#endif
+#endif
+
+namespace mckl
+{
+
+/// \brief CPU features detected at runtime
+/// \ingroup CPUFeatures
+///
+/// \details
+/// The values are bit flags that can be combined. A feature that requires
+/// operating system support for saving the extended registers, such as AVX2
+/// and AVX-512, is only reported if the support is enabled.
+enum CPUFeature : unsigned {
+    CPUSSE2 = 1U << 0,    ///< SSE2
+    CPUAVX2 = 1U << 1,    ///< AVX2
+    CPUAVX512F = 1U << 2, ///< AVX-512 Foundation
+    CPUFMA = 1U << 3,     ///< FMA3
+    CPUAESNI = 1U << 4,   ///< AES-NI
+    CPUVAES = 1U << 5,    ///< VAES
+    CPURDRAND = 1U << 6   ///< RDRAND
+}; // enum CPUFeature
+
+namespace internal
+{
+
+#if MCKL_HAS_X86
+
+inline void cpuid(unsigned eax, unsigned ecx, unsigned *reg)
+{
+#if defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+    unsigned a = 0;
+    unsigned b = 0;
+    unsigned c = 0;
+    unsigned d = 0;
+#if MCKL_HAS_X86_64
+    asm volatile("cpuid\n\t"
+                 : "=a"(a), "=b"(b), "=c"(c), "=d"(d)
+                 : "a"(eax), "c"(ecx));
+#else  // MCKL_HAS_X86_64
+    // ebx may be reserved as the PIC register
+    asm volatile(
+        "xchg{l}\t{%%}ebx, %1\n\t"
+        "cpuid\n\t"
+        "xchg{l}\t{%%}ebx, %1\n\t"
+        : "=a"(a), "=&r"(b), "=c"(c), "=d"(d)
+        : "a"(eax), "c"(ecx));
+#endif // MCKL_HAS_X86_64
+    reg[0] = a;
+    reg[1] = b;
+    reg[2] = c;
+    reg[3] = d;
+#elif defined(MCKL_MSVC)
+    int r[4];
+    __cpuidex(r, static_cast<int>(eax), static_cast<int>(ecx));
+    reg[0] = static_cast<unsigned>(r[0]);
+    reg[1] = static_cast<unsigned>(r[1]);
+    reg[2] = static_cast<unsigned>(r[2]);
+    reg[3] = static_cast<unsigned>(r[3]);
+#else // defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+    reg[0] = reg[1] = reg[2] = reg[3] = 0;
+#endif // defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+}
+
+inline std::uint64_t xgetbv()
+{
+#if defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+    unsigned hi = 0;
+    unsigned lo = 0;
+    asm volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<std::uint64_t>(hi) << 32) + lo;
+#elif defined(MCKL_MSVC)
+    return static_cast<std::uint64_t>(_xgetbv(0));
+#else  // defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+    return 0;
+#endif // defined(MCKL_CLANG) || defined(MCKL_GCC) || defined(MCKL_INTEL)
+}
+
+inline unsigned cpu_features_detect()
+{
+    unsigned reg[4] = {0};
+    cpuid(0, 0, reg);
+    const unsigned max_leaf = reg[0];
+    if (max_leaf < 1)
+        return 0;
+
+    unsigned features = 0;
+
+    cpuid(1, 0, reg);
+    const unsigned ecx1 = reg[2];
+    const unsigned edx1 = reg[3];
+    if (edx1 & (1U << 26))
+        features |= CPUSSE2;
+    if (ecx1 & (1U << 25))
+        features |= CPUAESNI;
+    if (ecx1 & (1U << 30))
+        features |= CPURDRAND;
+
+    // The YMM and ZMM states must be enabled by the operating system
+    bool ymm = false;
+    bool zmm = false;
+    if ((ecx1 & (1U << 27)) && (ecx1 & (1U << 28))) {
+        const std::uint64_t xcr0 = xgetbv();
+        ymm = (xcr0 & 0x06) == 0x06;
+        zmm = ymm && (xcr0 & 0xE0) == 0xE0;
+    }
+    if (!ymm)
+        return features;
+
+    if (ecx1 & (1U << 12))
+        features |= CPUFMA;
+    if (max_leaf < 7)
+        return features;
+
+    cpuid(7, 0, reg);
+    const unsigned ebx7 = reg[1];
+    const unsigned ecx7 = reg[2];
+    if (ebx7 & (1U << 5))
+        features |= CPUAVX2;
+    if (zmm && (ebx7 & (1U << 16)))
+        features |= CPUAVX512F;
+    if ((features & CPUAESNI) && (ecx7 & (1U << 9)))
+        features |= CPUVAES;
+
+    return features;
+}
+
+#else // MCKL_HAS_X86
+
+inline unsigned cpu_features_detect() { return 0; }
+
+#endif // MCKL_HAS_X86
+
+} // namespace mckl::internal
+
+/// \brief Features of the CPU the program is running on
+/// \ingroup CPUFeatures
+///
+/// \return A bitwise combination of `CPUFeature` values. The detection is
+/// performed once, on the first call. On non-x86 platforms, the result is
+/// always zero.
+inline unsigned cpu_features()
+{
+    static const unsigned features = internal::cpu_features_detect();
+
+    return features;
+}
+
+/// \brief If the CPU the program is running on supports all the given
+/// features
+/// \ingroup CPUFeatures
+inline bool cpu_has(unsigned features)
+{
+    return (cpu_features() & features) == features;
+}
+
+} // namespace mckl
+
+#endif // MCKL_UTILITY_CPU_FEATURES_HPP
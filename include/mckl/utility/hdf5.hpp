@@ -76,6 +76,13 @@ class HDF5ID
 
     bool good() const { return id_ >= 0; }
 
+    void reset()
+    {
+        if (good())
+            Derived::close(id_);
+        id_ = -1;
+    }
+
     bool operator!() const { return !good(); }
 
     explicit operator bool() const { return good(); }
@@ -89,6 +96,7 @@ MCKL_DEFINE_HDF5TYPE(DataSpace, S)
 MCKL_DEFINE_HDF5TYPE(DataType, T)
 MCKL_DEFINE_HDF5TYPE(File, F)
 MCKL_DEFINE_HDF5TYPE(Group, G)
+MCKL_DEFINE_HDF5TYPE(PropList, P)
 
 template <typename T>
 class HDF5StoreDataPtr
@@ -0,0 +1,597 @@
+//============================================================================
+// MCKL/include/mckl/utility/hdf5_stream.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_UTILITY_HDF5_STREAM_HPP
+#define MCKL_UTILITY_HDF5_STREAM_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/utility/hdf5.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace mckl
+{
+
+namespace internal
+{
+
+// A row of a dataset, which is a scalar, a vector or a matrix
+struct HDF5StreamRow {
+    std::string dataname;
+    ::hid_t (*datatype)();
+    std::size_t rank;
+    ::hsize_t dim[2];
+    Vector<char> data;
+}; // struct HDF5StreamRow
+
+struct HDF5StreamShape {
+    std::size_t rank;
+    ::hsize_t dim[2];
+    std::size_t size;
+}; // struct HDF5StreamShape
+
+struct HDF5StreamDataSet {
+    ::hid_t id;
+    ::hsize_t size;
+}; // struct HDF5StreamDataSet
+
+} // namespace mckl::internal
+
+/// \brief Append data to extendible HDF5 datasets while a sampler runs
+/// \ingroup HDF5
+///
+/// \details
+/// Each dataset is created the first time a row is appended to it. A row can
+/// be a scalar, a vector or a matrix, and the dataset has one more dimension,
+/// which is extended by one for each row. Datasets are chunked, and
+/// optionally compressed with the shuffle and deflate filters. Groups in the
+/// data name are created as needed.
+///
+/// By default, appended rows are copied into a queue and written by a
+/// background thread, such that the I/O overlaps the computation. Rows of
+/// the same dataset that are pending at the same time are written with a
+/// single call to `H5Dwrite`. The data is complete once `flush` or `close`
+/// returns or the object is destroyed. Unless the HDF5 library is
+/// thread-safe, no other HDF5 functions shall be called while there are
+/// pending rows. The object itself shall be used by only one thread.
+///
+/// If writing the rows of a dataset fails, the first error is recorded and
+/// returned by `error`, and `flush` and `close` return `false`. No more rows
+/// are written to that dataset, and the rows not written are not counted by
+/// `size`.
+///
+/// \note
+/// HDF5 store data in row major layout. See `hdf5store` for how the layout
+/// of a matrix row affects its shape in the file.
+class HDF5Stream
+{
+    public:
+    /// \brief Open a file for streaming
+    ///
+    /// \param filename The name of the HDF5 file
+    /// \param append If true, open an existing file, and rows appended to an
+    /// existing dataset are added after its current rows, which shall have
+    /// the same shape as the existing ones. Otherwise create a new file,
+    /// truncating any existing one
+    /// \param compression The deflate compression level, zero for no
+    /// compression
+    /// \param chunk The number of rows in each chunk. If it is zero, it is
+    /// chosen such that each chunk is about 64KB
+    /// \param async If true, rows are written by a background thread.
+    /// Otherwise they are written by `append` before it returns
+    explicit HDF5Stream(const std::string &filename, bool append = false,
+        int compression = 0, std::size_t chunk = 0, bool async = true)
+        : file_(internal::hdf5_datafile(filename, append, false))
+        , append_(append)
+        , compression_(compression)
+        , chunk_(chunk)
+        , async_(async && file_.good())
+        , pending_(0)
+        , stop_(false)
+    {
+        if (!file_)
+            error_ = "**HDF5Stream** failed to open the file " + filename;
+        if (async_)
+            thread_ = std::thread([this]() { run(); });
+    }
+
+    HDF5Stream(const HDF5Stream &) = delete;
+    HDF5Stream &operator=(const HDF5Stream &) = delete;
+
+    /// \brief Write all pending rows and close the file
+    ~HDF5Stream() { close(); }
+
+    /// \brief If the file is opened successfully and not closed yet
+    bool good() const { return file_.good(); }
+
+    /// \brief The number of rows appended to a dataset by this object,
+    /// excluding those failed to be written
+    std::size_t size(const std::string &dataname) const
+    {
+        auto iter = shape_.find(dataname);
+        if (iter == shape_.end())
+            return 0;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto failed = failed_.find(dataname);
+
+        return iter->second.size -
+            (failed == failed_.end() ? 0 : failed->second);
+    }
+
+    /// \brief The first error while opening the file or writing the rows,
+    /// empty if there is none
+    std::string error() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return error_;
+    }
+
+    /// \brief Wait until all pending rows are written and flush the file
+    ///
+    /// \return `false` if any row appended so far is failed to be written
+    bool flush()
+    {
+        if (async_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return pending_ == 0; });
+        }
+        if (file_ && ::H5Fflush(file_.id(), H5F_SCOPE_LOCAL) < 0)
+            fail("**HDF5Stream::flush** failed to flush the file");
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return error_.empty();
+    }
+
+    /// \brief Write all pending rows, stop the background thread and close
+    /// the file
+    ///
+    /// \return `false` if any row appended is failed to be written
+    bool close()
+    {
+        if (async_) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_one();
+            thread_.join();
+            async_ = false;
+        }
+        const bool passed = flush();
+        for (auto &d : dataset_)
+            if (d.second.id >= 0)
+                ::H5Dclose(d.second.id);
+        dataset_.clear();
+        file_.reset();
+
+        return passed;
+    }
+
+    /// \brief Append a scalar
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type append(
+        const std::string &dataname, T value)
+    {
+        const ::hsize_t dim[2] = {0, 0};
+        push<T>(dataname, 0, dim, 1, &value);
+    }
+
+    /// \brief Append a vector of length `n`
+    template <typename InputIter>
+    void append(const std::string &dataname, std::size_t n, InputIter first)
+    {
+        using T = typename std::iterator_traits<InputIter>::value_type;
+
+        const ::hsize_t dim[2] = {n, 0};
+        push<T>(dataname, 1, dim, n, first);
+    }
+
+    /// \brief Append a `nrow` by `ncol` matrix
+    template <typename InputIter>
+    void append(const std::string &dataname, MatrixLayout layout,
+        std::size_t nrow, std::size_t ncol, InputIter first)
+    {
+        using T = typename std::iterator_traits<InputIter>::value_type;
+
+        ::hsize_t dim[2];
+        internal::hdf5_dim(layout, nrow, ncol, dim);
+        push<T>(dataname, 2, dim, nrow * ncol, first);
+    }
+
+    /// \brief Append a snapshot of a StateMatrix
+    template <MatrixLayout Layout, std::size_t Dim, typename T>
+    void append(
+        const std::string &dataname, const StateMatrix<Layout, Dim, T> &state)
+    {
+        append(dataname, Layout, state.size(), state.dim(), state.data());
+    }
+
+    /// \brief Append the records of a Monitor not appended yet
+    ///
+    /// \details
+    /// The iteration numbers are appended to `dataname + "/Index"` and the
+    /// records to `dataname + "/Record"`.
+    template <typename T>
+    void append(const std::string &dataname, const Monitor<T> &monitor)
+    {
+        const std::string index_name(dataname + "/Index");
+        const std::string record_name(dataname + "/Record");
+        const std::size_t dim = monitor.dim();
+        Vector<double> record(dim);
+        for (std::size_t i = size(index_name); i < monitor.iter_size(); ++i) {
+            append(index_name, monitor.index(i));
+            for (std::size_t d = 0; d != dim; ++d)
+                record[d] = monitor.record(d, i);
+            append(record_name, dim, record.data());
+        }
+    }
+
+    /// \brief Append the histories of a Sampler not appended yet, and its
+    /// current weights
+    ///
+    /// \details
+    /// The sample sizes, resampling indicators and ESS are appended to
+    /// `dataname + "/Size"`, `"/Resampled"` and `"/ESS"`, respectively. The
+    /// weights are appended to `dataname + "/Weight"`. Monitors and the
+    /// state can be appended separately.
+    template <typename T>
+    void append(const std::string &dataname, const Sampler<T> &sampler)
+    {
+        const std::string size_name(dataname + "/Size");
+        const std::string resampled_name(dataname + "/Resampled");
+        const std::string ess_name(dataname + "/ESS");
+        for (std::size_t i = size(ess_name); i < sampler.iter_size(); ++i) {
+            const std::size_t n = sampler.size_history(i);
+            const int resampled = sampler.resampled_history(i) ? 1 : 0;
+            append(size_name, n);
+            append(resampled_name, resampled);
+            append(ess_name, sampler.ess_history(i));
+        }
+
+        const auto &weight = sampler.particle().weight();
+        append(dataname + "/Weight", static_cast<std::size_t>(weight.size()),
+            weight.data());
+    }
+
+    private:
+    static constexpr std::size_t chunk_bytes_ = 1 << 16;
+
+    internal::HDF5File file_;
+    bool append_;
+    int compression_;
+    std::size_t chunk_;
+    bool async_;
+    std::map<std::string, internal::HDF5StreamShape> shape_;
+    std::map<std::string, internal::HDF5StreamDataSet> dataset_;
+    Vector<internal::HDF5StreamRow> rows_;
+    Vector<char> buffer_;
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::mutex file_mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_;
+    Vector<internal::HDF5StreamRow> queue_;
+    std::size_t pending_;
+    bool stop_;
+    std::map<std::string, std::size_t> failed_;
+    std::string error_;
+
+    template <typename T, typename InputIter>
+    void push(const std::string &dataname, std::size_t rank,
+        const ::hsize_t *dim, std::size_t n, InputIter first)
+    {
+        if (!file_)
+            return;
+
+        runtime_assert(n != 0, "**HDF5Stream::append** empty data");
+
+        auto iter = shape_.find(dataname);
+        if (iter == shape_.end()) {
+            runtime_assert(!append_ || check(dataname, rank, dim),
+                "**HDF5Stream::append** the shape of the data is different "
+                "from the existing dataset");
+            internal::HDF5StreamShape shape = {rank, {dim[0], dim[1]}, 0};
+            iter = shape_.insert(std::make_pair(dataname, shape)).first;
+        }
+        runtime_assert(iter->second.rank == rank &&
+                iter->second.dim[0] == dim[0] && iter->second.dim[1] == dim[1],
+            "**HDF5Stream::append** the shape of the data is different from "
+            "the previous rows");
+        ++iter->second.size;
+
+        internal::HDF5StreamRow row;
+        row.dataname = dataname;
+        row.datatype = hdf5_datatype<T>;
+        row.rank = rank;
+        row.dim[0] = dim[0];
+        row.dim[1] = dim[1];
+        row.data.resize(sizeof(T) * n);
+        std::copy_n(first, n, reinterpret_cast<T *>(row.data.data()));
+
+        if (!async_) {
+            rows_.clear();
+            rows_.push_back(std::move(row));
+            write(rows_);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(row));
+            ++pending_;
+        }
+        cv_.notify_one();
+    }
+
+    void run()
+    {
+        Vector<internal::HDF5StreamRow> rows;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return stop_ || queue_.size() != 0; });
+            if (queue_.size() == 0)
+                return;
+            std::swap(rows, queue_);
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> file_lock(file_mutex_);
+                write(rows);
+            }
+            const std::size_t k = rows.size();
+            rows.clear();
+            lock.lock();
+            pending_ -= k;
+            if (pending_ == 0)
+                done_.notify_all();
+        }
+    }
+
+    // If the dataset exists, check that its rows have the given shape. It is
+    // called by the thread appending the first row, while the background
+    // thread may be writing other datasets
+    bool check(
+        const std::string &dataname, std::size_t rank, const ::hsize_t *dim)
+    {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+
+        ::hid_t id = -1;
+        H5E_BEGIN_TRY
+        {
+            id = ::H5Dopen2(file_.id(), dataname.c_str(), H5P_DEFAULT);
+        }
+        H5E_END_TRY;
+        if (id < 0)
+            return true;
+
+        const bool match = check(id, rank, dim);
+        ::H5Dclose(id);
+
+        return match;
+    }
+
+    static bool check(::hid_t id, std::size_t rank, const ::hsize_t *dim)
+    {
+        internal::HDF5DataSpace dataspace(::H5Dget_space(id));
+        if (!dataspace)
+            return false;
+
+        const int r = static_cast<int>(rank + 1);
+        if (::H5Sget_simple_extent_ndims(dataspace.id()) != r)
+            return false;
+
+        ::hsize_t d[3] = {0, 0, 0};
+        if (::H5Sget_simple_extent_dims(dataspace.id(), d, nullptr) < 0)
+            return false;
+
+        return d[1] == dim[0] && d[2] == dim[1];
+    }
+
+    // Record the first error. It is called by the background thread or by
+    // the thread appending rows if they are written synchronously
+    void fail(const std::string &msg)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_.empty())
+            error_ = msg;
+    }
+
+    // Rows of the same dataset are written together, in the order they are
+    // appended. If any fails, the dataset is closed and later rows of it are
+    // failed as well, such that it has no gaps
+    void write(const Vector<internal::HDF5StreamRow> &rows)
+    {
+        std::map<std::string, Vector<const internal::HDF5StreamRow *>> group;
+        for (const auto &row : rows)
+            group[row.dataname].push_back(&row);
+        for (const auto &g : group) {
+            if (write(g.second))
+                continue;
+
+            auto iter = dataset_.find(g.first);
+            if (iter != dataset_.end() && iter->second.id >= 0) {
+                ::H5Dclose(iter->second.id);
+                iter->second.id = -1;
+            }
+            fail("**HDF5Stream::append** failed to write the dataset " +
+                g.first);
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_[g.first] += g.second.size();
+        }
+    }
+
+    bool write(const Vector<const internal::HDF5StreamRow *> &rows)
+    {
+        const internal::HDF5StreamRow &row = *rows.front();
+        internal::HDF5StreamDataSet *dataset = open(row);
+        if (dataset == nullptr)
+            return false;
+
+        const std::size_t k = rows.size();
+        const std::size_t bytes = row.data.size();
+        const char *data = row.data.data();
+        if (k > 1) {
+            buffer_.resize(k * bytes);
+            for (std::size_t i = 0; i != k; ++i) {
+                std::copy(rows[i]->data.begin(), rows[i]->data.end(),
+                    buffer_.begin() + static_cast<std::ptrdiff_t>(i * bytes));
+            }
+            data = buffer_.data();
+        }
+
+        const int r = static_cast<int>(row.rank + 1);
+        const ::hsize_t start[3] = {dataset->size, 0, 0};
+        const ::hsize_t count[3] = {k, row.dim[0], row.dim[1]};
+        const ::hsize_t dim[3] = {dataset->size + k, row.dim[0], row.dim[1]};
+        if (::H5Dset_extent(dataset->id, dim) < 0)
+            return false;
+
+        internal::HDF5DataSpace filespace(::H5Dget_space(dataset->id));
+        if (!filespace)
+            return false;
+
+        if (::H5Sselect_hyperslab(filespace.id(), H5S_SELECT_SET, start,
+                nullptr, count, nullptr) < 0)
+            return false;
+
+        internal::HDF5DataSpace memspace(::H5Screate_simple(r, count, nullptr));
+        if (!memspace)
+            return false;
+
+        internal::HDF5DataType datatype(row.datatype());
+        if (!datatype)
+            return false;
+
+        if (::H5Dwrite(dataset->id, datatype.id(), memspace.id(),
+                filespace.id(), H5P_DEFAULT, data) < 0)
+            return false;
+
+        dataset->size += k;
+
+        return true;
+    }
+
+    internal::HDF5StreamDataSet *open(const internal::HDF5StreamRow &row)
+    {
+        auto iter = dataset_.find(row.dataname);
+        if (iter != dataset_.end())
+            return iter->second.id < 0 ? nullptr : &iter->second;
+
+        internal::HDF5StreamDataSet &dataset = dataset_[row.dataname];
+        dataset.id = -1;
+        dataset.size = 0;
+
+        if (append_) {
+            ::hid_t id = -1;
+            H5E_BEGIN_TRY
+            {
+                id = ::H5Dopen2(file_.id(), row.dataname.c_str(), H5P_DEFAULT);
+            }
+            H5E_END_TRY;
+            if (id >= 0) {
+                internal::HDF5DataSpace dataspace(::H5Dget_space(id));
+                if (dataspace && check(id, row.rank, row.dim)) {
+                    ::hsize_t dim[3] = {0, 0, 0};
+                    ::H5Sget_simple_extent_dims(dataspace.id(), dim, nullptr);
+                    dataset.id = id;
+                    dataset.size = dim[0];
+
+                    return &dataset;
+                }
+                ::H5Dclose(id);
+
+                return nullptr;
+            }
+        }
+
+        dataset.id = create(row);
+
+        return dataset.id < 0 ? nullptr : &dataset;
+    }
+
+    ::hid_t create(const internal::HDF5StreamRow &row) const
+    {
+        const int r = static_cast<int>(row.rank + 1);
+        const std::size_t bytes = row.data.size();
+        const ::hsize_t c = chunk_ != 0 ?
+            chunk_ :
+            std::max(static_cast<std::size_t>(1), chunk_bytes_ / bytes);
+        const ::hsize_t dim[3] = {0, row.dim[0], row.dim[1]};
+        const ::hsize_t maxdim[3] = {H5S_UNLIMITED, row.dim[0], row.dim[1]};
+        const ::hsize_t chunk[3] = {c, row.dim[0], row.dim[1]};
+
+        internal::HDF5DataType datatype(row.datatype());
+        if (!datatype)
+            return -1;
+
+        internal::HDF5DataSpace dataspace(::H5Screate_simple(r, dim, maxdim));
+        if (!dataspace)
+            return -1;
+
+        internal::HDF5PropList dcpl(::H5Pcreate(H5P_DATASET_CREATE));
+        if (!dcpl)
+            return -1;
+
+        if (::H5Pset_chunk(dcpl.id(), r, chunk) < 0)
+            return -1;
+
+        if (compression_ > 0) {
+            ::H5Pset_shuffle(dcpl.id());
+            ::H5Pset_deflate(dcpl.id(), static_cast<unsigned>(compression_));
+        }
+
+        internal::HDF5PropList lcpl(::H5Pcreate(H5P_LINK_CREATE));
+        if (!lcpl)
+            return -1;
+
+        ::H5Pset_create_intermediate_group(lcpl.id(), 1);
+
+        // A failure, such as a name taken by a group, is reported through
+        // error() instead of the HDF5 error stack
+        ::hid_t id = -1;
+        H5E_BEGIN_TRY
+        {
+            id = ::H5Dcreate2(file_.id(), row.dataname.c_str(), datatype.id(),
+                dataspace.id(), lcpl.id(), dcpl.id(), H5P_DEFAULT);
+        }
+        H5E_END_TRY;
+
+        return id;
+    }
+}; // class HDF5Stream
+
+} // namespace mckl
+
+#endif // MCKL_UTILITY_HDF5_STREAM_HPP
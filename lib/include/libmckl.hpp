@@ -35,6 +35,10 @@
 #include <mckl/internal/common.h>
 #include <mckl/mckl.hpp>
 
+#ifndef MCKL_LIB_DISPATCH
+#define MCKL_LIB_DISPATCH 0
+#endif
+
 namespace mckl
 {
 
@@ -120,6 +124,22 @@ inline constexpr MCKLRNGType rng_type();
 
 #include <mckl/random/internal/rng_define_macro.hpp>
 
+/// \brief The instruction set selected for the `mckl_rand` family of
+/// functions, one of `MCKLCPUAVX512F`, `MCKLCPUAVX2` and `MCKLCPUSSE2`, or
+/// zero if the library is not built with runtime dispatch
+inline int cpu_dispatch()
+{
+#if MCKL_LIB_DISPATCH
+    if (cpu_has(CPUAVX512F))
+        return MCKLCPUAVX512F;
+    if (cpu_has(CPUAVX2))
+        return MCKLCPUAVX2;
+    return MCKLCPUSSE2;
+#else
+    return 0;
+#endif
+}
+
 } // namespace mckl
 
 #endif // MCKL_LIBMCKL_HPP
@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_##name(mckl_rng rng, size_t n, unsigned *r)         \
+    static void mckl_rand_##name(mckl_rng rng, size_t n, unsigned *r)         \
     {                                                                         \
         ::mckl::UniformBitsDistribution<unsigned> dist;                       \
         ::mckl::rand(*reinterpret_cast<RNGType *>(rng.ptr), dist, n, r);      \
@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_64_##name(                                          \
+    static void mckl_rand_64_##name(                                          \
         mckl_rng rng, size_t n, unsigned long long *r)                        \
     {                                                                         \
         ::mckl::UniformBitsDistribution<unsigned long long> dist;             \
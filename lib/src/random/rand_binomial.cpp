@@ -43,7 +43,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_binomial_##name(                                    \
+    static void mckl_rand_binomial_##name(                                    \
         mckl_rng rng, size_t n, int *r, int t, double p)                      \
     {                                                                         \
         std::binomial_distribution<int> dist(t, p);                           \
@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_discrete_64_##name(mckl_rng rng, size_t n,          \
+    static void mckl_rand_discrete_64_##name(mckl_rng rng, size_t n,          \
         long long *r, size_t m, const double *weight, int normalized)         \
     {                                                                         \
         ::mckl::DiscreteDistribution<long long> dist;                         \
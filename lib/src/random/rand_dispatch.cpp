@@ -0,0 +1,108 @@
+//============================================================================
+// MCKL/lib/src/random/rand_dispatch.cpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#include <mckl/mckl.h>
+#include "libmckl.hpp"
+
+extern "C" {
+
+#ifdef MCKL_RAND_ISA_DEFINE_MACRO
+#undef MCKL_RAND_ISA_DEFINE_MACRO
+#endif
+
+#define MCKL_RAND_ISA_DEFINE_MACRO(name, params, args)                        \
+    void name##_sse2 params;                                                  \
+    void name##_avx2 params;                                                  \
+    void name##_avx512f params;
+
+#include "rand_isa_list.hpp"
+
+// Until the library is loaded, the SSE2 implementations are used, which are
+// supported by all x86-64 CPUs
+
+#ifdef MCKL_RAND_ISA_DEFINE_MACRO
+#undef MCKL_RAND_ISA_DEFINE_MACRO
+#endif
+
+#define MCKL_RAND_ISA_DEFINE_MACRO(name, params, args)                        \
+    using name##_type = void(*) params;                                       \
+    static name##_type name##_ptr = name##_sse2;                              \
+    void name params { name##_ptr args; }
+
+#include "rand_isa_list.hpp"
+
+} // extern "C"
+
+namespace mckl
+{
+
+namespace internal
+{
+
+inline bool rand_dispatch_init()
+{
+    switch (cpu_dispatch()) {
+        case MCKLCPUAVX512F:
+
+#ifdef MCKL_RAND_ISA_DEFINE_MACRO
+#undef MCKL_RAND_ISA_DEFINE_MACRO
+#endif
+
+#define MCKL_RAND_ISA_DEFINE_MACRO(name, params, args)                        \
+    name##_ptr = name##_avx512f;
+
+#include "rand_isa_list.hpp"
+
+            break;
+        case MCKLCPUAVX2:
+
+#ifdef MCKL_RAND_ISA_DEFINE_MACRO
+#undef MCKL_RAND_ISA_DEFINE_MACRO
+#endif
+
+#define MCKL_RAND_ISA_DEFINE_MACRO(name, params, args)                        \
+    name##_ptr = name##_avx2;
+
+#include "rand_isa_list.hpp"
+
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+static const bool rand_dispatch_initialized = rand_dispatch_init();
+
+} // namespace mckl::internal
+
+} // namespace mckl
@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_fisher_f_##name(                                    \
+    static void mckl_rand_fisher_f_##name(                                    \
         mckl_rng rng, size_t n, double *r, double df1, double df2)            \
     {                                                                         \
         ::mckl::FisherFDistribution<double> dist(df1, df2);                   \
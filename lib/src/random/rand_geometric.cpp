@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_geometric_##name(                                   \
+    static void mckl_rand_geometric_##name(                                   \
         mckl_rng rng, size_t n, int *r, double p)                             \
     {                                                                         \
         ::mckl::GeometricDistribution<int> dist(p);                           \
@@ -0,0 +1,87 @@
+//============================================================================
+// MCKL/lib/src/random/rand_isa.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+// Included before anything else by the translation units that compile the
+// distribution kernels for a given instruction set. The macro MCKL_LIB_ISA
+// is the suffix of the exported C functions. The namespace `mckl` is renamed
+// as well, such that the instantiated C++ templates are not merged with those
+// compiled for other instruction sets when the library is linked. Templates
+// in other namespaces, notably `std`, are not renamed. Thus the kernels shall
+// not instantiate any of them with out-of-line definitions, such as the
+// standard library distributions, which are compiled in rand_std.cpp instead.
+
+#ifndef MCKL_LIB_ISA
+#error MCKL_LIB_ISA shall be defined before including rand_isa.hpp
+#endif
+
+// The results shall be identical regardless of the instruction set
+#define MCKL_USE_SIMD_VMATH 0
+
+#define MCKL_LIB_ISA_NAME(name) MCKL_LIB_ISA_CAT(name, MCKL_LIB_ISA)
+#define MCKL_LIB_ISA_CAT(name, isa) MCKL_LIB_ISA_PASTE(name, isa)
+#define MCKL_LIB_ISA_PASTE(name, isa) name##_##isa
+
+#define mckl MCKL_LIB_ISA_NAME(mckl)
+
+#define mckl_rand MCKL_LIB_ISA_NAME(mckl_rand)
+#define mckl_rand_64 MCKL_LIB_ISA_NAME(mckl_rand_64)
+#define mckl_rand_arcsine MCKL_LIB_ISA_NAME(mckl_rand_arcsine)
+#define mckl_rand_beta MCKL_LIB_ISA_NAME(mckl_rand_beta)
+#define mckl_rand_cauchy MCKL_LIB_ISA_NAME(mckl_rand_cauchy)
+#define mckl_rand_chi_squared MCKL_LIB_ISA_NAME(mckl_rand_chi_squared)
+#define mckl_rand_exponential MCKL_LIB_ISA_NAME(mckl_rand_exponential)
+#define mckl_rand_extreme_value MCKL_LIB_ISA_NAME(mckl_rand_extreme_value)
+#define mckl_rand_fisher_f MCKL_LIB_ISA_NAME(mckl_rand_fisher_f)
+#define mckl_rand_gamma MCKL_LIB_ISA_NAME(mckl_rand_gamma)
+#define mckl_rand_laplace MCKL_LIB_ISA_NAME(mckl_rand_laplace)
+#define mckl_rand_levy MCKL_LIB_ISA_NAME(mckl_rand_levy)
+#define mckl_rand_logistic MCKL_LIB_ISA_NAME(mckl_rand_logistic)
+#define mckl_rand_lognormal MCKL_LIB_ISA_NAME(mckl_rand_lognormal)
+#define mckl_rand_normal MCKL_LIB_ISA_NAME(mckl_rand_normal)
+#define mckl_rand_normal_mv MCKL_LIB_ISA_NAME(mckl_rand_normal_mv)
+#define mckl_rand_pareto MCKL_LIB_ISA_NAME(mckl_rand_pareto)
+#define mckl_rand_rayleigh MCKL_LIB_ISA_NAME(mckl_rand_rayleigh)
+#define mckl_rand_stable MCKL_LIB_ISA_NAME(mckl_rand_stable)
+#define mckl_rand_student_t MCKL_LIB_ISA_NAME(mckl_rand_student_t)
+#define mckl_rand_u01 MCKL_LIB_ISA_NAME(mckl_rand_u01)
+#define mckl_rand_u01_cc MCKL_LIB_ISA_NAME(mckl_rand_u01_cc)
+#define mckl_rand_u01_co MCKL_LIB_ISA_NAME(mckl_rand_u01_co)
+#define mckl_rand_u01_oc MCKL_LIB_ISA_NAME(mckl_rand_u01_oc)
+#define mckl_rand_u01_oo MCKL_LIB_ISA_NAME(mckl_rand_u01_oo)
+#define mckl_rand_uniform_real MCKL_LIB_ISA_NAME(mckl_rand_uniform_real)
+#define mckl_rand_weibull MCKL_LIB_ISA_NAME(mckl_rand_weibull)
+#define mckl_rand_bernoulli MCKL_LIB_ISA_NAME(mckl_rand_bernoulli)
+#define mckl_rand_discrete MCKL_LIB_ISA_NAME(mckl_rand_discrete)
+#define mckl_rand_discrete_64 MCKL_LIB_ISA_NAME(mckl_rand_discrete_64)
+#define mckl_rand_geometric MCKL_LIB_ISA_NAME(mckl_rand_geometric)
+#define mckl_rand_geometric_64 MCKL_LIB_ISA_NAME(mckl_rand_geometric_64)
+#define mckl_rand_uniform_int MCKL_LIB_ISA_NAME(mckl_rand_uniform_int)
+#define mckl_rand_uniform_int_64 MCKL_LIB_ISA_NAME(mckl_rand_uniform_int_64)
@@ -0,0 +1,137 @@
+//============================================================================
+// MCKL/lib/src/random/rand_isa_list.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2016, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand,
+    (mckl_rng rng, size_t n, unsigned *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_64,
+    (mckl_rng rng, size_t n, unsigned long long *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_arcsine,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta),
+    (rng, n, r, alpha, beta))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_beta,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta),
+    (rng, n, r, alpha, beta))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_cauchy,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_chi_squared,
+    (mckl_rng rng, size_t n, double *r, double df),
+    (rng, n, r, df))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_exponential,
+    (mckl_rng rng, size_t n, double *r, double lambda),
+    (rng, n, r, lambda))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_extreme_value,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_fisher_f,
+    (mckl_rng rng, size_t n, double *r, double df1, double df2),
+    (rng, n, r, df1, df2))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_gamma,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta),
+    (rng, n, r, alpha, beta))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_laplace,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_levy,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_logistic,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_lognormal,
+    (mckl_rng rng, size_t n, double *r, double m, double s),
+    (rng, n, r, m, s))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_normal,
+    (mckl_rng rng, size_t n, double *r, double mean, double stddev),
+    (rng, n, r, mean, stddev))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_normal_mv,
+    (mckl_rng rng, size_t n, double *r, size_t dim, const double *mean, const
+        double *chol),
+    (rng, n, r, dim, mean, chol))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_pareto,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_rayleigh,
+    (mckl_rng rng, size_t n, double *r, double b),
+    (rng, n, r, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_stable,
+    (mckl_rng rng, size_t n, double *r, double alpha, double beta, double a,
+        double b),
+    (rng, n, r, alpha, beta, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_student_t,
+    (mckl_rng rng, size_t n, double *r, double df),
+    (rng, n, r, df))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_u01,
+    (mckl_rng rng, size_t n, double *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_u01_cc,
+    (mckl_rng rng, size_t n, double *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_u01_co,
+    (mckl_rng rng, size_t n, double *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_u01_oc,
+    (mckl_rng rng, size_t n, double *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_u01_oo,
+    (mckl_rng rng, size_t n, double *r),
+    (rng, n, r))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_uniform_real,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_weibull,
+    (mckl_rng rng, size_t n, double *r, double a, double b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_bernoulli,
+    (mckl_rng rng, size_t n, int *r, double p),
+    (rng, n, r, p))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_discrete,
+    (mckl_rng rng, size_t n, int *r, size_t m, const double *weight, int
+        normalized),
+    (rng, n, r, m, weight, normalized))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_discrete_64,
+    (mckl_rng rng, size_t n, long long *r, size_t m, const double *weight, int
+        normalized),
+    (rng, n, r, m, weight, normalized))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_geometric,
+    (mckl_rng rng, size_t n, int *r, double p),
+    (rng, n, r, p))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_geometric_64,
+    (mckl_rng rng, size_t n, long long *r, double p),
+    (rng, n, r, p))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_uniform_int,
+    (mckl_rng rng, size_t n, int *r, int a, int b),
+    (rng, n, r, a, b))
+MCKL_RAND_ISA_DEFINE_MACRO(mckl_rand_uniform_int_64,
+    (mckl_rng rng, size_t n, long long *r, long long a, long long b),
+    (rng, n, r, a, b))
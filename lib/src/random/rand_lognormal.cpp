@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_lognormal_##name(                                   \
+    static void mckl_rand_lognormal_##name(                                   \
         mckl_rng rng, size_t n, double *r, double m, double s)                \
     {                                                                         \
         ::mckl::LognormalDistribution<double> dist(m, s);                     \
@@ -43,7 +43,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_negative_binomial_64_##name(                        \
+    static void mckl_rand_negative_binomial_64_##name(                        \
         mckl_rng rng, size_t n, long long *r, long long k, double p)          \
     {                                                                         \
         std::negative_binomial_distribution<long long> dist(k, p);            \
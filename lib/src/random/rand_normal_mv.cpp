@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_normal_mv_##name(mckl_rng rng, size_t n, double *r, \
+    static void mckl_rand_normal_mv_##name(mckl_rng rng, size_t n, double *r, \
         size_t dim, const double *mean, const double *chol)                   \
     {                                                                         \
         ::mckl::NormalMVDistribution<double> dist(dim, mean, chol);           \
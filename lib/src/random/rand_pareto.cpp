@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_pareto_##name(                                      \
+    static void mckl_rand_pareto_##name(                                      \
         mckl_rng rng, size_t n, double *r, double a, double b)                \
     {                                                                         \
         ::mckl::ParetoDistribution<double> dist(a, b);                        \
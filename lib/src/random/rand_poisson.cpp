@@ -43,7 +43,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_poisson_##name(                                     \
+    static void mckl_rand_poisson_##name(                                     \
         mckl_rng rng, size_t n, int *r, double mean)                          \
     {                                                                         \
         std::poisson_distribution<int> dist(mean);                            \
@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_u01_oo_##name(mckl_rng rng, size_t n, double *r)    \
+    static void mckl_rand_u01_oo_##name(mckl_rng rng, size_t n, double *r)    \
     {                                                                         \
         ::mckl::U01OODistribution<double> dist;                               \
         ::mckl::rand(*reinterpret_cast<RNGType *>(rng.ptr), dist, n, r);      \
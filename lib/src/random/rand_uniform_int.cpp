@@ -44,7 +44,7 @@ extern "C" {
 #endif
 
 #define MCKL_RNG_DEFINE_MACRO(RNGType, Name, name)                            \
-    inline void mckl_rand_uniform_int_##name(                                 \
+    static void mckl_rand_uniform_int_##name(                                 \
         mckl_rng rng, size_t n, int *r, int a, int b)                         \
     {                                                                         \
         ::mckl::UniformIntDistribution<int> dist(a, b);                       \
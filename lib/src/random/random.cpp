@@ -44,48 +44,13 @@
 #include "rng_seed.cpp"
 #include "rng_type.cpp"
 
-#include "rand.cpp"
-#include "rand_64.cpp"
-
-#include "rand_arcsine.cpp"
-#include "rand_beta.cpp"
-#include "rand_cauchy.cpp"
-#include "rand_chi_squared.cpp"
-#include "rand_exponential.cpp"
-#include "rand_extreme_value.cpp"
-#include "rand_fisher_f.cpp"
-#include "rand_gamma.cpp"
-#include "rand_laplace.cpp"
-#include "rand_levy.cpp"
-#include "rand_logistic.cpp"
-#include "rand_lognormal.cpp"
-#include "rand_normal.cpp"
-#include "rand_normal_mv.cpp"
-#include "rand_pareto.cpp"
-#include "rand_rayleigh.cpp"
-#include "rand_stable.cpp"
-#include "rand_student_t.cpp"
-#include "rand_u01.cpp"
-#include "rand_u01_cc.cpp"
-#include "rand_u01_co.cpp"
-#include "rand_u01_oc.cpp"
-#include "rand_u01_oo.cpp"
-#include "rand_uniform_real.cpp"
-#include "rand_weibull.cpp"
+#if MCKL_LIB_DISPATCH
+#include "rand_dispatch.cpp"
+#else
+#include "rand_all.cpp"
+#endif
 
-#include "rand_bernoulli.cpp"
-#include "rand_binomial.cpp"
-#include "rand_binomial_64.cpp"
-#include "rand_discrete.cpp"
-#include "rand_discrete_64.cpp"
-#include "rand_geometric.cpp"
-#include "rand_geometric_64.cpp"
-#include "rand_negative_binomial.cpp"
-#include "rand_negative_binomial_64.cpp"
-#include "rand_poisson.cpp"
-#include "rand_poisson_64.cpp"
-#include "rand_uniform_int.cpp"
-#include "rand_uniform_int_64.cpp"
+#include "rand_std.cpp"
 
 #if MCKL_HAS_MKL
 #include "mkl_brng.cpp"
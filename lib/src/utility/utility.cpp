@@ -31,5 +31,6 @@
 
 #include "aligned_memory.cpp"
 #include "covariance.cpp"
+#include "cpu_features.cpp"
 #include "hdf5.cpp"
 #include "stop_watch.cpp"